@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file hal_cache.h
+ * @brief Portable HAL interface for L1 cache control and maintenance.
+ *
+ * @details
+ * Backed by the Cortex-M7 L1 I/D caches (@c NAVHAL_HAS_CACHE). Drivers that
+ * hand memory to a bus master (DMA) call the range helpers unconditionally:
+ * on targets without a data cache they compile to nothing, and on the M7
+ * they return immediately while the D-cache is off.
+ *
+ * Range operations work on whole 32-byte lines. A buffer that shares a line
+ * with unrelated data can have that data rolled back by an invalidate, so
+ * DMA buffers should be declared with ::NAVHAL_DMA_BUFFER and sized with
+ * ::HAL_CACHE_ALIGN_UP, or taken from ::hal_dma_alloc.
+ */
+
+#ifndef HAL_CACHE_H
+#define HAL_CACHE_H
+
+/**
+ * @defgroup HAL_CACHE Cache
+ * @ingroup HAL_DRIVERS
+ * @brief L1 cache enable and clean/invalidate-by-range.
+ * @{
+ */
+
+#include "common/hal_features.h"
+#include "common/hal_status.h"
+#include "common/navhal_compiler.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Data-cache line size in bytes (maintenance granularity). */
+#if NAVHAL_HAS_CACHE
+#define HAL_CACHE_LINE_SIZE 32U
+#else
+#define HAL_CACHE_LINE_SIZE 4U
+#endif
+
+/** @brief Round @p n up to a whole number of cache lines. */
+#define HAL_CACHE_ALIGN_UP(n)                                                  \
+  (((n) + HAL_CACHE_LINE_SIZE - 1U) & ~(HAL_CACHE_LINE_SIZE - 1U))
+
+/**
+ * @brief Attribute for statically allocated DMA buffers.
+ *
+ * Aligns the start to a cache line; pair it with ::HAL_CACHE_ALIGN_UP for the
+ * size so the buffer owns every line it touches:
+ * @code
+ * static uint8_t rx[HAL_CACHE_ALIGN_UP(512)] NAVHAL_DMA_BUFFER;
+ * @endcode
+ */
+#define NAVHAL_DMA_BUFFER NAVHAL_ALIGNED(HAL_CACHE_LINE_SIZE)
+
+#if NAVHAL_HAS_CACHE
+
+/** @brief Invalidate and enable the instruction cache. */
+void hal_cache_icache_enable(void);
+
+/** @brief Disable and invalidate the instruction cache. */
+void hal_cache_icache_disable(void);
+
+/** @brief Invalidate and enable the data cache. */
+void hal_cache_dcache_enable(void);
+
+/** @brief Clean, invalidate and disable the data cache. */
+void hal_cache_dcache_disable(void);
+
+/** @brief True if the data cache is currently enabled. */
+bool hal_cache_dcache_enabled(void);
+
+/**
+ * @brief Write dirty lines covering [@p addr, @p addr + @p len) to memory.
+ *
+ * Use before a bus master reads the range (memory-to-peripheral DMA).
+ */
+void hal_cache_clean_range(const void *addr, size_t len);
+
+/**
+ * @brief Discard cached lines covering [@p addr, @p addr + @p len).
+ *
+ * Use after a bus master has written the range (peripheral-to-memory DMA).
+ */
+void hal_cache_invalidate_range(const void *addr, size_t len);
+
+/**
+ * @brief Clean then discard lines covering [@p addr, @p addr + @p len).
+ *
+ * Use before a bus master writes the range, so no dirty line can be evicted
+ * on top of the incoming data.
+ */
+void hal_cache_clean_invalidate_range(const void *addr, size_t len);
+
+/**
+ * @brief Program an MPU region as normal, non-cacheable, non-executable RAM.
+ *
+ * Enables the MPU with the default memory map as background, so only the
+ * region itself changes attributes.
+ *
+ * @param region MPU region number.
+ * @param base   Region base; must be aligned to @p size.
+ * @param size   Region size; a power of two, at least 32 bytes.
+ * @return ::HAL_OK, or ::HAL_ERR_INVALID_ARG for a bad region, size or base.
+ */
+hal_status_t hal_cache_mpu_noncacheable(uint8_t region, uintptr_t base,
+                                        size_t size);
+
+#else /* !NAVHAL_HAS_CACHE — no data cache, nothing to maintain */
+
+NAVHAL_INLINE void hal_cache_clean_range(const void *addr, size_t len) {
+  (void)addr;
+  (void)len;
+}
+NAVHAL_INLINE void hal_cache_invalidate_range(const void *addr, size_t len) {
+  (void)addr;
+  (void)len;
+}
+NAVHAL_INLINE void hal_cache_clean_invalidate_range(const void *addr,
+                                                    size_t len) {
+  (void)addr;
+  (void)len;
+}
+NAVHAL_INLINE bool hal_cache_dcache_enabled(void) { return false; }
+
+#endif /* NAVHAL_HAS_CACHE */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/** @} */ /* end of group HAL_CACHE */
+#endif /* HAL_CACHE_H */
@@ -33,8 +33,24 @@
  * @{
  */
 
+#include "navhal_target.h" /* NAVHAL_CONFIG_DISK_LBA64 */
 #include <stdint.h>
 
+/**
+ * @brief 64-bit sector addresses (@c CONFIG_DISK_LBA64); a
+ *        -DHAL_DISK_LBA64=n build flag overrides it.
+ *
+ * Needed by exFAT volumes past 2 TiB. SD cards take 32-bit block addresses
+ * on the bus, so the SD backends answer ::HAL_DISK_RES_PARERR for sectors
+ * beyond that.
+ */
+#ifndef HAL_DISK_LBA64
+#if defined(NAVHAL_CONFIG_DISK_LBA64) && NAVHAL_CONFIG_DISK_LBA64
+#define HAL_DISK_LBA64 1
+#else
+#define HAL_DISK_LBA64 0
+#endif
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -48,6 +64,13 @@ typedef uint8_t hal_disk_status_t;
 #define HAL_DISK_STATUS_NODISK 0x02
 #define HAL_DISK_STATUS_PROTECT 0x04
 
+/** @brief Sector address (LBA). */
+#if HAL_DISK_LBA64
+typedef uint64_t hal_disk_lba_t;
+#else
+typedef uint32_t hal_disk_lba_t;
+#endif
+
 /**
  * @brief Disk Result codes
  */
@@ -69,22 +92,41 @@ hal_disk_status_t hal_disk_status(uint8_t pdrv);
 hal_disk_result_t
 hal_disk_read(uint8_t pdrv,    /**< Physical drive number */
               uint8_t *buff,   /**< Data buffer to store read data */
-              uint32_t sector, /**< Sector address (LBA) */
-              uint32_t count   /**< Number of sectors to read */
+              hal_disk_lba_t sector, /**< Sector address (LBA) */
+              uint32_t count         /**< Number of sectors to read */
 );
 
 hal_disk_result_t
 hal_disk_write(uint8_t pdrv,        /**< Physical drive number */
                const uint8_t *buff, /**< Data to be written */
-               uint32_t sector,     /**< Sector address (LBA) */
-               uint32_t count       /**< Number of sectors to write */
+               hal_disk_lba_t sector, /**< Sector address (LBA) */
+               uint32_t count         /**< Number of sectors to write */
 );
 
 /* Generic IOCTL commands */
 #define HAL_DISK_IO_SYNC 0
-#define HAL_DISK_IO_GET_SECTOR_COUNT 1
-#define HAL_DISK_IO_GET_SECTOR_SIZE 2
-#define HAL_DISK_IO_GET_BLOCK_SIZE 3
+#define HAL_DISK_IO_GET_SECTOR_COUNT 1 /**< hal_disk_lba_t: sectors on the medium */
+#define HAL_DISK_IO_GET_SECTOR_SIZE 2  /**< uint16_t: bytes per sector */
+#define HAL_DISK_IO_GET_BLOCK_SIZE 3   /**< uint32_t: erase block, in sectors */
+#define HAL_DISK_IO_TRIM 4 /**< hal_disk_lba_t[2]: first and last sector unused */
+#define HAL_DISK_IO_WRITE_ASYNC 5 /**< hal_disk_async_write_t: write behind */
+
+/**
+ * @brief Argument of ::HAL_DISK_IO_WRITE_ASYNC.
+ *
+ * Starts writing @c count sectors and returns without waiting for the
+ * transfer. @c buff must stay untouched until the write has finished:
+ * every later hal_disk_* call on the drive waits for it first, and a
+ * request with @c count 0 does nothing else. A failed write-behind is
+ * reported by the call that waited for it. Backends that cannot overlap a
+ * write with the caller answer ::HAL_DISK_RES_PARERR; use ::hal_disk_write
+ * then.
+ */
+typedef struct {
+  const uint8_t *buff;   /**< count * 512 bytes */
+  hal_disk_lba_t sector; /**< Sector address (LBA) */
+  uint32_t count;        /**< Sectors; 0 = only wait */
+} hal_disk_async_write_t;
 
 hal_disk_result_t hal_disk_ioctl(uint8_t pdrv, uint8_t cmd, void *buff);
 
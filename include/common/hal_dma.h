@@ -65,6 +65,7 @@ extern "C" {
 #include "common/hal_status.h"
 #include "common/navhal_compiler.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /** @brief DMA controller selection. */
@@ -155,14 +156,60 @@ typedef struct {
   hal_dma_fifo_threshold_t fifo_threshold; /**< FIFO threshold. */
   hal_dma_burst_t mburst;                /**< Memory burst configuration. */
   hal_dma_burst_t pburst;                /**< Peripheral burst configuration. */
+  uint8_t mem_byte_access;               /**< 1 = byte-wide memory side, packed
+                                              to @c data_width by the FIFO
+                                              (needs @c fifo_mode): the memory
+                                              address may be unaligned. */
 } hal_dma_config_t;
 
+/**
+ * @brief Pre-built stream register image for fast re-arming.
+ *
+ * Filled by ::hal_dma_prepare. Holds everything about a stream that stays
+ * fixed between transfers (CR/FCR/PAR), so ::hal_dma_restart only has to
+ * write the memory address and item count. Treat the fields as opaque.
+ */
+typedef struct {
+  uint32_t cr;                     /**< CR image, EN clear. */
+  uint32_t fcr;                    /**< FCR image. */
+  uint32_t par;                    /**< Peripheral address. */
+  hal_dma_controller_t controller; /**< DMA controller. */
+  uint8_t stream;                  /**< Stream index [0..7]. */
+} hal_dma_handle_t;
+
 /**
  * @brief Initialize a DMA stream from @p cfg.
  * @return ::HAL_OK, or ::HAL_ERR_INVALID_ARG if @p cfg is NULL.
  */
 hal_status_t hal_dma_init(const hal_dma_config_t *cfg);
 
+/**
+ * @brief Initialize a DMA stream from @p cfg and capture its register image.
+ *
+ * Does everything ::hal_dma_init does, then stores the resulting CR/FCR/PAR
+ * in @p handle. Call once per stream configuration; each subsequent transfer
+ * is armed with ::hal_dma_restart. The memory address and item count in
+ * @p cfg only seed the first transfer.
+ *
+ * @return ::HAL_OK, or ::HAL_ERR_INVALID_ARG if an argument is NULL.
+ */
+hal_status_t hal_dma_prepare(const hal_dma_config_t *cfg,
+                             hal_dma_handle_t *handle);
+
+/**
+ * @brief Re-arm and enable a prepared stream for a new transfer.
+ *
+ * Clears the stream's flags, writes @p mem_addr (M0AR) and @p count (NDTR)
+ * and enables it. CR/FCR/PAR are only rewritten when the stream was
+ * reconfigured by someone else since ::hal_dma_prepare. A stream that is
+ * still enabled is stopped first — callers that must not cut a transfer
+ * short wait for completion before restarting.
+ *
+ * @return ::HAL_OK, or ::HAL_ERR_INVALID_ARG if @p handle is NULL.
+ */
+hal_status_t hal_dma_restart(const hal_dma_handle_t *handle, uint32_t mem_addr,
+                             uint16_t count);
+
 /**
  * @brief Enable a previously initialized DMA stream.
  * @return ::HAL_OK, or ::HAL_ERR_INVALID_ARG if @p cfg is NULL.
@@ -187,6 +234,123 @@ bool hal_dma_transfer_complete(const hal_dma_config_t *cfg);
  */
 hal_status_t hal_dma_clear_flags(const hal_dma_config_t *cfg);
 
+/* -------------------------------------------------------------------------- *
+ * DMA buffer pool.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @brief Size in bytes of the pool behind ::hal_dma_alloc.
+ *
+ * Override on the compiler command line. With
+ * `CONFIG_DMA_POOL_NONCACHEABLE` the pool is one MPU region, so the size
+ * must be a power of two.
+ */
+#ifndef HAL_DMA_POOL_SIZE
+#define HAL_DMA_POOL_SIZE 8192U
+#endif
+
+/** @brief MPU region used for a non-cacheable pool (highest wins overlaps). */
+#ifndef HAL_DMA_POOL_MPU_REGION
+#define HAL_DMA_POOL_MPU_REGION 7U
+#endif
+
+/**
+ * @brief Allocate a DMA-safe buffer from the static pool.
+ *
+ * The buffer starts on a cache line and its size is rounded up to whole
+ * lines, so cache maintenance on it never touches unrelated data. On builds
+ * with `CONFIG_DMA_POOL_NONCACHEABLE` the whole pool is mapped non-cacheable
+ * by the first call. Buffers are never freed; allocate during init, not
+ * from interrupt context.
+ *
+ * @return The buffer, or NULL if @p len is 0 or the pool is exhausted.
+ */
+void *hal_dma_alloc(size_t len);
+
+/* -------------------------------------------------------------------------- *
+ * Descriptor chains — software linked-list mode.
+ *
+ * The F4/F7 streams have no hardware linked-list mode, so a scatter/gather
+ * sequence is emulated: the stream ISR loads the next descriptor straight into
+ * the stream registers and re-enables it, and only the end of the chain (or
+ * an error) reaches the application through one callback.
+ * -------------------------------------------------------------------------- */
+
+/** Descriptor flags (::hal_dma_desc_t::flags). */
+#define HAL_DMA_DESC_MEM_FIXED (1U << 0)  /**< Do not increment memory. */
+#define HAL_DMA_DESC_PERIPH_INC (1U << 1) /**< Increment the peripheral side. */
+
+/**
+ * @brief One chain entry.
+ *
+ * @c src and @c dst follow the stream direction exactly like
+ * ::hal_dma_config_t: in M2P @c src is memory and @c dst the peripheral, in
+ * P2M and M2M @c src is the peripheral-port address. Both may change per
+ * entry, so one chain can gather from several buffers or alternate between
+ * peripherals served by the same stream/channel.
+ */
+typedef struct {
+  uint32_t src;   /**< Source address. */
+  uint32_t dst;   /**< Destination address. */
+  uint16_t count; /**< Number of data items (NDTR). */
+  uint16_t flags; /**< HAL_DMA_DESC_* flags. */
+} hal_dma_desc_t;
+
+/**
+ * @brief Chain completion callback, invoked from the stream ISR.
+ * @param status ::HAL_OK when every entry completed, ::HAL_ERR_IO on a
+ *               transfer error.
+ * @param ctx    Context pointer passed to ::hal_dma_chain_start.
+ */
+typedef void (*hal_dma_chain_callback_t)(hal_status_t status, void *ctx);
+
+/** @brief Chain state. Initialize with ::hal_dma_chain_init; opaque. */
+typedef struct {
+  hal_dma_handle_t handle;           /**< Prepared stream image. */
+  const hal_dma_desc_t *desc;        /**< Descriptor array being run. */
+  uint16_t len;                      /**< Number of descriptors. */
+  volatile uint16_t pos;             /**< Descriptor currently in flight. */
+  volatile bool busy;                /**< True while the chain runs. */
+  bool mem_is_src;                   /**< M2P: memory is the source. */
+  hal_dma_chain_callback_t callback; /**< Completion callback. */
+  void *ctx;                         /**< Callback context. */
+} hal_dma_chain_t;
+
+/**
+ * @brief Bind a chain to the stream described by @p cfg.
+ *
+ * Prepares the stream (see ::hal_dma_prepare) and enables its NVIC line.
+ * Address and count fields of @p cfg are ignored; descriptors supply them.
+ *
+ * @return ::HAL_OK, or ::HAL_ERR_INVALID_ARG if an argument is NULL or
+ *         @p cfg asks for circular mode.
+ */
+hal_status_t hal_dma_chain_init(hal_dma_chain_t *chain,
+                                const hal_dma_config_t *cfg);
+
+/**
+ * @brief Run @p len descriptors back to back on the chain's stream.
+ *
+ * @p desc must stay valid until the callback fires. While the chain runs the
+ * stream's interrupt is serviced by the chain engine and is not dispatched
+ * to callbacks attached with hal_interrupt_attach_callback().
+ *
+ * @return ::HAL_OK once the first entry is running, ::HAL_ERR_BUSY if the
+ *         chain is still running, or ::HAL_ERR_INVALID_ARG.
+ */
+hal_status_t hal_dma_chain_start(hal_dma_chain_t *chain,
+                                 const hal_dma_desc_t *desc, uint16_t len,
+                                 hal_dma_chain_callback_t callback, void *ctx);
+
+/**
+ * @brief Stop a running chain without invoking its callback.
+ * @return ::HAL_OK, or ::HAL_ERR_INVALID_ARG if @p chain is NULL.
+ */
+hal_status_t hal_dma_chain_abort(hal_dma_chain_t *chain);
+
+/** @brief True while @p chain has descriptors in flight. */
+bool hal_dma_chain_busy(const hal_dma_chain_t *chain);
+
 /* -------------------------------------------------------------------------- *
  * Deprecated — pre-standardization DMA type names. Retained as a
  * backward-compat alias behind NAVHAL_DEPRECATED.
@@ -40,6 +40,7 @@
  * - `NAVHAL_HAS_CRC_HW`         &larr; `CONFIG_DRV_CRC`
  * - `NAVHAL_HAS_CYCLE_COUNTER`  &larr; `CONFIG_DRV_DWT`
  * - `NAVHAL_HAS_SDIO`           &larr; `CONFIG_DRV_SDIO`
+ * - `NAVHAL_HAS_CACHE`          &larr; `CONFIG_DRV_CACHE`
  */
 
 #ifndef HAL_FEATURES_H
@@ -99,6 +100,13 @@ extern "C" {
 #define NAVHAL_HAS_SDIO 0
 #endif
 
+/** @brief 1 if an L1 data/instruction cache needs software maintenance. */
+#if defined(_CACHE_ENABLED)
+#define NAVHAL_HAS_CACHE 1
+#elif !defined(NAVHAL_HAS_CACHE)
+#define NAVHAL_HAS_CACHE 0
+#endif
+
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -58,6 +58,7 @@ extern "C" {
 #define SD_CMD_GO_IDLE_STATE 0
 #define SD_CMD_ALL_SEND_CID 2
 #define SD_CMD_SEND_REL_ADDR 3
+#define SD_CMD_SWITCH_FUNC 6
 #define SD_CMD_SELECT_DESELECT_CARD 7
 #define SD_CMD_HS_SEND_EXT_CSD 8
 #define SD_CMD_STOP_TRANSMISSION 12
@@ -67,16 +68,25 @@ extern "C" {
 #define SD_CMD_READ_MULT_BLOCK 18
 #define SD_CMD_WRITE_SINGLE_BLOCK 24
 #define SD_CMD_WRITE_MULT_BLOCK 25
+#define SD_CMD_ERASE_WR_BLK_START 32
+#define SD_CMD_ERASE_WR_BLK_END 33
+#define SD_CMD_ERASE 38
 #define SD_CMD_APP_CMD 55
 #define SD_ACMD_SD_SEND_OP_COND 41
 #define SD_ACMD_SET_BUS_WIDTH 6
+#define SD_ACMD_SD_STATUS 13
+#define SD_ACMD_SET_WR_BLK_ERASE_COUNT 23
 
 /**
  * @brief SDIO initialization configuration.
  */
 typedef struct {
-  uint32_t clock_div; /**< SDIO_CK = SDIOCLK / (clock_div + 2). */
+  uint32_t clock_div; /**< Unused: the bus clock is chosen automatically
+                           (400 kHz for identification, then the fastest
+                           rate the card's speed mode allows). */
   uint8_t bus_width;  /**< 0: 1-bit, 1: 4-bit. */
+  uint8_t default_speed; /**< 1: skip the CMD6 High Speed switch and stay at
+                              default speed (25 MHz max). */
 } hal_sdio_config_t;
 
 /**
@@ -149,6 +159,19 @@ hal_sdio_error_t hal_sdio_wait_flag(uint32_t flag, uint32_t timeout);
  */
 hal_sdio_error_t hal_sdio_wait_sync(hal_sdio_error_t result);
 
+/**
+ * @brief Block until the card has finished programming the last write.
+ *
+ * Writes return once the card has accepted the data; the busy period is
+ * only checked (with a single CMD13) before the next data command. Call
+ * this where the data must be durable, e.g. before removing power. With the
+ * DMA backend it first waits for the request queue to drain.
+ *
+ * @return ::HAL_SDIO_OK once the card is back in transfer state,
+ *         ::HAL_SDIO_BUSY if queued requests did not finish within 1 s.
+ */
+hal_sdio_error_t hal_sdio_wait_ready(void);
+
 /**
  * @brief Read a single 512-byte block from the SD card.
  * @param addr   Sector address (LBA).
@@ -165,12 +188,74 @@ hal_sdio_error_t hal_sdio_read_block(uint32_t addr, uint8_t *buffer);
  */
 hal_sdio_error_t hal_sdio_write_block(uint32_t addr, const uint8_t *buffer);
 
+/**
+ * @brief Read @p count consecutive 512-byte blocks with one CMD18.
+ *
+ * Polled: the FIFO is drained in 8-word bursts on the half-full flag, with
+ * interrupts masked for one block at a time. Needs no DMA.
+ *
+ * @param addr   First sector address (LBA).
+ * @param buffer Destination, @p count * 512 bytes, word aligned.
+ * @param count  Number of blocks, 1..65535 (1 issues CMD17).
+ * @return Read status; ::HAL_SDIO_ERROR for a NULL buffer or bad count.
+ */
+hal_sdio_error_t hal_sdio_read_blocks(uint32_t addr, uint8_t *buffer,
+                                      uint32_t count);
+
+/**
+ * @brief Write @p count consecutive 512-byte blocks with one CMD25.
+ *
+ * Polled counterpart of ::hal_sdio_read_blocks. Multi-block writes are
+ * preceded by ACMD23 so the card can pre-erase the range.
+ *
+ * @param addr   First sector address (LBA).
+ * @param buffer Source, @p count * 512 bytes, word aligned.
+ * @param count  Number of blocks, 1..65535 (1 issues CMD24).
+ * @return Write status; ::HAL_SDIO_ERROR for a NULL buffer or bad count.
+ */
+hal_sdio_error_t hal_sdio_write_blocks(uint32_t addr, const uint8_t *buffer,
+                                       uint32_t count);
+
+/**
+ * @brief Current SDIO_CK frequency in Hz.
+ *
+ * After ::hal_sdio_card_init this is up to 50 MHz for a High Speed card (the
+ * SDIO clock source itself, bypassing the divider, when that is <= 50 MHz)
+ * or 25 MHz otherwise. Data CRC errors lower it a step at a time.
+ */
+uint32_t hal_sdio_get_bus_clock(void);
+
 /**
  * @brief Get the SD card's total sector count.
- * @return Number of 512-byte sectors.
+ *
+ * Parsed from the CSD read during ::hal_sdio_card_init; no bus traffic.
+ * @return Number of 512-byte sectors, 0 before a card was initialised.
  */
 uint32_t hal_sdio_get_sector_count(void);
 
+/**
+ * @brief Get the card's erase/allocation unit in sectors.
+ *
+ * The AU size from SD_STATUS (ACMD13) when the card reports one, else the
+ * erase sector size from the CSD. Erasing and writing whole, aligned units
+ * avoids the card's internal read-modify-write.
+ *
+ * @return Unit size in 512-byte sectors, 0 before a card was initialised.
+ */
+uint32_t hal_sdio_get_erase_unit(void);
+
+/**
+ * @brief Erase sectors @p first .. @p last (inclusive): CMD32, CMD33, CMD38.
+ *
+ * Waits for the card to finish, allowing 250 ms per erase unit touched.
+ * Erased sectors read back as all 0x00 or all 0xFF, depending on the card.
+ *
+ * @return ::HAL_SDIO_OK, ::HAL_SDIO_ERROR for @p last < @p first,
+ *         ::HAL_SDIO_BUSY while queued requests are running, or the
+ *         command / timeout error.
+ */
+hal_sdio_error_t hal_sdio_erase(uint32_t first, uint32_t last);
+
 #endif /* _SDIO_ENABLED */
 
 #ifdef __cplusplus
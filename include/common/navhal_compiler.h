@@ -50,6 +50,7 @@ extern "C" {
 #define NAVHAL_PACKED        __attribute__((packed))                    /**< Remove struct padding. */
 #define NAVHAL_NORETURN      __attribute__((noreturn))                  /**< Function never returns. */
 #define NAVHAL_DEPRECATED(msg) __attribute__((deprecated(msg)))         /**< Mark symbol deprecated. */
+#define NAVHAL_ALIGNED(n)    __attribute__((aligned(n)))                /**< Align object to @p n bytes. */
 
 #else /* non-GCC: degrade to no-ops */
 
@@ -61,6 +62,7 @@ extern "C" {
 #define NAVHAL_PACKED
 #define NAVHAL_NORETURN
 #define NAVHAL_DEPRECATED(msg)
+#define NAVHAL_ALIGNED(n)
 
 #endif
 
@@ -20,8 +20,8 @@
  * @brief Cortex-M4 clock-control port header.
  *
  * @details
- * The public prototypes live in @c common/hal_clock.h, which includes this
- * header. Retained to preserve the @c navhal_port_clock.h include path.
+ * The portable prototypes live in @c common/hal_clock.h, which includes this
+ * header. Adds the STM32 flash-accelerator control used by @c hal_clock_init.
  */
 
 #ifndef NAVHAL_PORT_CLOCK_H
@@ -29,4 +29,25 @@
 
 #include "common/hal_clock.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Apply the flash prefetch / cache accelerator state.
+ *
+ * Called by ::hal_clock_init with @c cfg->accel_disable; exposed so the
+ * accelerators can be switched at run time (e.g. to benchmark them) without
+ * re-running the PLL sequence. Caches are reset while disabled, so nothing
+ * fetched before the call survives it.
+ *
+ * @param disable ::HAL_CLOCK_ACCEL_NO_PREFETCH / ::HAL_CLOCK_ACCEL_NO_ICACHE /
+ *                ::HAL_CLOCK_ACCEL_NO_DCACHE bits; 0 enables everything.
+ */
+void hal_clock_set_accel(uint8_t disable);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
 #endif /* NAVHAL_PORT_CLOCK_H */
@@ -63,6 +63,16 @@ extern "C" {
 /** @brief SysTick exception handler (vector-table entry). */
 void SysTick_Handler(void);
 
+/**
+ * @brief Driver hook run by hal_timebase_tick() ahead of the user callback.
+ *
+ * Weak no-op in timebase.c. A driver that needs a periodic tick from
+ * interrupt context defines it instead of taking the application's
+ * hal_timebase_set_callback() slot; sdio.c paces its card-busy polls with
+ * it. At most one driver in a build may define it.
+ */
+void hal_timebase_driver_tick(void);
+
 // Timer IRQ Handlers
 void TIM2_IRQHandler(void);
 void TIM3_IRQHandler(void);
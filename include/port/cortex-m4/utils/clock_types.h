@@ -48,6 +48,24 @@ typedef enum {
   HAL_CLOCK_SOURCE_PLL  ///< Phase-locked loop (derived clock)
 } hal_clock_source_t;
 
+/**
+ * @name Flash / cache accelerator opt-out flags
+ * @brief Bits for hal_clock_config_t::accel_disable.
+ *
+ * `hal_clock_init` enables every accelerator the part has unless its bit is
+ * set here, so a zero-initialised config gets the fast default.
+ * @{
+ */
+#define HAL_CLOCK_ACCEL_NO_PREFETCH (1U << 0) ///< Flash prefetch buffer
+#define HAL_CLOCK_ACCEL_NO_ICACHE                                              \
+  (1U << 1) ///< F4 flash I-cache; F7 ART accelerator + L1 I-cache
+#define HAL_CLOCK_ACCEL_NO_DCACHE                                              \
+  (1U << 2) ///< F4 flash D-cache; F7 L1 D-cache
+#define HAL_CLOCK_ACCEL_NONE                                                   \
+  (HAL_CLOCK_ACCEL_NO_PREFETCH | HAL_CLOCK_ACCEL_NO_ICACHE |                   \
+   HAL_CLOCK_ACCEL_NO_DCACHE) ///< Run with every accelerator off
+/** @} */
+
 /**
  * @brief System clock configuration structure.
  *
@@ -58,6 +76,7 @@ typedef struct {
   rcc_cfgr_hpre_div_t hpre_div;
   rcc_cfgr_ppre_div_t ppre1_div;
   rcc_cfgr_ppre_div_t ppre2_div;
+  uint8_t accel_disable; ///< HAL_CLOCK_ACCEL_NO_* bits; 0 enables everything
 } hal_clock_config_t;
 
 
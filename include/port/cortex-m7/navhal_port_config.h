@@ -67,6 +67,12 @@ extern "C" {
 #  endif
 #endif
 
+#if NAVHAL_HAS_CACHE
+#  ifndef _CACHE_ENABLED
+#    define _CACHE_ENABLED
+#  endif
+#endif
+
 /* Per-driver DMA-backend flags. These let a build keep DRV_DMA on for one
    driver while another opts out (e.g. DRV_DMA=y for SDIO, DRV_UART_DMA=n
    to save flash). Each is the legacy spelling of NAVHAL_HAS_<X>_DMA. */
@@ -46,6 +46,61 @@ extern "C" {
 #define SDIO_CMD_CPSMEN (1 << 10)
 
 #ifdef _SDIO_BACKEND_DMA
+/** @brief Completion callback for a queued ::hal_sdio_request_t. */
+typedef void (*hal_sdio_request_callback_t)(hal_sdio_error_t status,
+                                            void *ctx);
+
+/**
+ * @brief One queued block transfer.
+ *
+ * Caller-owned: it must stay valid (and its buffer untouched) until
+ * @c status leaves ::HAL_SDIO_PENDING or @c callback has run. Fill in the
+ * first six fields; the rest belong to the driver while queued.
+ */
+typedef struct hal_sdio_request {
+  uint32_t sector;                      /**< First sector (LBA). */
+  uint8_t *buffer;                      /**< count * 512 bytes, any alignment
+                                             (unaligned ones use byte-wide
+                                             DMA memory accesses); reads
+                                             must start on a cache line
+                                             while the D-cache is on. */
+  uint32_t count;                       /**< Blocks, 1..65535. */
+  uint8_t write;                        /**< 1: write to the card, 0: read. */
+  hal_sdio_request_callback_t callback; /**< Called from IRQ context; may
+                                             submit further requests. NULL
+                                             to poll @c status instead. */
+  void *ctx;                            /**< Passed to @c callback. */
+  volatile hal_sdio_error_t status;     /**< ::HAL_SDIO_PENDING until done. */
+  struct hal_sdio_request *next;        /**< Queue link (driver-owned). */
+} hal_sdio_request_t;
+
+/**
+ * @brief Queue a transfer; returns immediately.
+ *
+ * Requests run in submission order, driven entirely by the SDIO and DMA
+ * interrupts: card-busy check, command, DMA data phase, CMD12, callback.
+ * While a previous write leaves the card busy, its status is polled once
+ * per timebase tick (SysTick), for up to a second. New requests may be submitted at any time, including from a callback.
+ * The polled hal_sdio_read/write calls return ::HAL_SDIO_BUSY while the
+ * queue is non-empty.
+ *
+ * @return ::HAL_SDIO_PENDING, or ::HAL_SDIO_ERROR for a bad request —
+ *         including, while the D-cache is on, a read into a buffer that
+ *         does not start on a cache line (::NAVHAL_DMA_BUFFER).
+ */
+hal_sdio_error_t hal_sdio_submit(hal_sdio_request_t *req);
+
+/** @brief Non-zero while any queued request is unfinished. */
+uint8_t hal_sdio_queue_busy(void);
+
+/**
+ * @brief Cancel every queued request.
+ *
+ * Stops the transfer on the bus (with CMD12 if one was open) and completes
+ * each request with ::HAL_SDIO_ERROR, calling its callback.
+ */
+void hal_sdio_abort(void);
+
 /** @brief Asynchronous (DMA) single-block read. */
 hal_sdio_error_t hal_sdio_read_block_async(uint32_t addr, uint8_t *buffer);
 /** @brief Asynchronous (DMA) single-block write. */
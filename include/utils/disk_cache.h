@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file disk_cache.h
+ * @brief N-way set-associative write-back sector cache over hal_disk_*.
+ *
+ * @details
+ * Sits between the FatFs glue (src/utils/fatfs/diskio.c) and the block
+ * backend when @c CONFIG_DISK_CACHE is enabled. Single-sector reads and
+ * writes — FAT, directory and small-file traffic — are served from RAM;
+ * dirty sectors reach the card only on ::disk_cache_sync (FatFs
+ * @c CTRL_SYNC) or when their line is evicted. Either way, runs of
+ * consecutive dirty sectors go out as one multi-block ::hal_disk_write.
+ *
+ * Multi-sector requests bypass the cache so large transfers keep their
+ * single CMD18/CMD25, while any cached copy of the range is kept coherent.
+ *
+ * Sector @c s of a drive lives in set <tt>s % sets</tt>, and the data of a
+ * way is laid out by set, so consecutive sectors held in the same way are
+ * contiguous in memory and can be written back straight from the cache.
+ */
+
+#ifndef DISK_CACHE_H
+#define DISK_CACHE_H
+
+/**
+ * @defgroup HAL_UTIL_DISK_CACHE Disk cache
+ * @ingroup HAL_UTILS
+ * @brief Write-back sector cache under the FatFs diskio layer.
+ * @{
+ */
+
+#include "common/hal_diskio.h"
+#include <stdint.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Sector size handled by the cache, in bytes. */
+#ifndef DISK_CACHE_SECTOR_SIZE
+#define DISK_CACHE_SECTOR_SIZE 512U
+#endif
+
+/** @brief Total number of cached sectors (RAM = this x sector size). */
+#ifndef DISK_CACHE_SECTORS
+#define DISK_CACHE_SECTORS 16U
+#endif
+
+/** @brief Associativity; must divide ::DISK_CACHE_SECTORS. */
+#ifndef DISK_CACHE_WAYS
+#define DISK_CACHE_WAYS 4U
+#endif
+
+/** @brief Cache counters, in sectors unless noted otherwise. */
+typedef struct {
+  uint32_t hits;           /**< Single-sector accesses served from RAM */
+  uint32_t misses;         /**< Single-sector accesses that filled a line */
+  uint32_t bypassed;       /**< Sectors moved by multi-sector pass-through */
+  uint32_t writebacks;     /**< Dirty sectors written to the disk */
+  uint32_t writeback_ops;  /**< hal_disk_write calls issued for them */
+  uint32_t evictions;      /**< Valid lines replaced on a miss */
+} disk_cache_stats_t;
+
+/**
+ * @brief Read sectors through the cache.
+ * @return Result of the backend read, or ::HAL_DISK_RES_OK on a hit.
+ */
+hal_disk_result_t disk_cache_read(uint8_t pdrv, uint8_t *buff,
+                                  hal_disk_lba_t sector, uint32_t count);
+
+/**
+ * @brief Write sectors through the cache.
+ *
+ * A single sector is only stored (and marked dirty); a multi-sector write
+ * goes straight to the backend and refreshes any cached copies.
+ */
+hal_disk_result_t disk_cache_write(uint8_t pdrv, const uint8_t *buff,
+                                   hal_disk_lba_t sector, uint32_t count);
+
+/**
+ * @brief Write every dirty sector of @p pdrv back to the disk.
+ *
+ * Lines stay valid (and clean) afterwards. On error the failing run stays
+ * dirty so a later sync can retry it.
+ */
+hal_disk_result_t disk_cache_sync(uint8_t pdrv);
+
+/**
+ * @brief Drop lines of @p pdrv in [@p sector, @p sector + @p count) without
+ *        writing them back (the sectors were trimmed).
+ */
+void disk_cache_discard(uint8_t pdrv, hal_disk_lba_t sector, uint32_t count);
+
+/** @brief Drop every line of @p pdrv, dirty or not (media change). */
+void disk_cache_invalidate(uint8_t pdrv);
+
+/** @brief Copy the current counters into @p stats. */
+void disk_cache_get_stats(disk_cache_stats_t *stats);
+
+/** @brief Zero the counters. */
+void disk_cache_reset_stats(void);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/** @} */ /* end of group HAL_UTIL_DISK_CACHE */
+#endif /* DISK_CACHE_H */
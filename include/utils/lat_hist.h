@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file lat_hist.h
+ * @brief Log-scale latency histogram.
+ *
+ * @details
+ * Fixed-size, allocation-free histogram for per-operation latencies in any
+ * unit (typically DWT cycles). Bucket 0 counts zero; bucket @c b > 0 counts
+ * values in [2^(b-1), 2^b), so 33 buckets cover the whole 32-bit range with
+ * constant relative resolution — a 40 us block write and a 250 ms card
+ * garbage-collection pause land in the same table without tuning.
+ *
+ * Count, exact minimum, maximum and sum are kept alongside the buckets;
+ * percentiles are resolved to the upper edge of their bucket, clamped to
+ * the observed range.
+ */
+
+#ifndef LAT_HIST_H
+#define LAT_HIST_H
+
+/**
+ * @defgroup HAL_UTIL_LAT_HIST Latency histogram
+ * @ingroup HAL_UTILS
+ * @brief Power-of-two bucketed latency statistics.
+ * @{
+ */
+
+#include <stdint.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Number of buckets: zero plus one per power of two. */
+#define LAT_HIST_BUCKETS 33U
+
+/** @brief Latency histogram; zero it with ::lat_hist_reset before use. */
+typedef struct {
+  uint32_t count;                     /**< Samples added */
+  uint32_t min;                       /**< Smallest sample, 0 when empty */
+  uint32_t max;                       /**< Largest sample */
+  uint64_t sum;                       /**< Sum of all samples */
+  uint32_t bucket[LAT_HIST_BUCKETS];  /**< Samples per bucket */
+} lat_hist_t;
+
+/** @brief Empty @p h. */
+void lat_hist_reset(lat_hist_t *h);
+
+/** @brief Record one sample. */
+void lat_hist_add(lat_hist_t *h, uint32_t value);
+
+/** @brief Bucket index @p value falls into, 0..32. */
+uint8_t lat_hist_bucket(uint32_t value);
+
+/**
+ * @brief Largest value held by bucket @p b (0, 1, 3, 7, ... 0xFFFFFFFF).
+ *
+ * Together with <tt>lat_hist_bucket_max(b - 1) + 1</tt> as the lower edge
+ * this is what a host needs to rebuild the histogram from its counts.
+ */
+uint32_t lat_hist_bucket_max(uint8_t b);
+
+/**
+ * @brief Value below or at which @p permille / 1000 of the samples lie.
+ *
+ * Resolved to the upper edge of the bucket holding that rank and clamped
+ * to [min, max], so p0 is the minimum and p1000 the maximum exactly.
+ *
+ * @return 0 for an empty histogram.
+ */
+uint32_t lat_hist_percentile(const lat_hist_t *h, uint16_t permille);
+
+/** @brief Add every sample of @p src to @p dst. */
+void lat_hist_merge(lat_hist_t *dst, const lat_hist_t *src);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/** @} */ /* end of group HAL_UTIL_LAT_HIST */
+#endif /* LAT_HIST_H */
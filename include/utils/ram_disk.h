@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file ram_disk.h
+ * @brief Block device in RAM, served to FatFs as an extra physical drive.
+ *
+ * @details
+ * With @c CONFIG_DRV_RAM_DISK the FatFs glue (src/utils/fatfs/diskio.c)
+ * hands physical drive ::RAM_DISK_PDRV — volume "1:" by default — to this
+ * driver and every other drive to the hal_disk_* backend, so a scratch
+ * volume can sit next to the SD card. ::v_fs_mount_ram mounts it, and
+ * formats it when it holds no filesystem.
+ *
+ * The sectors live at ::RAM_DISK_BASE, or in a static buffer when that is
+ * 0; ::ram_disk_attach moves them at run time, e.g. into SDRAM once the
+ * memory controller is up, or into a host buffer. Transfers are memcpy:
+ * no latency and no failure modes, which also makes it a deterministic
+ * backend for counting FatFs sector traffic.
+ */
+
+#ifndef RAM_DISK_H
+#define RAM_DISK_H
+
+/**
+ * @defgroup HAL_UTIL_RAM_DISK RAM disk
+ * @ingroup HAL_UTILS
+ * @brief FatFs physical drive backed by RAM.
+ * @{
+ */
+
+#include "common/hal_diskio.h"
+#include <stdint.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Route a FatFs drive to the RAM disk (@c CONFIG_DRV_RAM_DISK). */
+#ifndef RAM_DISK
+#if defined(NAVHAL_CONFIG_DRV_RAM_DISK) && NAVHAL_CONFIG_DRV_RAM_DISK
+#define RAM_DISK 1
+#else
+#define RAM_DISK 0
+#endif
+#endif
+
+/** @brief Physical drive, and so volume number, of the RAM disk (1..9). */
+#ifndef RAM_DISK_PDRV
+#define RAM_DISK_PDRV 1
+#endif
+
+/** @brief Size in 512-byte sectors (@c CONFIG_RAM_DISK_SECTORS). FatFs
+ *         formats volumes of 128 sectors and up. */
+#ifndef RAM_DISK_SECTORS
+#if defined(NAVHAL_CONFIG_RAM_DISK_SECTORS)
+#define RAM_DISK_SECTORS NAVHAL_CONFIG_RAM_DISK_SECTORS
+#else
+#define RAM_DISK_SECTORS 128U
+#endif
+#endif
+
+/** @brief Address of the sectors (@c CONFIG_RAM_DISK_BASE); 0 places them
+ *         in a static, word-aligned buffer. */
+#ifndef RAM_DISK_BASE
+#if defined(NAVHAL_CONFIG_RAM_DISK_BASE)
+#define RAM_DISK_BASE NAVHAL_CONFIG_RAM_DISK_BASE
+#else
+#define RAM_DISK_BASE 0
+#endif
+#endif
+
+/** @brief Transfer counters since start-up or ::ram_disk_reset_stats. */
+typedef struct {
+  uint32_t read_ops;        /**< ::ram_disk_read calls */
+  uint32_t write_ops;       /**< ::ram_disk_write calls */
+  uint32_t sectors_read;    /**< Sectors they read */
+  uint32_t sectors_written; /**< Sectors they wrote */
+} ram_disk_stats_t;
+
+/**
+ * @brief Serve the disk from @p sectors 512-byte sectors at @p base.
+ *
+ * The contents are taken as they are. The disk reports
+ * ::HAL_DISK_STATUS_NOINIT until initialised again, so a volume mounted on
+ * the old memory is remounted on its next use.
+ *
+ * @return ::HAL_DISK_RES_PARERR for a NULL @p base or no sectors.
+ */
+hal_disk_result_t ram_disk_attach(void *base, uint32_t sectors);
+
+/** @brief Ready the disk; the contents are kept. */
+hal_disk_status_t ram_disk_initialize(void);
+hal_disk_status_t ram_disk_status(void);
+
+hal_disk_result_t ram_disk_read(uint8_t *buff, hal_disk_lba_t sector,
+                                uint32_t count);
+hal_disk_result_t ram_disk_write(const uint8_t *buff, hal_disk_lba_t sector,
+                                 uint32_t count);
+
+/**
+ * @brief The hal_disk_ioctl commands. TRIM is accepted and ignored, and
+ *        ::HAL_DISK_IO_WRITE_ASYNC answered ::HAL_DISK_RES_PARERR: a write
+ *        is finished when ::ram_disk_write returns.
+ */
+hal_disk_result_t ram_disk_ioctl(uint8_t cmd, void *buff);
+
+/** @brief Copy the current counters into @p stats. */
+void ram_disk_get_stats(ram_disk_stats_t *stats);
+
+/** @brief Zero the counters. */
+void ram_disk_reset_stats(void);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/** @} */ /* end of group HAL_UTIL_RAM_DISK */
+#endif /* RAM_DISK_H */
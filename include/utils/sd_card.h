@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file sd_card.h
+ * @brief SD card register decoding shared by the SDIO driver and the
+ *        SPI-mode block device (utils/sd_spi.h).
+ */
+
+#ifndef SD_CARD_H
+#define SD_CARD_H
+
+/**
+ * @defgroup HAL_UTIL_SD_CARD SD card registers
+ * @ingroup HAL_UTILS
+ * @brief Decoding of SD card register fields.
+ * @{
+ */
+
+#include <stdint.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Allocation unit size, in 512-byte sectors, for the SD_STATUS
+ *        AU_SIZE code @p au_size (bits [431:428], the high nibble of byte
+ *        10 of the MSB-first status block).
+ *
+ * 1..0xA are 16 KB << (n - 1); 0xB..0xF are the SDXC sizes 12, 16, 24, 32
+ * and 64 MB, which do not follow that shift.
+ *
+ * @return The AU in sectors, or 0 when the card reports none.
+ */
+static inline uint32_t sd_au_sectors(uint8_t au_size) {
+  static const uint32_t au_sectors[16] = {0,     32,    64,    128,
+                                          256,   512,   1024,  2048,
+                                          4096,  8192,  16384, 24576,
+                                          32768, 49152, 65536, 131072};
+  return au_sectors[au_size & 0x0FU];
+}
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/** @} */ /* end of group HAL_UTIL_SD_CARD */
+#endif /* SD_CARD_H */
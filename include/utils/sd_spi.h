@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file sd_spi.h
+ * @brief SD card in SPI mode as the hal_disk_* block device.
+ *
+ * @details
+ * Portable backend for common/hal_diskio.h built only on hal_spi and
+ * hal_gpio, so FatFs and v_fs run on any port with an SPI master —
+ * including the ATmega328P, which has no SDIO peripheral. Enabled with
+ * @c CONFIG_DRV_SD_SPI, in place of the SDIO backend.
+ *
+ * The bus, the chip-select pin and the post-init clock come from the
+ * board (@c BOARD_SD_SPI_BUS, @c BOARD_SD_SPI_CS and, optionally,
+ * @c BOARD_SD_SPI_FAST_BAUDRATE in board.h); defining @c SD_SPI_BUS,
+ * @c SD_SPI_CS or @c SD_SPI_FAST_BAUDRATE overrides them.
+ *
+ * - ::hal_disk_initialize runs the SPI-mode handshake at the slowest
+ *   divider (CMD0, CMD8, ACMD41, CMD58), reads the CSD and SD_STATUS for
+ *   the geometry, and only then re-initialises the bus at the fast divider.
+ *   SDv1, SDv2 standard-capacity and SDHC/SDXC cards are supported.
+ * - Multi-sector reads are one CMD18 stream closed by CMD12; multi-sector
+ *   writes are one ACMD23 + CMD25 stream closed by the stop-tran token.
+ * - With @c CONFIG_SD_SPI_CRC the card is switched to CRC checking (CMD59)
+ *   and every data block carries and is checked against its CRC16. Without
+ *   it only CMD0 and CMD8 carry a valid CRC, as the card requires, which
+ *   saves the per-byte CRC work on slow cores.
+ *
+ * Like the SDIO backend it serves physical drive 0 only. hal_timebase must
+ * be running: every wait on the card is bounded in milliseconds.
+ */
+
+#ifndef SD_SPI_H
+#define SD_SPI_H
+
+/**
+ * @defgroup HAL_UTIL_SD_SPI SD card (SPI mode)
+ * @ingroup HAL_UTILS
+ * @brief hal_disk_* backend for SD cards on an SPI bus.
+ * @{
+ */
+
+#include "common/hal_diskio.h"
+#include <stdint.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Wait for the card to leave the busy state, in ms. */
+#ifndef SD_SPI_BUSY_TIMEOUT_MS
+#define SD_SPI_BUSY_TIMEOUT_MS 500U
+#endif
+
+/** @brief Wait for ACMD41 to report power-up complete, in ms. */
+#ifndef SD_SPI_INIT_TIMEOUT_MS
+#define SD_SPI_INIT_TIMEOUT_MS 1000U
+#endif
+
+/** @brief Wait for a read data token, in ms. */
+#ifndef SD_SPI_READ_TIMEOUT_MS
+#define SD_SPI_READ_TIMEOUT_MS 200U
+#endif
+
+/** @brief Wait for an erase (CTRL_TRIM) to finish, in ms. */
+#ifndef SD_SPI_ERASE_TIMEOUT_MS
+#define SD_SPI_ERASE_TIMEOUT_MS 30000U
+#endif
+
+/** @brief Card generation found by ::hal_disk_initialize. */
+typedef enum {
+  SD_SPI_CARD_NONE = 0, /**< No card, or the handshake failed */
+  SD_SPI_CARD_SDV1,     /**< SD 1.x, byte addressed */
+  SD_SPI_CARD_SDV2,     /**< SD 2.0 standard capacity, byte addressed */
+  SD_SPI_CARD_SDHC      /**< SDHC/SDXC, block addressed */
+} sd_spi_card_t;
+
+/** @brief What the driver learnt about the card during initialisation. */
+typedef struct {
+  sd_spi_card_t type;
+  uint32_t sectors;    /**< Capacity in 512-byte sectors, from the CSD */
+  uint32_t erase_unit; /**< Erase unit (AU) in sectors, 0 if unknown */
+  uint8_t crc;         /**< 1 = CRC checking is on (CMD59) */
+} sd_spi_info_t;
+
+/**
+ * @brief Copy the card description into @p info.
+ * @return ::HAL_DISK_RES_NOTRDY before a successful ::hal_disk_initialize,
+ *         ::HAL_DISK_RES_PARERR for a NULL @p info.
+ */
+hal_disk_result_t sd_spi_get_info(sd_spi_info_t *info);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/** @} */ /* end of group HAL_UTIL_SD_SPI */
+#endif /* SD_SPI_H */
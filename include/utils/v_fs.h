@@ -30,6 +30,7 @@
  * @{
  */
 
+#include "navhal_port_config.h"
 #include <stddef.h>
 #include <stdint.h>
 
@@ -44,6 +45,8 @@ extern "C" {
 #define V_O_CREAT 0x04
 #define V_O_TRUNC 0x08
 #define V_O_APPEND 0x10
+#define V_O_FASTSEEK 0x20 /**< Cluster link map on a writable file */
+#define V_O_BUFFERED 0x40 /**< Coalesce writes (CONFIG_VFS_WRITE_BUFFER) */
 
 /* Seek origins */
 #define V_SEEK_SET 0
@@ -52,17 +55,143 @@ extern "C" {
 
 typedef int v_fd_t;
 
+/**
+ * @brief File offsets and sizes: 64-bit with @c CONFIG_VFS_EXFAT, whose
+ *        files may exceed 4 GiB, otherwise @c long.
+ *
+ * A -DV_FS_LARGE_FILES=n build flag overrides the choice.
+ */
+#ifndef V_FS_LARGE_FILES
+#if defined(NAVHAL_CONFIG_VFS_EXFAT) && NAVHAL_CONFIG_VFS_EXFAT
+#define V_FS_LARGE_FILES 1
+#else
+#define V_FS_LARGE_FILES 0
+#endif
+#endif
+
+#if V_FS_LARGE_FILES
+typedef int64_t v_off_t;
+#else
+typedef long v_off_t;
+#endif
+
+/**
+ * @brief Sizes to reserve (::v_open_stream, ::v_preallocate): unsigned,
+ *        so a FAT file's full 4 GiB - 1 fits either way.
+ */
+#if V_FS_LARGE_FILES
+typedef uint64_t v_size_t;
+#else
+typedef uint32_t v_size_t;
+#endif
+
+/**
+ * @brief Files open at once, 1..32 (@c CONFIG_VFS_MAX_OPEN_FILES).
+ *
+ * Each descriptor costs a FatFs FIL: about 560 bytes with its own sector
+ * buffer, about 50 with @c CONFIG_VFS_TINY, where every file shares the
+ * volume's sector window (FF_FS_TINY) and pays for it with window reloads
+ * when several files are written in turn.
+ */
+#ifndef V_FS_MAX_OPEN_FILES
+#if defined(NAVHAL_CONFIG_VFS_MAX_OPEN_FILES)
+#define V_FS_MAX_OPEN_FILES NAVHAL_CONFIG_VFS_MAX_OPEN_FILES
+#else
+#define V_FS_MAX_OPEN_FILES 4U
+#endif
+#endif
+
+/**
+ * @brief Cluster link map (CLMT) size per open file, in 32-bit items.
+ *
+ * With @c CONFIG_VFS_FASTSEEK each descriptor owns a map of this many
+ * items; a file in @c n fragments needs <tt>2 * n + 2</tt>. A file too
+ * fragmented for it is simply opened without fast seek.
+ */
+#ifndef V_FS_CLMT_ITEMS
+#define V_FS_CLMT_ITEMS 32U
+#endif
+
+/** @brief Streaming files (::v_open_stream) open at once; each buffers one
+ *         sector. */
+#ifndef V_FS_MAX_STREAMS
+#define V_FS_MAX_STREAMS 1U
+#endif
+
+/**
+ * @brief Directory entry cache size (@c CONFIG_VFS_DCACHE), a power of two.
+ *
+ * ::v_open remembers where it found each path's directory entry, about 32
+ * bytes per slot; reopening a remembered path reads that one directory
+ * sector at most. Paths hashing to the same slot replace each other.
+ */
+#ifndef V_FS_DCACHE_ENTRIES
+#define V_FS_DCACHE_ENTRIES 16U
+#endif
+
+/** @brief Size of each half of a write buffer, in sectors; a power of two.
+ *         Best a multiple of the cluster size, which FatFs writes whole. */
+#ifndef V_FS_WBUF_SECTORS
+#define V_FS_WBUF_SECTORS 8U
+#endif
+
+/** @brief Files opened with ::V_O_BUFFERED at once. */
+#ifndef V_FS_MAX_WBUFS
+#define V_FS_MAX_WBUFS 1U
+#endif
+
 /**
  * @brief Initialize the filesystem and mount the default drive.
  * @return 0 on success, negative error code otherwise.
  */
 int v_fs_init(void);
 
+/**
+ * @brief Mount the RAM disk (@c CONFIG_DRV_RAM_DISK) as its own drive,
+ *        "1:" by default, beside the default one.
+ *
+ * A disk without a filesystem — fresh RAM — is formatted first: FAT12/16
+ * with one FAT and no partition table. Files on it are then opened with
+ * the drive prefix, e.g. <tt>v_open("1:tmp.bin", ...)</tt>.
+ *
+ * @return 0 on success, negative error code otherwise
+ *         (-FR_INVALID_DRIVE without the RAM disk).
+ */
+int v_fs_mount_ram(void);
+
 /**
  * @brief Open a file.
+ *
+ * With @c CONFIG_VFS_FASTSEEK, files opened read-only — and writable ones
+ * opened with ::V_O_FASTSEEK, meant for preallocated files — get a cluster
+ * link map built at open. ::v_lseek and ::v_read then find any offset's
+ * cluster in RAM instead of following the FAT chain from the start of the
+ * file, so random access costs the same anywhere in the file. A write or
+ * seek past the clusters the map covers drops it and grows the file as
+ * usual.
+ *
+ * With @c CONFIG_VFS_DCACHE, an existing file opened again without
+ * ::V_O_TRUNC is found through the directory entry cache instead of a walk
+ * of its directories. Paths are matched however they are spelled
+ * ("1:/a/b" is "1:a//B"). Deleting any file with ::v_unlink empties the
+ * cache; after renaming or deleting files with FatFs directly, remount
+ * with ::v_fs_init so that no stale entry can be used. File names may be long
+ * (up to 255 characters) with @c CONFIG_VFS_LFN, 8.3 otherwise.
+ *
+ * With @c CONFIG_VFS_WRITE_BUFFER, a writable file opened with
+ * ::V_O_BUFFERED collects ::v_write data in RAM until the file position
+ * reaches a multiple of ::V_FS_WBUF_SECTORS sectors, then writes the whole
+ * window at once: small records cost one multi-sector write per window
+ * and no partial-sector read-modify-write. Two windows alternate; on DMA
+ * builds a full one is written in the background while the next fills.
+ * ::v_read, ::v_lseek, ::v_sync and ::v_close write out what is buffered
+ * first, so a write error may be reported by any of them. When all
+ * ::V_FS_MAX_WBUFS buffers are taken the file is opened unbuffered.
+ *
  * @param path Path to the file.
  * @param flags Access flags (V_O_...).
- * @return File descriptor on success, negative error code otherwise.
+ * @return File descriptor (the lowest free one) on success, -1 when all
+ *         ::V_FS_MAX_OPEN_FILES are in use, negative error code otherwise.
  */
 v_fd_t v_open(const char *path, int flags);
 
@@ -96,9 +225,11 @@ int v_write(v_fd_t fd, const void *buf, size_t count);
  * @param fd File descriptor.
  * @param offset Offset from origin.
  * @param whence Origin (V_SEEK_...).
- * @return New position on success, negative error code otherwise.
+ * @return New position on success, negative error code otherwise
+ *         (-FR_INVALID_PARAMETER for a position before the start or past
+ *         the largest file size).
  */
-long v_lseek(v_fd_t fd, long offset, int whence);
+v_off_t v_lseek(v_fd_t fd, v_off_t offset, int whence);
 
 /**
  * @brief Create a directory.
@@ -117,19 +248,49 @@ int v_unlink(const char *path);
  */
 int v_sync(v_fd_t fd);
 
+/**
+ * @brief Open a contiguous streaming file for sustained sequential writes.
+ *
+ * Creates (or truncates) @p path and reserves @p size bytes of contiguous
+ * clusters with f_expand(), committing the cluster chain and directory
+ * entry before returning. ::v_write then appends straight to the reserved
+ * sectors: whole sectors go out from the caller's buffer as one
+ * multi-block write, and only a partial last sector is buffered. Neither
+ * the FAT nor the directory is touched while streaming.
+ *
+ * - Writes past @p size are cut short; once it is full ::v_write fails.
+ * - ::v_sync writes the buffered partial sector and syncs the card; the
+ *   directory entry keeps the reserved size until ::v_close.
+ * - ::v_close commits the written length and frees the unused clusters.
+ *   After a power loss the file keeps its reserved size and whatever the
+ *   unwritten clusters held before.
+ * - The file is write-only and append-only: ::v_read fails and ::v_lseek
+ *   only answers <tt>v_lseek(fd, 0, V_SEEK_CUR)</tt>.
+ *
+ * At most ::V_FS_MAX_STREAMS streams are open at once.
+ *
+ * @param path Path to the file (with drive prefix, e.g. "0:rec.bin").
+ * @param size Bytes to reserve, > 0; up to 4 GiB - 1 on FAT.
+ * @return File descriptor on success, negative error code otherwise
+ *         (-FR_DENIED when no contiguous run of that size is free).
+ */
+v_fd_t v_open_stream(const char *path, v_size_t size);
+
 /**
  * @brief Pre-allocate a file with contiguous sectors on first boot.
  *
  * If the file already exists this is a no-op. Otherwise the file is
  * created and f_expand() is used to reserve `size` bytes of contiguous
  * space so that subsequent in-place writes never modify the FAT chain,
- * giving near-crash-safe behaviour for sequential logs.
+ * giving near-crash-safe behaviour for sequential logs. Only the FAT and
+ * the directory entry are written: the file's contents are whatever the
+ * clusters held before.
  *
  * @param path Path to the file (with drive prefix, e.g. "0:log.dat").
- * @param size Number of bytes to pre-allocate.
+ * @param size Number of bytes to pre-allocate; up to 4 GiB - 1 on FAT.
  * @return 0 on success, negative FatFS error code otherwise.
  */
-int v_preallocate(const char *path, uint32_t size);
+int v_preallocate(const char *path, v_size_t size);
 
 
 #ifdef __cplusplus
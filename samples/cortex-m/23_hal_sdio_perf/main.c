@@ -90,7 +90,9 @@ int main(void) {
     while (1)
       ;
   }
-  hal_uart_write_string(HAL_UART_2, "SD Card Ready.\n\r");
+  hal_uart_write_string(HAL_UART_2, "SD Card Ready. Bus clock: ");
+  hal_uart_write_uint(HAL_UART_2, hal_sdio_get_bus_clock() / 1000);
+  hal_uart_write_string(HAL_UART_2, " kHz\n\r");
 
   if (hal_disk_initialize(0) != HAL_DISK_STATUS_OK) {
     hal_uart_write_string(HAL_UART_2, "Disk Init Failed!\n\r");
@@ -116,9 +118,8 @@ int main(void) {
 
   start_time = hal_timebase_get_tick();
 
-  // Note: Using a single block write loop to match current diskio
-  // implementation. Multi-block commands would be much faster but
-  // hal_disk_write currently uses a loop of single blocks.
+  // Each chunk goes out as one multi-block CMD25 (ACMD23 pre-erase) on the
+  // DMA backend; without DMA, hal_disk_write falls back to single blocks.
   for (int i = 0; i < TEST_SECTORS; i += CHUNK_SIZE) {
     res = hal_disk_write(0, buf, TEST_START_SECTOR + i, CHUNK_SIZE);
     if (res != HAL_DISK_RES_OK)
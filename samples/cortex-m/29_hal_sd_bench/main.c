@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file main.c
+ * @brief SD card benchmark sweep with latency histograms over UART.
+ *
+ * @details
+ * - Initializes PLL (84MHz), the DWT cycle counter and SDIO.
+ * - Sweeps transfer size, run length and buffer alignment over the raw
+ *   hal_sdio and hal_disk layers, then formats the card and repeats the
+ *   sweep through f_write / f_read.
+ * - Prints one JSON object per sweep point on HAL_UART_2 (115200 8N1):
+ *   throughput, percentiles and the log2 histogram of per-operation cycle
+ *   counts. See sd_bench.h for the format.
+ *
+ * WARNING: this erases the card — the raw layers overwrite it and the
+ * FatFs sweep runs on a freshly made file system.
+ *
+ * Without a board, `tests_host_sd_bench --sweep` (tests/host) runs the same
+ * sweep against the host SD card model and prints the same lines.
+ */
+
+#define CORTEX_M4
+#include "navhal.h"
+#include "ff.h"
+#include "sd_bench.h"
+
+/** @brief Raw layers start 4 MiB in, past the card's first (FAT) AU. */
+#define RAW_START_SECTOR 8192U
+
+#define MAX_SIZE 32768U
+#define MAX_ALIGN 3U
+
+static const uint32_t sizes[] = {512, 4096, 32768};
+static const uint16_t counts[] = {16, 256};
+static const uint8_t aligns[] = {0, 1};
+
+static uint8_t buf[HAL_CACHE_ALIGN_UP(MAX_SIZE + MAX_ALIGN + 1)]
+    NAVHAL_DMA_BUFFER;
+static FATFS fs;
+static uint8_t work[HAL_CACHE_ALIGN_UP(FF_MAX_SS)] NAVHAL_DMA_BUFFER;
+
+static void uart_puts(const char *s) { hal_uart_write_string(HAL_UART_2, s); }
+
+static void fail(const char *msg) {
+  hal_uart_write_string(HAL_UART_2, msg);
+  hal_uart_write_string(HAL_UART_2, "\n\r");
+  while (1)
+    ;
+}
+
+int main(void) {
+  /* 1. Setup clocks, logging and the cycle counter */
+  hal_pll_config_t pll_cfg = {.input_src = HAL_CLOCK_SOURCE_HSI,
+                              .pll_m = 16,
+                              .pll_n = 336,
+                              .pll_p = 4,
+                              .pll_q = 7};
+  hal_clock_config_t clk_cfg = {.source = HAL_CLOCK_SOURCE_PLL};
+
+  hal_clock_init(&clk_cfg, &pll_cfg);
+  hal_timebase_init(1000);
+  hal_uart_init(HAL_UART_2, &(hal_uart_config_t){.baudrate = 115200});
+  hal_cycle_counter_init();
+
+  hal_delay_ms(100);
+
+  /* 2. Initialize SDIO and the disk layer */
+  hal_sdio_config_t sd_config = {.bus_width = 1};
+  if (hal_sdio_init(&sd_config) != HAL_SDIO_OK)
+    fail("SDIO Peripheral Init Failed!");
+  if (hal_sdio_card_init() != HAL_SDIO_OK)
+    fail("SD Card Handshake Failed!");
+  if (hal_disk_initialize(0) != HAL_DISK_STATUS_OK)
+    fail("Disk Init Failed!");
+
+  uint32_t sectors = hal_sdio_get_sector_count();
+  if (sectors <= RAW_START_SECTOR)
+    fail("Card too small!");
+
+  sd_bench_config_t cfg = {.puts = uart_puts,
+                           .clock = hal_cycle_counter_get,
+                           .clock_hz = hal_clock_get_sysclk(),
+                           .bus_hz = hal_sdio_get_bus_clock(),
+                           .buf = buf,
+                           .buf_len = sizeof(buf),
+                           .sizes = sizes,
+                           .n_sizes = sizeof(sizes) / sizeof(sizes[0]),
+                           .counts = counts,
+                           .n_counts = sizeof(counts) / sizeof(counts[0]),
+                           .aligns = aligns,
+                           .n_aligns = sizeof(aligns) / sizeof(aligns[0]),
+                           .layers = SD_BENCH_SDIO | SD_BENCH_DISK,
+                           .lba = RAW_START_SECTOR,
+                           .sectors = sectors - RAW_START_SECTOR,
+                           .path = "0:BENCH.BIN"};
+
+  /* 3. Raw layers */
+  uint32_t failed = sd_bench_run(&cfg);
+
+  /* 4. FatFs, on a fresh volume */
+  if (f_mkfs("0:", NULL, work, sizeof(work)) != FR_OK)
+    fail("Format Failed!");
+  if (f_mount(&fs, "0:", 1) != FR_OK)
+    fail("Mount Failed!");
+  cfg.layers = SD_BENCH_FATFS;
+  failed += sd_bench_run(&cfg);
+  f_mount(NULL, "0:", 0);
+
+  hal_uart_write_string(HAL_UART_2, failed ? "Bench FAILED.\n\r"
+                                           : "Bench Complete.\n\r");
+  while (1)
+    ;
+}
@@ -0,0 +1,311 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file sd_bench.c
+ * @brief SD card benchmark sweep with per-operation latency histograms.
+ *
+ * @details
+ * Hardware independent apart from the layers it drives: the clock and the
+ * output go through ::sd_bench_config_t, so the same file runs on target
+ * and against the host SD card model (tests/host/main_sd_bench.c).
+ */
+
+#include "sd_bench.h"
+#include "common/hal_diskio.h"
+#include "common/hal_sdio.h"
+#include "ff.h"
+#include <stddef.h>
+
+#define SECTOR 512U
+
+/** @brief One operation of a layer; @p i is its index within the run. */
+typedef int32_t (*xfer_fn_t)(uint32_t i, uint8_t *p, uint32_t size,
+                             uint8_t write);
+
+typedef struct {
+  uint8_t mask;
+  const char *name;
+  xfer_fn_t xfer;
+} layer_t;
+
+static const sd_bench_config_t *s_cfg;
+static sd_bench_point_t s_pt;
+static FIL s_fil;
+static uint16_t s_run; /* tags the data of each write run */
+static uint32_t s_points, s_failed;
+
+/*---------------------------------------------------------------------------
+ * Output
+ *---------------------------------------------------------------------------*/
+
+static void put(const char *s) {
+  if (s_cfg->puts != NULL)
+    s_cfg->puts(s);
+}
+
+static void put_u64(uint64_t v) {
+  char buf[21];
+  char *p = &buf[sizeof(buf) - 1];
+  *p = '\0';
+  do {
+    *--p = (char)('0' + (v % 10U));
+    v /= 10U;
+  } while (v != 0);
+  put(p);
+}
+
+static void put_field(const char *key, uint64_t v) {
+  put(",\"");
+  put(key);
+  put("\":");
+  put_u64(v);
+}
+
+static void put_str_field(const char *key, const char *v) {
+  put(",\"");
+  put(key);
+  put("\":\"");
+  put(v);
+  put("\"");
+}
+
+static void report(void) {
+  const sd_bench_point_t *pt = &s_pt;
+  uint64_t total = pt->hist.sum + pt->sync;
+
+  put("{\"type\":\"point\"");
+  put_str_field("layer", pt->layer);
+  put_str_field("op", pt->op);
+  put_field("size", pt->size);
+  put_field("count", pt->count);
+  put_field("align", pt->align);
+  put(",\"err\":");
+  if (pt->err < 0) {
+    put("-");
+    put_u64((uint64_t)(-(int64_t)pt->err));
+  } else {
+    put_u64((uint64_t)pt->err);
+  }
+  put_field("n", pt->hist.count);
+  put_field("bytes", pt->bytes);
+  put_field("cycles", total);
+  put_field("sync", pt->sync);
+  put_field("kib_s",
+            total ? pt->bytes * s_cfg->clock_hz / total / 1024U : 0);
+  put_field("min", pt->hist.min);
+  put_field("p50", lat_hist_percentile(&pt->hist, 500));
+  put_field("p90", lat_hist_percentile(&pt->hist, 900));
+  put_field("p99", lat_hist_percentile(&pt->hist, 990));
+  put_field("p999", lat_hist_percentile(&pt->hist, 999));
+  put_field("max", pt->hist.max);
+  put(",\"hist\":{");
+  const char *sep = "\"";
+  for (uint8_t b = 0; b < LAT_HIST_BUCKETS; b++) {
+    if (pt->hist.bucket[b] == 0)
+      continue;
+    put(sep);
+    put_u64(b);
+    put("\":");
+    put_u64(pt->hist.bucket[b]);
+    sep = ",\"";
+  }
+  put("}}\r\n");
+
+  s_points++;
+  if (pt->err != 0)
+    s_failed++;
+  if (s_cfg->on_point != NULL)
+    s_cfg->on_point(pt);
+}
+
+/*---------------------------------------------------------------------------
+ * Layers
+ *---------------------------------------------------------------------------*/
+
+static int32_t xfer_sdio(uint32_t i, uint8_t *p, uint32_t size,
+                         uint8_t write) {
+  uint32_t n = size / SECTOR;
+  uint32_t lba = s_cfg->lba + i * n;
+  return (int32_t)(write ? hal_sdio_write_blocks(lba, p, n)
+                         : hal_sdio_read_blocks(lba, p, n));
+}
+
+static int32_t xfer_disk(uint32_t i, uint8_t *p, uint32_t size,
+                         uint8_t write) {
+  uint32_t n = size / SECTOR;
+  uint32_t lba = s_cfg->lba + i * n;
+  return (int32_t)(write ? hal_disk_write(0, p, lba, n)
+                         : hal_disk_read(0, p, lba, n));
+}
+
+static int32_t xfer_fatfs(uint32_t i, uint8_t *p, uint32_t size,
+                          uint8_t write) {
+  UINT done = 0;
+  FRESULT res = write ? f_write(&s_fil, p, size, &done)
+                      : f_read(&s_fil, p, size, &done);
+  if (res != FR_OK)
+    return (int32_t)res;
+  return done == size ? 0 : SD_BENCH_ERR_RANGE; /* volume full / EOF */
+}
+
+static const layer_t s_layers[] = {
+    {SD_BENCH_SDIO, "sdio", xfer_sdio},
+    {SD_BENCH_DISK, "disk", xfer_disk},
+    {SD_BENCH_FATFS, "fatfs", xfer_fatfs},
+};
+
+/*---------------------------------------------------------------------------
+ * Runs
+ *---------------------------------------------------------------------------*/
+
+static void stamp(uint8_t *p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t stamp_of(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+         ((uint32_t)p[3] << 24);
+}
+
+/* FatFs: open the file for the run and put the data @p align bytes in, so
+ * a misaligned run is misaligned in the file as well as in memory. */
+static int32_t fatfs_begin(uint32_t align, uint8_t write) {
+  FRESULT res = f_open(&s_fil, s_cfg->path,
+                       write ? (FA_CREATE_ALWAYS | FA_WRITE) : FA_READ);
+  if (res != FR_OK)
+    return (int32_t)res;
+  if (align == 0)
+    return 0;
+
+  int32_t err;
+  UINT done = 0;
+  if (!write)
+    err = (int32_t)f_lseek(&s_fil, align);
+  else if ((res = f_write(&s_fil, s_cfg->buf, align, &done)) != FR_OK)
+    err = (int32_t)res;
+  else
+    err = done != align ? SD_BENCH_ERR_RANGE : 0;
+  /* run() only closes the file once the sweep point has run. */
+  if (err != 0)
+    f_close(&s_fil);
+  return err;
+}
+
+static void run(const layer_t *l, uint32_t size, uint16_t count,
+                uint8_t align, uint8_t write) {
+  const sd_bench_config_t *cfg = s_cfg;
+  sd_bench_point_t *pt = &s_pt;
+
+  pt->layer = l->name;
+  pt->op = write ? "write" : "read";
+  pt->size = size;
+  pt->count = count;
+  pt->align = align;
+  pt->err = 0;
+  pt->bytes = 0;
+  pt->sync = 0;
+  lat_hist_reset(&pt->hist);
+
+  if (size == 0 || (size % SECTOR) != 0 || (uint64_t)size + align >
+                                                  cfg->buf_len) {
+    pt->err = SD_BENCH_ERR_RANGE;
+  } else if (l->mask != SD_BENCH_FATFS &&
+             (uint64_t)count * (size / SECTOR) > cfg->sectors) {
+    pt->err = SD_BENCH_ERR_RANGE;
+  } else if (l->mask == SD_BENCH_FATFS) {
+    pt->err = fatfs_begin(align, write);
+  }
+  if (pt->err != 0) {
+    report();
+    return;
+  }
+
+  uint8_t *p = cfg->buf + align;
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t tag = ((uint32_t)s_run << 16) | i;
+    if (write)
+      stamp(p, tag);
+
+    uint32_t t0 = cfg->clock();
+    int32_t err = l->xfer(i, p, size, write);
+    uint32_t dt = cfg->clock() - t0;
+
+    if (err != 0) {
+      pt->err = err;
+      break;
+    }
+    lat_hist_add(&pt->hist, dt);
+    pt->bytes += size;
+    if (!write && stamp_of(p) != tag) {
+      pt->err = SD_BENCH_ERR_VERIFY;
+      break;
+    }
+  }
+
+  if (l->mask == SD_BENCH_FATFS) {
+    if (write && pt->err == 0) {
+      uint32_t t0 = cfg->clock();
+      FRESULT res = f_sync(&s_fil);
+      pt->sync = cfg->clock() - t0;
+      if (res != FR_OK)
+        pt->err = (int32_t)res;
+    }
+    f_close(&s_fil);
+  }
+  report();
+}
+
+uint32_t sd_bench_run(const sd_bench_config_t *cfg) {
+  if (cfg == NULL || cfg->clock == NULL || cfg->buf == NULL)
+    return 1;
+  s_cfg = cfg;
+  s_points = 0;
+  s_failed = 0;
+
+  /* A non-trivial pattern, so nothing along the way can shortcut zeros. */
+  for (uint32_t i = 0; i < cfg->buf_len; i++)
+    cfg->buf[i] = (uint8_t)(i * 7U + 0x5A);
+
+  put("{\"type\":\"meta\"");
+  put_field("version", 1);
+  put_field("clock_hz", cfg->clock_hz);
+  put_field("bus_hz", cfg->bus_hz);
+  put("}\r\n");
+
+  for (uint8_t li = 0; li < sizeof(s_layers) / sizeof(s_layers[0]); li++) {
+    const layer_t *l = &s_layers[li];
+    if ((cfg->layers & l->mask) == 0)
+      continue;
+    for (uint8_t si = 0; si < cfg->n_sizes; si++)
+      for (uint8_t ci = 0; ci < cfg->n_counts; ci++)
+        for (uint8_t ai = 0; ai < cfg->n_aligns; ai++) {
+          s_run++;
+          run(l, cfg->sizes[si], cfg->counts[ci], cfg->aligns[ai], 1);
+          run(l, cfg->sizes[si], cfg->counts[ci], cfg->aligns[ai], 0);
+        }
+  }
+
+  put("{\"type\":\"done\"");
+  put_field("points", s_points);
+  put_field("failed", s_failed);
+  put("}\r\n");
+  return s_failed;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file sd_bench.h
+ * @brief SD card benchmark sweep with per-operation latency histograms.
+ *
+ * @details
+ * Sweeps transfer size x operations per run x buffer misalignment over up
+ * to three layers of the storage stack:
+ *
+ * - @c sdio  — polled ::hal_sdio_read_blocks / ::hal_sdio_write_blocks;
+ * - @c disk  — ::hal_disk_read / ::hal_disk_write (the DMA backend, with
+ *              read-ahead, when it is built in);
+ * - @c fatfs — @c f_write / @c f_read on one file, so cluster allocation
+ *              and FAT updates show up in the write latencies.
+ *
+ * Every operation is timed with the caller's free-running counter (the DWT
+ * cycle counter on target, a host clock in the host-model build) into a
+ * ::lat_hist_t. Each sweep point is reported as one JSON object per line
+ * through the caller's output function, so a host script can diff runs:
+ *
+ * @code
+ * {"type":"meta","version":1,"clock_hz":84000000,"bus_hz":24000000}
+ * {"type":"point","layer":"sdio","op":"write","size":4096,"count":64,
+ *  "align":0,"err":0,"n":64,"bytes":262144,"cycles":9371233,"sync":0,
+ *  "kib_s":2295,"min":..,"p50":..,"p90":..,"p99":..,"p999":..,"max":..,
+ *  "hist":{"17":60,"18":3,"24":1}}
+ * {"type":"done","points":36,"failed":0}
+ * @endcode
+ *
+ * (a point is a single line; it is wrapped here.) Latencies are in counter
+ * ticks; @c hist maps bucket @c b to its count, bucket @c b holding
+ * [2^(b-1), 2^b) ticks (see utils/lat_hist.h). @c kib_s includes the final
+ * @c f_sync of FatFs write runs, whose own latency is @c sync.
+ *
+ * The @c sdio and @c disk layers overwrite the sectors from
+ * ::sd_bench_config_t::lba on; keep them clear of the file system.
+ */
+
+#ifndef SD_BENCH_H
+#define SD_BENCH_H
+
+#include "utils/lat_hist.h"
+#include <stdint.h>
+
+/** @brief Layers selectable in ::sd_bench_config_t::layers. */
+#define SD_BENCH_SDIO (1U << 0)
+#define SD_BENCH_DISK (1U << 1)
+#define SD_BENCH_FATFS (1U << 2)
+
+/** @brief Read data did not carry the stamp written by the same run. */
+#define SD_BENCH_ERR_VERIFY (-1)
+/** @brief The run does not fit the card or the buffer. */
+#define SD_BENCH_ERR_RANGE (-2)
+
+/** @brief One measured sweep point, handed to ::sd_bench_config_t::on_point. */
+typedef struct {
+  const char *layer; /**< "sdio", "disk" or "fatfs" */
+  const char *op;    /**< "write" or "read" */
+  uint32_t size;     /**< Bytes per operation */
+  uint32_t count;    /**< Operations requested */
+  uint32_t align;    /**< Buffer (and FatFs file) offset in bytes */
+  int32_t err;       /**< 0, the layer's error code, or SD_BENCH_ERR_* */
+  uint64_t bytes;    /**< Bytes moved by completed operations */
+  uint32_t sync;     /**< f_sync latency closing a FatFs write run */
+  lat_hist_t hist;   /**< Latency of each completed operation */
+} sd_bench_point_t;
+
+/** @brief What to sweep, and where results go. */
+typedef struct {
+  void (*puts)(const char *s);   /**< Output sink, NULL for none */
+  void (*on_point)(const sd_bench_point_t *p); /**< Optional, per point */
+  uint32_t (*clock)(void);       /**< Free-running 32-bit tick counter */
+  uint32_t clock_hz;             /**< Its rate */
+  uint32_t bus_hz;               /**< Reported in the meta line, 0 = unknown */
+
+  uint8_t *buf;                  /**< Scratch buffer, word aligned */
+  uint32_t buf_len;              /**< >= largest size + largest align */
+
+  const uint32_t *sizes;         /**< Bytes per operation, multiples of 512 */
+  uint8_t n_sizes;
+  const uint16_t *counts;        /**< Operations per run */
+  uint8_t n_counts;
+  const uint8_t *aligns;         /**< Buffer misalignments in bytes */
+  uint8_t n_aligns;
+
+  uint8_t layers;                /**< SD_BENCH_* mask */
+  uint32_t lba;                  /**< First scratch sector (sdio, disk) */
+  uint32_t sectors;              /**< Scratch sectors available from @c lba */
+  const char *path;              /**< FatFs file on a mounted volume */
+} sd_bench_config_t;
+
+/**
+ * @brief Run the whole sweep: every layer, size, count and alignment, each
+ *        as a write run followed by a read-back run of the same data.
+ * @return Number of points that reported an error.
+ */
+uint32_t sd_bench_run(const sd_bench_config_t *cfg);
+
+#endif /* SD_BENCH_H */
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file cache.c
+ * @brief Standardized HAL L1 cache driver for Cortex-M7.
+ *
+ * @details
+ * Implements the `hal_cache_*` API declared in `common/hal_cache.h` on the
+ * ARMv7-M cache maintenance registers (SCB 0xE000EF50..) and the MPU.
+ * Compiled only when @c _CACHE_ENABLED is defined (Cortex-M7 builds with
+ * `CONFIG_DRV_CACHE`).
+ */
+
+#include "navhal_port_config.h"
+#ifdef _CACHE_ENABLED
+
+#include "common/hal_cache.h"
+#include <stdint.h>
+
+#define SCB_CCR (*(volatile uint32_t *)0xE000ED14)
+#define SCB_CCSIDR (*(volatile uint32_t *)0xE000ED80)
+#define SCB_CSSELR (*(volatile uint32_t *)0xE000ED84)
+#define SCB_ICIALLU (*(volatile uint32_t *)0xE000EF50)
+#define SCB_DCIMVAC (*(volatile uint32_t *)0xE000EF5C)
+#define SCB_DCISW (*(volatile uint32_t *)0xE000EF60)
+#define SCB_DCCMVAC (*(volatile uint32_t *)0xE000EF68)
+#define SCB_DCCIMVAC (*(volatile uint32_t *)0xE000EF70)
+#define SCB_DCCISW (*(volatile uint32_t *)0xE000EF74)
+
+#define SCB_CCR_DC (1U << 16)
+#define SCB_CCR_IC (1U << 17)
+
+#define MPU_CTRL (*(volatile uint32_t *)0xE000ED94)
+#define MPU_RNR (*(volatile uint32_t *)0xE000ED98)
+#define MPU_RBAR (*(volatile uint32_t *)0xE000ED9C)
+#define MPU_RASR (*(volatile uint32_t *)0xE000EDA0)
+#define MPU_TYPE (*(volatile uint32_t *)0xE000ED90)
+
+#define MPU_CTRL_ENABLE (1U << 0)
+#define MPU_CTRL_PRIVDEFENA (1U << 2)
+#define MPU_RASR_ENABLE (1U << 0)
+#define MPU_RASR_SIZE_POS 1U
+#define MPU_RASR_TEX_POS 19U
+#define MPU_RASR_AP_FULL (3U << 24)
+#define MPU_RASR_XN (1U << 28)
+
+/*---------------------------------------------------------------------------
+ * Internal helpers
+ *---------------------------------------------------------------------------*/
+
+static inline void _dsb(void) { __asm volatile("dsb 0xF" ::: "memory"); }
+static inline void _isb(void) { __asm volatile("isb 0xF" ::: "memory"); }
+
+/**
+ * @brief Apply a set/way operation to every line of the L1 D-cache.
+ * @param reg DCISW (invalidate) or DCCISW (clean + invalidate).
+ */
+static void _dcache_all(volatile uint32_t *reg) {
+  SCB_CSSELR = 0U; /* level 1 data cache */
+  _dsb();
+  uint32_t ccsidr = SCB_CCSIDR;
+  uint32_t sets = (ccsidr >> 13) & 0x7FFFU;
+  do {
+    uint32_t ways = (ccsidr >> 3) & 0x3FFU;
+    do {
+      /* M7: 32-byte lines (set at bit 5), 4 ways (way at bit 30). */
+      *reg = ((sets & 0x1FFU) << 5) | ((ways & 0x3U) << 30);
+    } while (ways-- != 0U);
+  } while (sets-- != 0U);
+  _dsb();
+}
+
+/** Walk the lines covering [addr, addr + len) through a by-address op. */
+static inline void _dcache_range(volatile uint32_t *reg, const void *addr,
+                                 size_t len) {
+  if (len == 0U || !(SCB_CCR & SCB_CCR_DC))
+    return;
+
+  uintptr_t a = (uintptr_t)addr & ~(uintptr_t)(HAL_CACHE_LINE_SIZE - 1U);
+  uintptr_t end = (uintptr_t)addr + len;
+  _dsb();
+  for (; a < end; a += HAL_CACHE_LINE_SIZE)
+    *reg = (uint32_t)a;
+  _dsb();
+  _isb();
+}
+
+/*---------------------------------------------------------------------------
+ * Public API
+ *---------------------------------------------------------------------------*/
+
+void hal_cache_icache_enable(void) {
+  if (SCB_CCR & SCB_CCR_IC)
+    return;
+  _dsb();
+  _isb();
+  SCB_ICIALLU = 0U;
+  _dsb();
+  _isb();
+  SCB_CCR |= SCB_CCR_IC;
+  _dsb();
+  _isb();
+}
+
+void hal_cache_icache_disable(void) {
+  _dsb();
+  _isb();
+  SCB_CCR &= ~SCB_CCR_IC;
+  SCB_ICIALLU = 0U;
+  _dsb();
+  _isb();
+}
+
+void hal_cache_dcache_enable(void) {
+  if (SCB_CCR & SCB_CCR_DC)
+    return;
+  /* Contents are undefined out of reset: invalidate before turning it on. */
+  _dcache_all(&SCB_DCISW);
+  SCB_CCR |= SCB_CCR_DC;
+  _dsb();
+  _isb();
+}
+
+void hal_cache_dcache_disable(void) {
+  SCB_CSSELR = 0U;
+  _dsb();
+  SCB_CCR &= ~SCB_CCR_DC;
+  _dsb();
+  /* Push anything still dirty out before the lines are forgotten. */
+  _dcache_all(&SCB_DCCISW);
+  _isb();
+}
+
+bool hal_cache_dcache_enabled(void) { return (SCB_CCR & SCB_CCR_DC) != 0U; }
+
+void hal_cache_clean_range(const void *addr, size_t len) {
+  _dcache_range(&SCB_DCCMVAC, addr, len);
+}
+
+void hal_cache_invalidate_range(const void *addr, size_t len) {
+  _dcache_range(&SCB_DCIMVAC, addr, len);
+}
+
+void hal_cache_clean_invalidate_range(const void *addr, size_t len) {
+  _dcache_range(&SCB_DCCIMVAC, addr, len);
+}
+
+hal_status_t hal_cache_mpu_noncacheable(uint8_t region, uintptr_t base,
+                                        size_t size) {
+  uint32_t regions = (MPU_TYPE >> 8) & 0xFFU;
+  if (region >= regions || size < 32U || (size & (size - 1U)) != 0U ||
+      (base & (size - 1U)) != 0U)
+    return HAL_ERR_INVALID_ARG;
+
+  uint32_t log2 = 0;
+  while ((1UL << log2) < size)
+    log2++;
+
+  /* Flush lines cached under the old attributes; afterwards they would be
+   * neither written back nor hit. */
+  hal_cache_clean_invalidate_range((const void *)base, size);
+
+  _dsb();
+  MPU_CTRL = 0U;
+  MPU_RNR = region;
+  MPU_RBAR = (uint32_t)base;
+  /* TEX=001 C=0 B=0: normal memory, non-cacheable. */
+  MPU_RASR = MPU_RASR_XN | MPU_RASR_AP_FULL | (1U << MPU_RASR_TEX_POS) |
+             ((log2 - 1U) << MPU_RASR_SIZE_POS) | MPU_RASR_ENABLE;
+  MPU_CTRL = MPU_CTRL_PRIVDEFENA | MPU_CTRL_ENABLE;
+  _dsb();
+  _isb();
+  return HAL_OK;
+}
+
+#endif /* _CACHE_ENABLED */
@@ -31,6 +31,7 @@
  * file has.
  */
 
+#include "common/navhal_compiler.h"
 #include "navhal_port_clock.h"
 #include "navhal_port_timer.h"
 #include <stdint.h>
@@ -132,6 +133,9 @@ uint32_t hal_timebase_get_micros(void) {
   return hal_timebase_get_tick() * hal_timebase_get_tick_duration_us();
 }
 
+/** @brief Driver tick hook; a no-op unless a driver defines it (sdio.c). */
+NAVHAL_WEAK void hal_timebase_driver_tick(void) {}
+
 /**
  * @brief Advance the timebase by one tick and run the registered callback.
  *
@@ -143,6 +147,7 @@ uint32_t hal_timebase_get_micros(void) {
  */
 void hal_timebase_tick(void) {
   systick_ticks++;
+  hal_timebase_driver_tick();
   if (timebase_callback)
     timebase_callback();
 }
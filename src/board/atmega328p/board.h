@@ -91,6 +91,12 @@ extern "C" {
 #define BOARD_SPI_BUS  HAL_SPI_0
 #define BOARD_SPI_CS   GPIO_PB02
 
+/* SD card (CONFIG_DRV_SD_SPI) — on the SPI bus, CS on D4 as on the Arduino
+ * Ethernet/SD shields. SPI2X /2 gives 8 MHz once the card is up. */
+#define BOARD_SD_SPI_BUS            HAL_SPI_0
+#define BOARD_SD_SPI_CS             GPIO_PD04
+#define BOARD_SD_SPI_FAST_BAUDRATE  HAL_SPI_BAUDRATE_DIV2
+
 /* On-board oscillator (Hz) — the Arduino Uno uses a 16 MHz crystal. */
 #define BOARD_XTAL_FREQ_HZ  16000000U
 
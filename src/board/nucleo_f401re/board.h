@@ -70,6 +70,12 @@ extern "C" {
 #define BOARD_SPI_BUS  HAL_SPI_1
 #define BOARD_SPI_CS   GPIO_PA04
 
+/* SD card (CONFIG_DRV_SD_SPI) — SPI1 on the Arduino header, CS on D4 (PB5).
+ * At the default 84 MHz APB2, /4 is 21 MHz: under the 25 MHz SPI-mode limit. */
+#define BOARD_SD_SPI_BUS            HAL_SPI_1
+#define BOARD_SD_SPI_CS             GPIO_PB05
+#define BOARD_SD_SPI_FAST_BAUDRATE  HAL_SPI_BAUDRATE_DIV4
+
 /* Arduino-compatible digital headers (CN5/CN9 on the Nucleo-64) */
 #define D0   GPIO_PA03  /**< USART2 RX on the Arduino header. */
 #define D1   GPIO_PA02  /**< USART2 TX on the Arduino header. */
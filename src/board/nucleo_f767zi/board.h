@@ -79,6 +79,13 @@ extern "C" {
 #define BOARD_SPI_BUS  HAL_SPI_1
 #define BOARD_SPI_CS   GPIO_PD14
 
+/* SD card (CONFIG_DRV_SD_SPI) — SPI1 on the Arduino header, CS on D4 (PF14).
+ * At 216 MHz (108 MHz APB2) /8 is 13.5 MHz; /4 would exceed the 25 MHz
+ * SPI-mode limit. */
+#define BOARD_SD_SPI_BUS            HAL_SPI_1
+#define BOARD_SD_SPI_CS             GPIO_PF14
+#define BOARD_SD_SPI_FAST_BAUDRATE  HAL_SPI_BAUDRATE_DIV8
+
 /* Arduino-compatible digital headers (CN7..CN10 on the Nucleo-144) */
 #define D0   GPIO_PG09  /**< USART6 RX on the Arduino header. */
 #define D1   GPIO_PG14  /**< USART6 TX on the Arduino header. */
@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file disk_cache.c
+ * @brief N-way set-associative write-back sector cache over hal_disk_*.
+ *
+ * @details
+ * Pure logic on top of the hal_disk_* backend; compiled into the FatFs glue
+ * when @c CONFIG_DISK_CACHE is enabled. Not thread-safe: like the rest of
+ * the FatFs path it expects a single caller.
+ */
+
+#include "utils/disk_cache.h"
+#include "common/hal_cache.h"
+#include <stddef.h>
+#include <string.h>
+
+#if DISK_CACHE_WAYS == 0 || (DISK_CACHE_SECTORS % DISK_CACHE_WAYS) != 0
+#error "DISK_CACHE_WAYS must divide DISK_CACHE_SECTORS"
+#endif
+#if (DISK_CACHE_SECTOR_SIZE % HAL_CACHE_LINE_SIZE) != 0
+#error "DISK_CACHE_SECTOR_SIZE must be a multiple of HAL_CACHE_LINE_SIZE"
+#endif
+
+#define _SETS (DISK_CACHE_SECTORS / DISK_CACHE_WAYS)
+#define _SS DISK_CACHE_SECTOR_SIZE
+
+typedef struct {
+  hal_disk_lba_t sector; /**< LBA held by the line */
+  uint32_t stamp;        /**< Last access, for LRU within the set */
+  uint8_t pdrv;
+  uint8_t valid;
+  uint8_t dirty;
+} _line_t;
+
+static _line_t _lines[DISK_CACHE_WAYS][_SETS];
+/* Every line owns its cache lines, so it can go straight to DMA;
+ * [way][set] order makes the lines of one way a single contiguous buffer
+ * for run write-back. */
+static uint8_t _data[DISK_CACHE_WAYS][_SETS][HAL_CACHE_ALIGN_UP(_SS)]
+    NAVHAL_DMA_BUFFER;
+static uint32_t _clock;
+static disk_cache_stats_t _stats;
+
+#define _LINE_DATA(way, set) (_data[way][set])
+
+/*---------------------------------------------------------------------------
+ * Internal helpers
+ *---------------------------------------------------------------------------*/
+
+static inline void _touch(_line_t *l) { l->stamp = ++_clock; }
+
+/** @return The way holding (@p pdrv, @p sector), or -1. */
+static int _lookup(uint8_t pdrv, hal_disk_lba_t sector) {
+  uint32_t set = sector % _SETS;
+  for (uint32_t w = 0; w < DISK_CACHE_WAYS; w++) {
+    const _line_t *l = &_lines[w][set];
+    if (l->valid && l->pdrv == pdrv && l->sector == sector)
+      return (int)w;
+  }
+  return -1;
+}
+
+/**
+ * True if @p prev and @p next are both dirty and @p next holds the sector
+ * right after @p prev on the same drive. Both are checked: a run may grow
+ * in either direction, and an empty or clean line must never be written.
+ */
+static inline int _continues(const _line_t *prev, const _line_t *next) {
+  return prev->valid && prev->dirty && next->valid && next->dirty &&
+         next->pdrv == prev->pdrv && next->sector == prev->sector + 1U;
+}
+
+/** Write @p n dirty lines of @p way, starting at @p set, in one request. */
+static hal_disk_result_t _write_run(uint32_t way, uint32_t set, uint32_t n) {
+  const _line_t *first = &_lines[way][set];
+  hal_disk_result_t res =
+      hal_disk_write(first->pdrv, _LINE_DATA(way, set), first->sector, n);
+  if (res != HAL_DISK_RES_OK)
+    return res;
+
+  for (uint32_t i = 0; i < n; i++)
+    _lines[way][set + i].dirty = 0;
+  _stats.writebacks += n;
+  _stats.writeback_ops++;
+  return HAL_DISK_RES_OK;
+}
+
+/** Write back the whole dirty run of @p way that contains @p set. */
+static hal_disk_result_t _write_around(uint32_t way, uint32_t set) {
+  uint32_t first = set;
+  uint32_t last = set;
+  while (first > 0U &&
+         _continues(&_lines[way][first - 1U], &_lines[way][first]))
+    first--;
+  while (last + 1U < _SETS &&
+         _continues(&_lines[way][last], &_lines[way][last + 1U]))
+    last++;
+  return _write_run(way, first, last - first + 1U);
+}
+
+/**
+ * @brief Pick and free a line for (@p pdrv, @p sector).
+ *
+ * Prefers the way that holds the previous sector, so sequential writes build
+ * runs that are contiguous in memory; then an empty way; then the LRU one.
+ * A dirty victim is written back (with its neighbours) first.
+ */
+static hal_disk_result_t _alloc(uint8_t pdrv, hal_disk_lba_t sector,
+                                uint32_t *way) {
+  uint32_t set = sector % _SETS;
+  int victim = -1;
+
+  if (set > 0U) {
+    int prev = _lookup(pdrv, sector - 1U);
+    if (prev >= 0 && !_lines[prev][set].dirty)
+      victim = prev;
+  }
+  for (uint32_t w = 0; victim < 0 && w < DISK_CACHE_WAYS; w++) {
+    if (!_lines[w][set].valid)
+      victim = (int)w;
+  }
+  if (victim < 0) {
+    victim = 0;
+    for (uint32_t w = 1; w < DISK_CACHE_WAYS; w++) {
+      if ((int32_t)(_lines[w][set].stamp - _lines[victim][set].stamp) < 0)
+        victim = (int)w;
+    }
+  }
+
+  _line_t *l = &_lines[victim][set];
+  if (l->valid) {
+    if (l->dirty) {
+      hal_disk_result_t res = _write_around((uint32_t)victim, set);
+      if (res != HAL_DISK_RES_OK)
+        return res;
+    }
+    l->valid = 0;
+    _stats.evictions++;
+  }
+  *way = (uint32_t)victim;
+  return HAL_DISK_RES_OK;
+}
+
+static void _fill(uint32_t way, uint8_t pdrv, hal_disk_lba_t sector,
+                  uint8_t dirty) {
+  _line_t *l = &_lines[way][sector % _SETS];
+  l->pdrv = pdrv;
+  l->sector = sector;
+  l->valid = 1;
+  l->dirty = dirty;
+  _touch(l);
+}
+
+/*---------------------------------------------------------------------------
+ * Public API
+ *---------------------------------------------------------------------------*/
+
+hal_disk_result_t disk_cache_read(uint8_t pdrv, uint8_t *buff,
+                                  hal_disk_lba_t sector, uint32_t count) {
+  if (buff == NULL || count == 0U)
+    return HAL_DISK_RES_PARERR;
+
+  if (count == 1U) {
+    uint32_t set = sector % _SETS;
+    int hit = _lookup(pdrv, sector);
+    if (hit >= 0) {
+      _touch(&_lines[hit][set]);
+      memcpy(buff, _LINE_DATA(hit, set), _SS);
+      _stats.hits++;
+      return HAL_DISK_RES_OK;
+    }
+
+    _stats.misses++;
+    uint32_t way;
+    hal_disk_result_t res = _alloc(pdrv, sector, &way);
+    if (res != HAL_DISK_RES_OK)
+      return res;
+    res = hal_disk_read(pdrv, _LINE_DATA(way, set), sector, 1);
+    if (res != HAL_DISK_RES_OK)
+      return res;
+    _fill(way, pdrv, sector, 0);
+    memcpy(buff, _LINE_DATA(way, set), _SS);
+    return HAL_DISK_RES_OK;
+  }
+
+  /* Fully cached ranges are served from RAM like single sectors. */
+  if (count <= DISK_CACHE_SECTORS) {
+    uint32_t i = 0;
+    while (i < count && _lookup(pdrv, sector + i) >= 0)
+      i++;
+    if (i == count) {
+      for (i = 0; i < count; i++) {
+        uint32_t set = (sector + i) % _SETS;
+        int w = _lookup(pdrv, sector + i);
+        _touch(&_lines[w][set]);
+        memcpy(buff + i * _SS, _LINE_DATA(w, set), _SS);
+      }
+      _stats.hits += count;
+      return HAL_DISK_RES_OK;
+    }
+  }
+
+  hal_disk_result_t res = hal_disk_read(pdrv, buff, sector, count);
+  if (res != HAL_DISK_RES_OK)
+    return res;
+  _stats.bypassed += count;
+
+  /* Sectors still dirty in the cache are newer than what the disk returned. */
+  for (uint32_t w = 0; w < DISK_CACHE_WAYS; w++) {
+    for (uint32_t s = 0; s < _SETS; s++) {
+      const _line_t *l = &_lines[w][s];
+      if (l->valid && l->dirty && l->pdrv == pdrv && l->sector >= sector &&
+          l->sector - sector < count)
+        memcpy(buff + (l->sector - sector) * _SS, _LINE_DATA(w, s), _SS);
+    }
+  }
+  return HAL_DISK_RES_OK;
+}
+
+hal_disk_result_t disk_cache_write(uint8_t pdrv, const uint8_t *buff,
+                                   hal_disk_lba_t sector, uint32_t count) {
+  if (buff == NULL || count == 0U)
+    return HAL_DISK_RES_PARERR;
+
+  if (count == 1U) {
+    uint32_t set = sector % _SETS;
+    int hit = _lookup(pdrv, sector);
+    uint32_t way;
+    if (hit >= 0) {
+      way = (uint32_t)hit;
+      _stats.hits++;
+    } else {
+      _stats.misses++;
+      hal_disk_result_t res = _alloc(pdrv, sector, &way);
+      if (res != HAL_DISK_RES_OK)
+        return res;
+    }
+    /* Whole-sector write: no need to fetch the old contents. */
+    memcpy(_LINE_DATA(way, set), buff, _SS);
+    _fill(way, pdrv, sector, 1);
+    return HAL_DISK_RES_OK;
+  }
+
+  hal_disk_result_t res = hal_disk_write(pdrv, buff, sector, count);
+  if (res != HAL_DISK_RES_OK)
+    return res;
+  _stats.bypassed += count;
+
+  /* The disk now holds the newest data: refresh cached copies as clean. */
+  for (uint32_t w = 0; w < DISK_CACHE_WAYS; w++) {
+    for (uint32_t s = 0; s < _SETS; s++) {
+      _line_t *l = &_lines[w][s];
+      if (l->valid && l->pdrv == pdrv && l->sector >= sector &&
+          l->sector - sector < count) {
+        memcpy(_LINE_DATA(w, s), buff + (l->sector - sector) * _SS, _SS);
+        l->dirty = 0;
+      }
+    }
+  }
+  return HAL_DISK_RES_OK;
+}
+
+hal_disk_result_t disk_cache_sync(uint8_t pdrv) {
+  for (uint32_t w = 0; w < DISK_CACHE_WAYS; w++) {
+    uint32_t s = 0;
+    while (s < _SETS) {
+      const _line_t *l = &_lines[w][s];
+      if (!(l->valid && l->dirty && l->pdrv == pdrv)) {
+        s++;
+        continue;
+      }
+      uint32_t n = 1;
+      while (s + n < _SETS &&
+             _continues(&_lines[w][s + n - 1U], &_lines[w][s + n]))
+        n++;
+      hal_disk_result_t res = _write_run(w, s, n);
+      if (res != HAL_DISK_RES_OK)
+        return res;
+      s += n;
+    }
+  }
+  return HAL_DISK_RES_OK;
+}
+
+void disk_cache_discard(uint8_t pdrv, hal_disk_lba_t sector, uint32_t count) {
+  for (uint32_t w = 0; w < DISK_CACHE_WAYS; w++) {
+    for (uint32_t s = 0; s < _SETS; s++) {
+      _line_t *l = &_lines[w][s];
+      if (l->valid && l->pdrv == pdrv && l->sector >= sector &&
+          l->sector - sector < count) {
+        l->valid = 0;
+        l->dirty = 0;
+      }
+    }
+  }
+}
+
+void disk_cache_invalidate(uint8_t pdrv) {
+  for (uint32_t w = 0; w < DISK_CACHE_WAYS; w++) {
+    for (uint32_t s = 0; s < _SETS; s++) {
+      _line_t *l = &_lines[w][s];
+      if (l->pdrv == pdrv) {
+        l->valid = 0;
+        l->dirty = 0;
+      }
+    }
+  }
+}
+
+void disk_cache_get_stats(disk_cache_stats_t *stats) {
+  if (stats != NULL)
+    *stats = _stats;
+}
+
+void disk_cache_reset_stats(void) { memset(&_stats, 0, sizeof(_stats)); }
@@ -18,27 +18,82 @@
 /**
  * @file diskio.c
  * @brief Glue code between FatFS and NavHAL hal_diskio.
+ *
+ * @details
+ * With @c CONFIG_DISK_CACHE the sector traffic goes through the write-back
+ * cache in utils/disk_cache.h; @c CTRL_SYNC then flushes it before the
+ * backend sync. With @c CONFIG_DRV_RAM_DISK, drive ::RAM_DISK_PDRV goes to
+ * utils/ram_disk.h instead, uncached.
+ *
+ * Without the cache, writes from the range set with disk_write_behind() are
+ * handed to the backend as ::HAL_DISK_IO_WRITE_ASYNC where it supports it.
+ * The backend waits for such a write before its next call, so the glue
+ * only has to remember which buffer is still in flight until then.
  */
 
+#include "ff.h" /* LBA_t */
 #include "diskio.h"
 #include "common/hal_diskio.h"
+#include "navhal_port_config.h"
+#include "utils/ram_disk.h" /* RAM_DISK */
+
+#if defined(NAVHAL_CONFIG_DISK_CACHE) && NAVHAL_CONFIG_DISK_CACHE
+#include "utils/disk_cache.h"
+#define _disk_read disk_cache_read
+#define _disk_write disk_cache_write
+#else
+#define _disk_read hal_disk_read
+#define _disk_write hal_disk_write
+#define _WRITE_BEHIND 1
+#endif
+
+#if FF_LBA64 && !HAL_DISK_LBA64
+#error "FF_LBA64 needs 64-bit hal_disk sectors (CONFIG_DISK_LBA64)"
+#endif
+
+#ifdef _WRITE_BEHIND
+static const uint8_t *wb_lo, *wb_hi;     /* May be written behind */
+static const uint8_t *busy_lo, *busy_hi; /* In flight on busy_pdrv */
+static uint8_t busy_pdrv;
+
+/* Any backend call on the drive waits for the write in flight. */
+static void wb_settled(uint8_t pdrv) {
+  if (pdrv == busy_pdrv)
+    busy_lo = busy_hi = 0;
+}
+#else
+#define wb_settled(pdrv) ((void)0)
+#endif
+
+void disk_write_behind(const void *buff, uint32_t len) {
+#ifdef _WRITE_BEHIND
+  wb_lo = (const uint8_t *)buff;
+  wb_hi = len ? wb_lo + len : wb_lo;
+#else
+  (void)buff;
+  (void)len;
+#endif
+}
 
-DSTATUS disk_status(uint8_t pdrv) {
-  hal_disk_status_t status = hal_disk_status(pdrv);
-  DSTATUS dstat = 0;
-
-  if (status & HAL_DISK_STATUS_NOINIT)
-    dstat |= STA_NOINIT;
-  if (status & HAL_DISK_STATUS_NODISK)
-    dstat |= STA_NODISK;
-  if (status & HAL_DISK_STATUS_PROTECT)
-    dstat |= STA_PROTECT;
-
-  return dstat;
+DRESULT disk_write_release(uint8_t pdrv, const void *buff, uint32_t len) {
+#ifdef _WRITE_BEHIND
+  const uint8_t *lo = (const uint8_t *)buff;
+  if (pdrv != busy_pdrv || busy_lo == busy_hi || lo >= busy_hi ||
+      busy_lo >= lo + len)
+    return RES_OK;
+  hal_disk_async_write_t wait = {0, 0, 0};
+  hal_disk_result_t res = hal_disk_ioctl(pdrv, HAL_DISK_IO_WRITE_ASYNC, &wait);
+  wb_settled(pdrv);
+  return res == HAL_DISK_RES_OK ? RES_OK : RES_ERROR;
+#else
+  (void)pdrv;
+  (void)buff;
+  (void)len;
+  return RES_OK;
+#endif
 }
 
-DSTATUS disk_initialize(uint8_t pdrv) {
-  hal_disk_status_t status = hal_disk_initialize(pdrv);
+static DSTATUS to_dstatus(hal_disk_status_t status) {
   DSTATUS dstat = 0;
 
   if (status & HAL_DISK_STATUS_NOINIT)
@@ -51,10 +106,7 @@ DSTATUS disk_initialize(uint8_t pdrv) {
   return dstat;
 }
 
-DRESULT disk_read(uint8_t pdrv, uint8_t *buff, uint32_t sector,
-                  uint32_t count) {
-  hal_disk_result_t res = hal_disk_read(pdrv, buff, sector, count);
-
+static DRESULT to_dresult(hal_disk_result_t res) {
   switch (res) {
   case HAL_DISK_RES_OK:
     return RES_OK;
@@ -71,24 +123,73 @@ DRESULT disk_read(uint8_t pdrv, uint8_t *buff, uint32_t sector,
   }
 }
 
-DRESULT disk_write(uint8_t pdrv, const uint8_t *buff, uint32_t sector,
-                   uint32_t count) {
-  hal_disk_result_t res = hal_disk_write(pdrv, buff, sector, count);
+/* hal_disk_ioctl, or the RAM disk's for its drive. */
+static hal_disk_result_t _disk_ioctl(uint8_t pdrv, uint8_t cmd, void *buff) {
+#if RAM_DISK
+  if (pdrv == RAM_DISK_PDRV)
+    return ram_disk_ioctl(cmd, buff);
+#endif
+  hal_disk_result_t res = hal_disk_ioctl(pdrv, cmd, buff);
+  wb_settled(pdrv);
+  return res;
+}
 
-  switch (res) {
-  case HAL_DISK_RES_OK:
-    return RES_OK;
-  case HAL_DISK_RES_ERROR:
-    return RES_ERROR;
-  case HAL_DISK_RES_WRPRT:
-    return RES_WRPRT;
-  case HAL_DISK_RES_NOTRDY:
-    return RES_NOTRDY;
-  case HAL_DISK_RES_PARERR:
-    return RES_PARERR;
-  default:
-    return RES_ERROR;
+DSTATUS disk_status(uint8_t pdrv) {
+#if RAM_DISK
+  if (pdrv == RAM_DISK_PDRV)
+    return to_dstatus(ram_disk_status());
+#endif
+  return to_dstatus(hal_disk_status(pdrv));
+}
+
+DSTATUS disk_initialize(uint8_t pdrv) {
+#if RAM_DISK
+  if (pdrv == RAM_DISK_PDRV)
+    return to_dstatus(ram_disk_initialize());
+#endif
+  hal_disk_status_t status = hal_disk_initialize(pdrv);
+  wb_settled(pdrv);
+
+#if defined(NAVHAL_CONFIG_DISK_CACHE) && NAVHAL_CONFIG_DISK_CACHE
+  /* (Re)initialising may mean a different card: forget what we held. */
+  disk_cache_invalidate(pdrv);
+#endif
+
+  return to_dstatus(status);
+}
+
+DRESULT disk_read(uint8_t pdrv, uint8_t *buff, LBA_t sector, uint32_t count) {
+#if RAM_DISK
+  if (pdrv == RAM_DISK_PDRV)
+    return to_dresult(ram_disk_read(buff, sector, count));
+#endif
+  hal_disk_result_t res = _disk_read(pdrv, buff, sector, count);
+  wb_settled(pdrv);
+  return to_dresult(res);
+}
+
+DRESULT disk_write(uint8_t pdrv, const uint8_t *buff, LBA_t sector,
+                   uint32_t count) {
+  hal_disk_result_t res;
+#if RAM_DISK
+  if (pdrv == RAM_DISK_PDRV)
+    return to_dresult(ram_disk_write(buff, sector, count));
+#endif
+#ifdef _WRITE_BEHIND
+  if (buff >= wb_lo && buff < wb_hi) {
+    hal_disk_async_write_t w = {buff, sector, count};
+    res = hal_disk_ioctl(pdrv, HAL_DISK_IO_WRITE_ASYNC, &w);
+    if (res != HAL_DISK_RES_PARERR) {
+      busy_pdrv = pdrv;
+      busy_lo = buff;
+      busy_hi = res == HAL_DISK_RES_OK ? buff + count * 512U : buff;
+      return res == HAL_DISK_RES_OK ? RES_OK : RES_ERROR;
+    }
   }
+#endif
+  res = _disk_write(pdrv, buff, sector, count);
+  wb_settled(pdrv);
+  return to_dresult(res);
 }
 
 DRESULT disk_ioctl(uint8_t pdrv, uint8_t cmd, void *buff) {
@@ -97,22 +198,49 @@ DRESULT disk_ioctl(uint8_t pdrv, uint8_t cmd, void *buff) {
 
   switch (cmd) {
   case CTRL_SYNC:
+#if defined(NAVHAL_CONFIG_DISK_CACHE) && NAVHAL_CONFIG_DISK_CACHE
+    if (disk_cache_sync(pdrv) != HAL_DISK_RES_OK)
+      return RES_ERROR;
+#endif
     hal_cmd = HAL_DISK_IO_SYNC;
     break;
-  case GET_SECTOR_COUNT:
-    hal_cmd = HAL_DISK_IO_GET_SECTOR_COUNT;
-    break;
+  case GET_SECTOR_COUNT: {
+    /* LBA_t may be narrower than the HAL's sector type: a medium too large
+     * for it is used up to the last sector FatFs can address. */
+    hal_disk_lba_t count;
+    res = _disk_ioctl(pdrv, HAL_DISK_IO_GET_SECTOR_COUNT, &count);
+    if (res != HAL_DISK_RES_OK)
+      return RES_ERROR;
+#if HAL_DISK_LBA64 && !FF_LBA64
+    if (count > (LBA_t)-1)
+      count = (LBA_t)-1;
+#endif
+    *(LBA_t *)buff = (LBA_t)count;
+    return RES_OK;
+  }
   case GET_SECTOR_SIZE:
     hal_cmd = HAL_DISK_IO_GET_SECTOR_SIZE;
     break;
   case GET_BLOCK_SIZE:
     hal_cmd = HAL_DISK_IO_GET_BLOCK_SIZE;
     break;
+  case CTRL_TRIM: {
+    /* FatFs passes LBA_t[2]; the HAL takes hal_disk_lba_t[2]. */
+    const LBA_t *lba = (const LBA_t *)buff;
+    hal_disk_lba_t range[2] = {lba[0], lba[1]};
+#if defined(NAVHAL_CONFIG_DISK_CACHE) && NAVHAL_CONFIG_DISK_CACHE
+    /* Cached copies of freed sectors must neither be written back over
+     * the erase nor served afterwards. */
+    disk_cache_discard(pdrv, range[0], range[1] - range[0] + 1);
+#endif
+    res = _disk_ioctl(pdrv, HAL_DISK_IO_TRIM, range);
+    return (res == HAL_DISK_RES_OK) ? RES_OK : RES_ERROR;
+  }
   default:
     return RES_PARERR;
   }
 
-  res = hal_disk_ioctl(pdrv, hal_cmd, buff);
+  res = _disk_ioctl(pdrv, hal_cmd, buff);
   return (res == HAL_DISK_RES_OK) ? RES_OK : RES_ERROR;
 }
 
@@ -26,6 +26,7 @@
 extern "C" {
 #endif
 
+#include "ff.h" /* LBA_t */
 #include <stdint.h>
 
 /* Status of Disk Functions */
@@ -45,11 +46,18 @@ typedef enum {
 
 DSTATUS disk_status(uint8_t pdrv);
 DSTATUS disk_initialize(uint8_t pdrv);
-DRESULT disk_read(uint8_t pdrv, uint8_t *buff, uint32_t sector, uint32_t count);
-DRESULT disk_write(uint8_t pdrv, const uint8_t *buff, uint32_t sector,
+DRESULT disk_read(uint8_t pdrv, uint8_t *buff, LBA_t sector, uint32_t count);
+DRESULT disk_write(uint8_t pdrv, const uint8_t *buff, LBA_t sector,
                    uint32_t count);
 DRESULT disk_ioctl(uint8_t pdrv, uint8_t cmd, void *buff);
 
+/* NavHAL write-behind (HAL_DISK_IO_WRITE_ASYNC) for the v_fs write buffers:
+ * while [buff, buff + len) is set, disk_write() of data inside it may return
+ * before the transfer ends; disk_write_release() waits until none is in
+ * flight from the given range. len 0 turns write-behind off. */
+void disk_write_behind(const void *buff, uint32_t len);
+DRESULT disk_write_release(uint8_t pdrv, const void *buff, uint32_t len);
+
 /* Disk Status Bits (DSTATUS) */
 
 #define STA_NOINIT 0x01  /* Drive not initialized */
@@ -21,6 +21,8 @@
 
 #define FFCONF_DEF 80286 /* Revision ID */
 
+#include "navhal_target.h" /* NAVHAL_CONFIG_* for the options below */
+
 /*---------------------------------------------------------------------------/
 / Function Configurations
 /---------------------------------------------------------------------------*/
@@ -47,7 +49,16 @@
 #define FF_USE_MKFS 1
 /* This option switches f_mkfs() function. (0:Disable or 1:Enable) */
 
+/* NavHAL: CONFIG_VFS_FASTSEEK, or a V_FS_FASTSEEK=1 build flag (v_fs' cluster
+ * link maps need it); a -DFF_USE_FASTSEEK=n build flag overrides both. */
+#ifndef FF_USE_FASTSEEK
+#if (defined(NAVHAL_CONFIG_VFS_FASTSEEK) && NAVHAL_CONFIG_VFS_FASTSEEK) ||     \
+    (defined(V_FS_FASTSEEK) && V_FS_FASTSEEK)
+#define FF_USE_FASTSEEK 1
+#else
 #define FF_USE_FASTSEEK 0
+#endif
+#endif
 /* This option switches fast seek function. (0:Disable or 1:Enable) */
 
 #define FF_USE_EXPAND 1
@@ -121,7 +132,19 @@ functions.
 /     0 - Include all code pages above and configured by f_setcp()
 */
 
+/* NavHAL: CONFIG_VFS_LFN, with CONFIG_VFS_LFN_STACK for mode 2; a
+ * -DFF_USE_LFN=n build flag overrides it. Code page 437 only (ffunicode.c). */
+#ifndef FF_USE_LFN
+#if defined(NAVHAL_CONFIG_VFS_LFN) && NAVHAL_CONFIG_VFS_LFN
+#if defined(NAVHAL_CONFIG_VFS_LFN_STACK) && NAVHAL_CONFIG_VFS_LFN_STACK
+#define FF_USE_LFN 2
+#else
+#define FF_USE_LFN 1
+#endif
+#else
 #define FF_USE_LFN 0
+#endif
+#endif
 #define FF_MAX_LFN 255
 /* The FF_USE_LFN switches the support for LFN (long file name).
 /
@@ -205,7 +228,14 @@ flash memory and some /  type of optical media. When FF_MAX_SS is larger than
 FF_MIN_SS, FatFs is configured /  for variable sector size mode and disk_ioctl()
 function needs to implement /  GET_SECTOR_SIZE command. */
 
+/* NavHAL: CONFIG_DISK_LBA64; a -DFF_LBA64=n build flag overrides it. */
+#ifndef FF_LBA64
+#if defined(NAVHAL_CONFIG_DISK_LBA64) && NAVHAL_CONFIG_DISK_LBA64
+#define FF_LBA64 1
+#else
 #define FF_LBA64 0
+#endif
+#endif
 /* This option switches support for 64-bit LBA. (0:Disable or 1:Enable)
 /  To enable the 64-bit LBA, also exFAT needs to be enabled. (FF_FS_EXFAT == 1)
 */
@@ -215,7 +245,7 @@ function needs to implement /  GET_SECTOR_SIZE command. */
 /  f_fdisk function. 0x100000000 max. This option has no effect when FF_LBA64 ==
 0. */
 
-#define FF_USE_TRIM 0
+#define FF_USE_TRIM 1
 /* This option switches support for ATA-TRIM. (0:Disable or 1:Enable)
 /  To enable Trim function, also CTRL_TRIM command should be implemented to the
 /  disk_ioctl() function. */
@@ -224,14 +254,28 @@ function needs to implement /  GET_SECTOR_SIZE command. */
 / System Configurations
 /---------------------------------------------------------------------------*/
 
+/* NavHAL: CONFIG_VFS_TINY; a -DFF_FS_TINY=n build flag overrides it. */
+#ifndef FF_FS_TINY
+#if defined(NAVHAL_CONFIG_VFS_TINY) && NAVHAL_CONFIG_VFS_TINY
+#define FF_FS_TINY 1
+#else
 #define FF_FS_TINY 0
+#endif
+#endif
 /* This option switches tiny buffer configuration. (0:Normal or 1:Tiny)
 /  At the tiny configuration, size of file object (FIL) is shrinked FF_MAX_SS
 bytes. /  Instead of private sector buffer eliminated from the file object,
 common sector /  buffer in the filesystem object (FATFS) is used for the file
 data transfer. */
 
+/* NavHAL: CONFIG_VFS_EXFAT; a -DFF_FS_EXFAT=n build flag overrides it. */
+#ifndef FF_FS_EXFAT
+#if defined(NAVHAL_CONFIG_VFS_EXFAT) && NAVHAL_CONFIG_VFS_EXFAT
+#define FF_FS_EXFAT 1
+#else
 #define FF_FS_EXFAT 0
+#endif
+#endif
 /* This option switches support for exFAT filesystem. (0:Disable or 1:Enable)
 /  To enable exFAT, also LFN needs to be enabled. (FF_USE_LFN >= 1)
 /  Note that enabling exFAT discards ANSI C (C89) compatibility. */
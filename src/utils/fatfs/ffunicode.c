@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file ffunicode.c
+ * @brief Unicode support functions FatFs needs for long file names.
+ *
+ * @details
+ * A reduced stand-in for ChaN's ffunicode.c, sized for a microcontroller:
+ * only the OEM code page selected in ffconf.h (437) is converted, and the
+ * upper-case table covers Latin-1, Latin Extended-A, Greek, Cyrillic and
+ * the full-width Latin letters — enough for the case-insensitive name
+ * matching FatFs does. Other characters compare as themselves. Compiled to
+ * nothing without @c FF_USE_LFN.
+ */
+
+#include "ff.h"
+
+#if FF_USE_LFN
+
+#if FF_CODE_PAGE != 437
+#error "ffunicode.c only provides code page 437"
+#endif
+
+/* CP437 0x80..0xFF to Unicode. */
+static const WCHAR uc437[128] = {
+    0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00E4, 0x00E0, 0x00E5, 0x00E7,
+    0x00EA, 0x00EB, 0x00E8, 0x00EF, 0x00EE, 0x00EC, 0x00C4, 0x00C5,
+    0x00C9, 0x00E6, 0x00C6, 0x00F4, 0x00F6, 0x00F2, 0x00FB, 0x00F9,
+    0x00FF, 0x00D6, 0x00DC, 0x00A2, 0x00A3, 0x00A5, 0x20A7, 0x0192,
+    0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x00F1, 0x00D1, 0x00AA, 0x00BA,
+    0x00BF, 0x2310, 0x00AC, 0x00BD, 0x00BC, 0x00A1, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x2561, 0x2562, 0x2556,
+    0x2555, 0x2563, 0x2551, 0x2557, 0x255D, 0x255C, 0x255B, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x255E, 0x255F,
+    0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x2567,
+    0x2568, 0x2564, 0x2565, 0x2559, 0x2558, 0x2552, 0x2553, 0x256B,
+    0x256A, 0x2518, 0x250C, 0x2588, 0x2584, 0x258C, 0x2590, 0x2580,
+    0x03B1, 0x00DF, 0x0393, 0x03C0, 0x03A3, 0x03C3, 0x00B5, 0x03C4,
+    0x03A6, 0x0398, 0x03A9, 0x03B4, 0x221E, 0x03C6, 0x03B5, 0x2229,
+    0x2261, 0x00B1, 0x2265, 0x2264, 0x2320, 0x2321, 0x00F7, 0x2248,
+    0x00B0, 0x2219, 0x00B7, 0x221A, 0x207F, 0x00B2, 0x25A0, 0x00A0};
+
+WCHAR ff_oem2uni(WCHAR oem, WORD cp) {
+  if (oem < 0x80)
+    return oem;
+  if (cp != FF_CODE_PAGE || oem > 0xFF)
+    return 0;
+  return uc437[oem - 0x80];
+}
+
+WCHAR ff_uni2oem(DWORD uni, WORD cp) {
+  if (uni < 0x80)
+    return (WCHAR)uni;
+  if (cp != FF_CODE_PAGE || uni >= 0x10000)
+    return 0;
+  for (WCHAR c = 0; c < 128; c++)
+    if (uc437[c] == uni)
+      return (WCHAR)(c + 0x80);
+  return 0;
+}
+
+DWORD ff_wtoupper(DWORD uni) {
+  if (uni < 0x80)
+    return (uni >= 'a' && uni <= 'z') ? uni - 0x20 : uni;
+  if (uni < 0x100) { /* Latin-1 */
+    if (uni == 0xFF)
+      return 0x178;
+    if (uni == 0xB5)
+      return 0x39C;
+    return (uni >= 0xE0 && uni != 0xF7) ? uni - 0x20 : uni;
+  }
+  if (uni < 0x180) { /* Latin Extended-A: mostly upper/lower pairs */
+    if (uni == 0x131 || uni == 0x138 || uni == 0x149 || uni == 0x17F)
+      return uni; /* dotless i, kra, 'n, long s: no pair */
+    if ((uni >= 0x139 && uni <= 0x148) || (uni >= 0x179 && uni <= 0x17E))
+      return (uni & 1) ? uni : uni - 1; /* Pairs start on odd points */
+    return (uni & 1) ? uni - 1 : uni;
+  }
+  if (uni >= 0x3B1 && uni <= 0x3CB && uni != 0x3C2) /* Greek */
+    return uni - 0x20;
+  if (uni >= 0x430 && uni <= 0x44F) /* Cyrillic */
+    return uni - 0x20;
+  if (uni >= 0x450 && uni <= 0x45F)
+    return uni - 0x50;
+  if (uni >= 0xFF41 && uni <= 0xFF5A) /* Full-width Latin */
+    return uni - 0x20;
+  return uni;
+}
+
+#endif /* FF_USE_LFN */
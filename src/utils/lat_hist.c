@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file lat_hist.c
+ * @brief Log-scale latency histogram.
+ *
+ * @details
+ * Pure logic, no hardware access. Adding a sample is a handful of shifts
+ * and compares, cheap enough to sit between two cycle-counter reads.
+ */
+
+#include "utils/lat_hist.h"
+#include <stddef.h>
+
+void lat_hist_reset(lat_hist_t *h) {
+  if (h == NULL)
+    return;
+  h->count = 0;
+  h->min = 0;
+  h->max = 0;
+  h->sum = 0;
+  for (uint8_t b = 0; b < LAT_HIST_BUCKETS; b++)
+    h->bucket[b] = 0;
+}
+
+uint8_t lat_hist_bucket(uint32_t value) {
+  /* Bit length of value, by halving; no CLZ on every port. */
+  uint8_t b = 0;
+  if (value >= (1UL << 16)) {
+    value >>= 16;
+    b += 16;
+  }
+  if (value >= (1UL << 8)) {
+    value >>= 8;
+    b += 8;
+  }
+  if (value >= (1UL << 4)) {
+    value >>= 4;
+    b += 4;
+  }
+  if (value >= (1UL << 2)) {
+    value >>= 2;
+    b += 2;
+  }
+  if (value >= (1UL << 1)) {
+    value >>= 1;
+    b += 1;
+  }
+  return (uint8_t)(b + value);
+}
+
+uint32_t lat_hist_bucket_max(uint8_t b) {
+  if (b == 0)
+    return 0;
+  if (b >= 32)
+    return 0xFFFFFFFFUL;
+  return (1UL << b) - 1U;
+}
+
+void lat_hist_add(lat_hist_t *h, uint32_t value) {
+  if (h == NULL)
+    return;
+  if (h->count == 0 || value < h->min)
+    h->min = value;
+  if (value > h->max)
+    h->max = value;
+  h->count++;
+  h->sum += value;
+  h->bucket[lat_hist_bucket(value)]++;
+}
+
+uint32_t lat_hist_percentile(const lat_hist_t *h, uint16_t permille) {
+  if (h == NULL || h->count == 0)
+    return 0;
+  if (permille > 1000U)
+    permille = 1000U;
+
+  /* 1-based rank of the sample sought: ceil(count * permille / 1000). */
+  uint32_t rank =
+      (uint32_t)(((uint64_t)h->count * permille + 999U) / 1000U);
+  if (rank == 0)
+    return h->min;
+
+  uint32_t seen = 0;
+  for (uint8_t b = 0; b < LAT_HIST_BUCKETS; b++) {
+    seen += h->bucket[b];
+    if (seen >= rank) {
+      uint32_t v = lat_hist_bucket_max(b);
+      if (v < h->min)
+        return h->min;
+      return v > h->max ? h->max : v;
+    }
+  }
+  return h->max;
+}
+
+void lat_hist_merge(lat_hist_t *dst, const lat_hist_t *src) {
+  if (dst == NULL || src == NULL || src->count == 0)
+    return;
+  if (dst->count == 0 || src->min < dst->min)
+    dst->min = src->min;
+  if (src->max > dst->max)
+    dst->max = src->max;
+  dst->count += src->count;
+  dst->sum += src->sum;
+  for (uint8_t b = 0; b < LAT_HIST_BUCKETS; b++)
+    dst->bucket[b] += src->bucket[b];
+}
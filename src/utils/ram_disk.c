@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file ram_disk.c
+ * @brief Block device in RAM, served to FatFs as an extra physical drive.
+ *
+ * @details
+ * Pure memcpy over the attached region; compiled in with
+ * @c CONFIG_DRV_RAM_DISK. Like the rest of the FatFs path it expects a
+ * single caller.
+ */
+
+#include "utils/ram_disk.h"
+#include <stddef.h>
+#include <string.h>
+
+#define _SS 512U
+
+#if RAM_DISK_PDRV < 1 || RAM_DISK_PDRV > 9
+#error "RAM_DISK_PDRV must be 1..9: drive 0 is the hal_disk backend's"
+#endif
+
+#if RAM_DISK_BASE == 0
+static uint32_t _mem[RAM_DISK_SECTORS * (_SS / 4U)];
+#define _DEFAULT_BASE ((uint8_t *)_mem)
+#else
+#define _DEFAULT_BASE ((uint8_t *)(uintptr_t)RAM_DISK_BASE)
+#endif
+
+static uint8_t *_base = _DEFAULT_BASE;
+static uint32_t _sectors = RAM_DISK_SECTORS;
+static hal_disk_status_t _stat = HAL_DISK_STATUS_NOINIT;
+static ram_disk_stats_t _stats;
+
+/** True if [@p sector, @p sector + @p count) lies on the disk. */
+static int _in_range(hal_disk_lba_t sector, uint32_t count) {
+  return count != 0U && sector < _sectors && count <= _sectors - sector;
+}
+
+hal_disk_result_t ram_disk_attach(void *base, uint32_t sectors) {
+  if (base == NULL || sectors == 0U)
+    return HAL_DISK_RES_PARERR;
+  _base = (uint8_t *)base;
+  _sectors = sectors;
+  _stat = HAL_DISK_STATUS_NOINIT;
+  return HAL_DISK_RES_OK;
+}
+
+hal_disk_status_t ram_disk_initialize(void) {
+  _stat = HAL_DISK_STATUS_OK;
+  return _stat;
+}
+
+hal_disk_status_t ram_disk_status(void) { return _stat; }
+
+hal_disk_result_t ram_disk_read(uint8_t *buff, hal_disk_lba_t sector,
+                                uint32_t count) {
+  if (buff == NULL || !_in_range(sector, count))
+    return HAL_DISK_RES_PARERR;
+  if (_stat & HAL_DISK_STATUS_NOINIT)
+    return HAL_DISK_RES_NOTRDY;
+  memcpy(buff, _base + (size_t)sector * _SS, (size_t)count * _SS);
+  _stats.read_ops++;
+  _stats.sectors_read += count;
+  return HAL_DISK_RES_OK;
+}
+
+hal_disk_result_t ram_disk_write(const uint8_t *buff, hal_disk_lba_t sector,
+                                 uint32_t count) {
+  if (buff == NULL || !_in_range(sector, count))
+    return HAL_DISK_RES_PARERR;
+  if (_stat & HAL_DISK_STATUS_NOINIT)
+    return HAL_DISK_RES_NOTRDY;
+  memcpy(_base + (size_t)sector * _SS, buff, (size_t)count * _SS);
+  _stats.write_ops++;
+  _stats.sectors_written += count;
+  return HAL_DISK_RES_OK;
+}
+
+hal_disk_result_t ram_disk_ioctl(uint8_t cmd, void *buff) {
+  if (_stat & HAL_DISK_STATUS_NOINIT)
+    return HAL_DISK_RES_NOTRDY;
+
+  switch (cmd) {
+  case HAL_DISK_IO_SYNC:
+    return HAL_DISK_RES_OK;
+  case HAL_DISK_IO_GET_SECTOR_COUNT:
+    *((hal_disk_lba_t *)buff) = _sectors;
+    return HAL_DISK_RES_OK;
+  case HAL_DISK_IO_GET_SECTOR_SIZE:
+    *((uint16_t *)buff) = _SS;
+    return HAL_DISK_RES_OK;
+  case HAL_DISK_IO_GET_BLOCK_SIZE:
+    *((uint32_t *)buff) = 1U; /* No erase blocks to align to */
+    return HAL_DISK_RES_OK;
+  case HAL_DISK_IO_TRIM:
+    return HAL_DISK_RES_OK;
+  default:
+    return HAL_DISK_RES_PARERR;
+  }
+}
+
+void ram_disk_get_stats(ram_disk_stats_t *stats) {
+  if (stats != NULL)
+    *stats = _stats;
+}
+
+void ram_disk_reset_stats(void) { memset(&_stats, 0, sizeof(_stats)); }
@@ -0,0 +1,509 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file sd_spi.c
+ * @brief SD card in SPI mode as the hal_disk_* block device.
+ *
+ * @details
+ * Every command is sent with the card freshly selected and ready (DO high),
+ * so a write's programming time is waited out lazily by whatever comes
+ * next — the following command, or a CTRL_SYNC. Single bytes go through
+ * hal_spi_transmit_receive; data blocks use hal_spi_receive (which clocks
+ * out 0xFF, as the card needs on DI while it sends) and hal_spi_transmit.
+ */
+
+#include "utils/sd_spi.h"
+#include "utils/sd_card.h"
+#include "board.h"
+#include "common/hal_gpio.h"
+#include "common/hal_spi.h"
+#include "common/hal_timer.h"
+#include "navhal_port_config.h"
+#include <stddef.h>
+
+#ifndef SD_SPI_BUS
+#define SD_SPI_BUS BOARD_SD_SPI_BUS
+#endif
+#ifndef SD_SPI_CS
+#define SD_SPI_CS BOARD_SD_SPI_CS
+#endif
+/* Post-init clock. The handshake always runs at DIV256, which is within
+ * the 100-400 kHz identification range on every supported board. */
+#ifndef SD_SPI_FAST_BAUDRATE
+#ifdef BOARD_SD_SPI_FAST_BAUDRATE
+#define SD_SPI_FAST_BAUDRATE BOARD_SD_SPI_FAST_BAUDRATE
+#else
+#define SD_SPI_FAST_BAUDRATE HAL_SPI_BAUDRATE_DIV8
+#endif
+#endif
+#ifndef SD_SPI_CRC
+#if defined(NAVHAL_CONFIG_SD_SPI_CRC) && NAVHAL_CONFIG_SD_SPI_CRC
+#define SD_SPI_CRC 1
+#else
+#define SD_SPI_CRC 0
+#endif
+#endif
+
+#define _SS 512U
+#define _XFER_TIMEOUT_MS 100U
+
+/* Command indices; ACMDs carry bit 7 and are prefixed with CMD55. */
+#define _CMD0 0U    /* GO_IDLE_STATE */
+#define _CMD8 8U    /* SEND_IF_COND */
+#define _CMD9 9U    /* SEND_CSD */
+#define _CMD12 12U  /* STOP_TRANSMISSION */
+#define _CMD16 16U  /* SET_BLOCKLEN */
+#define _CMD17 17U  /* READ_SINGLE_BLOCK */
+#define _CMD18 18U  /* READ_MULTIPLE_BLOCK */
+#define _CMD24 24U  /* WRITE_BLOCK */
+#define _CMD25 25U  /* WRITE_MULTIPLE_BLOCK */
+#define _CMD32 32U  /* ERASE_WR_BLK_START */
+#define _CMD33 33U  /* ERASE_WR_BLK_END */
+#define _CMD38 38U  /* ERASE */
+#define _CMD55 55U  /* APP_CMD */
+#define _CMD58 58U  /* READ_OCR */
+#define _CMD59 59U  /* CRC_ON_OFF */
+#define _ACMD 0x80U
+#define _ACMD13 (_ACMD | 13U) /* SD_STATUS */
+#define _ACMD23 (_ACMD | 23U) /* SET_WR_BLK_ERASE_COUNT */
+#define _ACMD41 (_ACMD | 41U) /* SD_SEND_OP_COND */
+
+#define _R1_IDLE 0x01U
+#define _TOKEN_START 0xFEU      /* CMD17/18/24 data block */
+#define _TOKEN_START_MULTI 0xFCU /* CMD25 data block */
+#define _TOKEN_STOP_TRAN 0xFDU  /* end of a CMD25 stream */
+
+static hal_disk_status_t disk_stat = HAL_DISK_STATUS_NOINIT;
+static sd_spi_info_t card;
+
+/*---------------------------------------------------------------------------
+ * CRCs — CRC7 for command frames, CRC16-CCITT for data blocks
+ *---------------------------------------------------------------------------*/
+
+static uint8_t crc7(const uint8_t *p, uint8_t len) {
+  uint8_t crc = 0;
+  while (len--) {
+    uint8_t d = *p++;
+    for (uint8_t i = 0; i < 8; i++, d <<= 1) {
+      crc <<= 1;
+      if ((d ^ crc) & 0x80U)
+        crc ^= 0x09U;
+    }
+  }
+  return crc & 0x7FU;
+}
+
+#if SD_SPI_CRC
+/* Nibble table: 32 bytes of const data instead of 512 on 8-bit parts. */
+static const uint16_t crc16_nibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF};
+
+static uint16_t crc16(const uint8_t *p, uint16_t len) {
+  uint16_t crc = 0;
+  while (len--) {
+    uint8_t d = *p++;
+    crc = (uint16_t)((crc << 4) ^ crc16_nibble[(crc >> 12) ^ (d >> 4)]);
+    crc = (uint16_t)((crc << 4) ^ crc16_nibble[(crc >> 12) ^ (d & 0x0FU)]);
+  }
+  return crc;
+}
+#endif
+
+/*---------------------------------------------------------------------------
+ * Bus primitives
+ *---------------------------------------------------------------------------*/
+
+static uint8_t xchg(uint8_t out) {
+  uint8_t in = 0xFF;
+  if (hal_spi_transmit_receive(SD_SPI_BUS, &out, &in, 1, _XFER_TIMEOUT_MS) !=
+      HAL_OK)
+    return 0xFF;
+  return in;
+}
+
+static void bus_init(hal_spi_baudrate_t baudrate) {
+  const hal_spi_config_t cfg = {.baudrate = baudrate,
+                                .cpol = HAL_SPI_CPOL_LOW,
+                                .cpha = HAL_SPI_CPHA_1EDGE,
+                                .datasize = HAL_SPI_DATASIZE_8BIT,
+                                .firstbit = HAL_SPI_FIRSTBIT_MSB};
+  hal_spi_init(SD_SPI_BUS, &cfg);
+}
+
+/** Wait until the card releases DO (not busy). */
+static int wait_ready(uint32_t timeout_ms) {
+  uint32_t start = hal_timebase_get_millis();
+  do {
+    if (xchg(0xFF) == 0xFF)
+      return 1;
+  } while ((uint32_t)(hal_timebase_get_millis() - start) < timeout_ms);
+  return 0;
+}
+
+static void cs_deselect(void) {
+  hal_gpio_write(SD_SPI_CS, HAL_GPIO_HIGH);
+  xchg(0xFF); /* the card releases DO one clock byte after CS rises */
+}
+
+static int cs_select(void) {
+  hal_gpio_write(SD_SPI_CS, HAL_GPIO_LOW);
+  xchg(0xFF);
+  if (wait_ready(SD_SPI_BUSY_TIMEOUT_MS))
+    return 1;
+  cs_deselect();
+  return 0;
+}
+
+/**
+ * Send a command and return its R1 (0xFF: no response). The card stays
+ * selected, so the caller can read the rest of the response or the data.
+ */
+static uint8_t send_cmd(uint8_t cmd, uint32_t arg) {
+  if (cmd & _ACMD) {
+    uint8_t r1 = send_cmd(_CMD55, 0);
+    if (r1 > _R1_IDLE)
+      return r1;
+    cmd &= (uint8_t)~_ACMD;
+  }
+
+  /* CMD12 goes out in the middle of a CMD18 stream, card still selected. */
+  if (cmd != _CMD12) {
+    cs_deselect();
+    if (!cs_select())
+      return 0xFF;
+  }
+
+  uint8_t frame[6] = {(uint8_t)(0x40U | cmd), (uint8_t)(arg >> 24),
+                      (uint8_t)(arg >> 16), (uint8_t)(arg >> 8),
+                      (uint8_t)arg, 0};
+  frame[5] = (uint8_t)((crc7(frame, 5) << 1) | 1U);
+  if (hal_spi_transmit(SD_SPI_BUS, frame, sizeof(frame), _XFER_TIMEOUT_MS) !=
+      HAL_OK)
+    return 0xFF;
+  if (cmd == _CMD12)
+    xchg(0xFF); /* stuff byte */
+
+  /* The response arrives within 8 bytes (NCR). */
+  uint8_t r1;
+  uint8_t n = 10;
+  do {
+    r1 = xchg(0xFF);
+  } while ((r1 & 0x80U) && --n);
+  return r1;
+}
+
+/** Receive one data block of @p len bytes (after a read command). */
+static int rx_block(uint8_t *buff, uint16_t len) {
+  uint32_t start = hal_timebase_get_millis();
+  uint8_t token;
+  do {
+    token = xchg(0xFF);
+  } while (token == 0xFF && (uint32_t)(hal_timebase_get_millis() - start) <
+                                SD_SPI_READ_TIMEOUT_MS);
+  if (token != _TOKEN_START)
+    return 0; /* timeout, or an error token */
+
+  if (hal_spi_receive(SD_SPI_BUS, buff, len, _XFER_TIMEOUT_MS) != HAL_OK)
+    return 0;
+  uint8_t crc[2];
+  if (hal_spi_receive(SD_SPI_BUS, crc, 2, _XFER_TIMEOUT_MS) != HAL_OK)
+    return 0;
+#if SD_SPI_CRC
+  if ((((uint16_t)crc[0] << 8) | crc[1]) != crc16(buff, len))
+    return 0;
+#endif
+  return 1;
+}
+
+/**
+ * Send one 512-byte data block with @p token, or just the stop-tran token.
+ * Only the data response is checked; programming is waited out by the
+ * next select.
+ */
+static int tx_block(const uint8_t *buff, uint8_t token) {
+  if (!wait_ready(SD_SPI_BUSY_TIMEOUT_MS))
+    return 0;
+  xchg(token);
+  if (token == _TOKEN_STOP_TRAN)
+    return 1;
+
+  if (hal_spi_transmit(SD_SPI_BUS, buff, _SS, _XFER_TIMEOUT_MS) != HAL_OK)
+    return 0;
+#if SD_SPI_CRC
+  uint16_t c = crc16(buff, _SS);
+  uint8_t crc[2] = {(uint8_t)(c >> 8), (uint8_t)c};
+#else
+  uint8_t crc[2] = {0xFF, 0xFF};
+#endif
+  if (hal_spi_transmit(SD_SPI_BUS, crc, 2, _XFER_TIMEOUT_MS) != HAL_OK)
+    return 0;
+  return (xchg(0xFF) & 0x1FU) == 0x05U; /* data accepted */
+}
+
+/*---------------------------------------------------------------------------
+ * Initialisation
+ *---------------------------------------------------------------------------*/
+
+/** ACMD41 until the card leaves the idle state; @p arg carries HCS. */
+static int wait_op_cond(uint32_t arg) {
+  uint32_t start = hal_timebase_get_millis();
+  while ((uint32_t)(hal_timebase_get_millis() - start) <
+         SD_SPI_INIT_TIMEOUT_MS) {
+    if (send_cmd(_ACMD41, arg) == 0)
+      return 1;
+    hal_delay_ms(1);
+  }
+  return 0;
+}
+
+static sd_spi_card_t identify(void) {
+  uint8_t r[4];
+
+  /* CMD0 with CS low puts the card in SPI mode; a card still busy with
+   * something from before the reset may need a few tries. */
+  uint8_t r1 = 0xFF;
+  for (int tries = 0; tries < 4 && r1 != _R1_IDLE; tries++)
+    r1 = send_cmd(_CMD0, 0);
+  if (r1 != _R1_IDLE)
+    return SD_SPI_CARD_NONE;
+
+  if (send_cmd(_CMD8, 0x1AA) == _R1_IDLE) {
+    /* SD 2.0+: the R7 echoes the 2.7-3.6 V range and the check pattern. */
+    if (hal_spi_receive(SD_SPI_BUS, r, 4, _XFER_TIMEOUT_MS) != HAL_OK ||
+        r[2] != 0x01U || r[3] != 0xAAU)
+      return SD_SPI_CARD_NONE;
+    if (!wait_op_cond(1UL << 30) || send_cmd(_CMD58, 0) != 0 ||
+        hal_spi_receive(SD_SPI_BUS, r, 4, _XFER_TIMEOUT_MS) != HAL_OK)
+      return SD_SPI_CARD_NONE;
+    return (r[0] & 0x40U) ? SD_SPI_CARD_SDHC : SD_SPI_CARD_SDV2;
+  }
+
+  /* SD 1.x rejects CMD8; MMC would reject ACMD41 too and is not handled. */
+  if (!wait_op_cond(0))
+    return SD_SPI_CARD_NONE;
+  return SD_SPI_CARD_SDV1;
+}
+
+/** Capacity and erase unit from the CSD and, for SD 2.0, SD_STATUS. */
+static int read_geometry(void) {
+  uint8_t csd[16];
+  if (send_cmd(_CMD9, 0) != 0 || !rx_block(csd, sizeof(csd)))
+    return 0;
+
+  if ((csd[0] >> 6) == 1U) {
+    /* CSD 2.0: (C_SIZE + 1) x 512 KiB */
+    uint32_t c_size = ((uint32_t)(csd[7] & 0x3FU) << 16) |
+                      ((uint32_t)csd[8] << 8) | csd[9];
+    card.sectors = (c_size + 1U) << 10;
+  } else {
+    /* CSD 1.0: (C_SIZE + 1) x 2^(C_SIZE_MULT + 2) x 2^READ_BL_LEN bytes */
+    uint8_t n = (uint8_t)((csd[5] & 0x0FU) + ((csd[10] & 0x80U) >> 7) +
+                          ((csd[9] & 0x03U) << 1) + 2U);
+    uint32_t c_size = ((uint32_t)(csd[8] >> 6) | ((uint32_t)csd[7] << 2) |
+                       ((uint32_t)(csd[6] & 0x03U) << 10)) +
+                      1U;
+    card.sectors = n >= 9U ? c_size << (n - 9U) : 0;
+  }
+
+  /* Fall back to the CSD erase sector size (SECTOR_SIZE + 1 write blocks
+   * of 2^WRITE_BL_LEN bytes) when SD_STATUS gives no AU. */
+  uint32_t erase_blocks =
+      ((((uint32_t)csd[10] & 0x3FU) << 1) | (csd[11] >> 7)) + 1U;
+  uint8_t write_bl_len = (uint8_t)(((csd[12] & 0x03U) << 2) | (csd[13] >> 6));
+  card.erase_unit = write_bl_len >= 9U ? erase_blocks << (write_bl_len - 9U)
+                                       : 0;
+  if (card.type != SD_SPI_CARD_SDV1) {
+    uint8_t sd_status[64];
+    /* R2: the R1 byte is returned, the second status byte follows. */
+    if (send_cmd(_ACMD13, 0) == 0) {
+      xchg(0xFF);
+      if (rx_block(sd_status, sizeof(sd_status)) &&
+          sd_au_sectors(sd_status[10] >> 4))
+        card.erase_unit = sd_au_sectors(sd_status[10] >> 4);
+    }
+  }
+  return card.sectors != 0;
+}
+
+/*---------------------------------------------------------------------------
+ * hal_disk_* interface
+ *---------------------------------------------------------------------------*/
+
+hal_disk_status_t hal_disk_initialize(uint8_t pdrv) {
+  if (pdrv != 0)
+    return HAL_DISK_STATUS_NOINIT;
+
+  hal_gpio_enable_clock(SD_SPI_CS);
+  hal_gpio_set_mode(SD_SPI_CS, HAL_GPIO_MODE_OUTPUT, HAL_GPIO_PULL_NONE);
+  hal_gpio_write(SD_SPI_CS, HAL_GPIO_HIGH);
+  bus_init(HAL_SPI_BAUDRATE_DIV256);
+
+  /* >= 74 clocks with CS and DI high before the first command. */
+  for (uint8_t i = 0; i < 10; i++)
+    xchg(0xFF);
+
+  disk_stat = HAL_DISK_STATUS_NOINIT;
+  card.type = identify();
+  card.crc = 0;
+  if (card.type != SD_SPI_CARD_NONE) {
+    /* Standard-capacity cards may power up with another block length. */
+    int ok = card.type == SD_SPI_CARD_SDHC || send_cmd(_CMD16, _SS) == 0;
+#if SD_SPI_CRC
+    ok = ok && send_cmd(_CMD59, 1) == 0;
+    card.crc = (uint8_t)ok;
+#endif
+    if (ok && read_geometry())
+      disk_stat = HAL_DISK_STATUS_OK;
+  }
+  cs_deselect();
+
+  if (disk_stat & HAL_DISK_STATUS_NOINIT)
+    card.type = SD_SPI_CARD_NONE;
+  else
+    bus_init(SD_SPI_FAST_BAUDRATE);
+  return disk_stat;
+}
+
+hal_disk_status_t hal_disk_status(uint8_t pdrv) {
+  if (pdrv != 0)
+    return HAL_DISK_STATUS_NODISK;
+  return disk_stat;
+}
+
+/* The command argument: a block address for SDHC, a byte address otherwise.
+ * 0 with *ok cleared if [sector, sector + count) does not fit in 32 bits. */
+static uint32_t card_addr(hal_disk_lba_t sector, uint32_t count, int *ok) {
+  *ok = (uint64_t)sector + count <= 0x100000000ULL;
+  if (!*ok)
+    return 0;
+  return card.type == SD_SPI_CARD_SDHC ? (uint32_t)sector
+                                       : (uint32_t)sector * _SS;
+}
+
+hal_disk_result_t hal_disk_read(uint8_t pdrv, uint8_t *buff,
+                                hal_disk_lba_t lba, uint32_t count) {
+  int ok;
+  if (pdrv != 0 || !buff || !count)
+    return HAL_DISK_RES_PARERR;
+  if (disk_stat & HAL_DISK_STATUS_NOINIT)
+    return HAL_DISK_RES_NOTRDY;
+  uint32_t sector = card_addr(lba, count, &ok);
+  if (!ok)
+    return HAL_DISK_RES_PARERR;
+
+  if (count == 1) {
+    if (send_cmd(_CMD17, sector) == 0 && rx_block(buff, _SS))
+      count = 0;
+  } else if (send_cmd(_CMD18, sector) == 0) {
+    do {
+      if (!rx_block(buff, _SS))
+        break;
+      buff += _SS;
+    } while (--count);
+    send_cmd(_CMD12, 0);
+  }
+  cs_deselect();
+
+  return count ? HAL_DISK_RES_ERROR : HAL_DISK_RES_OK;
+}
+
+hal_disk_result_t hal_disk_write(uint8_t pdrv, const uint8_t *buff,
+                                 hal_disk_lba_t lba, uint32_t count) {
+  int ok;
+  if (pdrv != 0 || !buff || !count)
+    return HAL_DISK_RES_PARERR;
+  if (disk_stat & HAL_DISK_STATUS_NOINIT)
+    return HAL_DISK_RES_NOTRDY;
+  uint32_t sector = card_addr(lba, count, &ok);
+  if (!ok)
+    return HAL_DISK_RES_PARERR;
+
+  if (count == 1) {
+    if (send_cmd(_CMD24, sector) == 0 && tx_block(buff, _TOKEN_START))
+      count = 0;
+  } else {
+    /* Pre-erasing the range lets the card program the stream faster. */
+    send_cmd(_ACMD23, count);
+    if (send_cmd(_CMD25, sector) == 0) {
+      do {
+        if (!tx_block(buff, _TOKEN_START_MULTI))
+          break;
+        buff += _SS;
+      } while (--count);
+      if (!tx_block(NULL, _TOKEN_STOP_TRAN))
+        count = 1;
+    }
+  }
+  cs_deselect();
+
+  return count ? HAL_DISK_RES_ERROR : HAL_DISK_RES_OK;
+}
+
+hal_disk_result_t hal_disk_ioctl(uint8_t pdrv, uint8_t cmd, void *buff) {
+  if (pdrv != 0)
+    return HAL_DISK_RES_PARERR;
+  if (disk_stat & HAL_DISK_STATUS_NOINIT)
+    return HAL_DISK_RES_NOTRDY;
+
+  switch (cmd) {
+  case HAL_DISK_IO_SYNC: {
+    /* Writes don't wait out card programming; a sync does. */
+    int ok = cs_select();
+    cs_deselect();
+    return ok ? HAL_DISK_RES_OK : HAL_DISK_RES_ERROR;
+  }
+  case HAL_DISK_IO_GET_SECTOR_COUNT:
+    *((hal_disk_lba_t *)buff) = card.sectors;
+    return HAL_DISK_RES_OK;
+  case HAL_DISK_IO_GET_SECTOR_SIZE:
+    *((uint16_t *)buff) = _SS;
+    return HAL_DISK_RES_OK;
+  case HAL_DISK_IO_GET_BLOCK_SIZE: {
+    /* Same clamp as the SDIO backend: f_mkfs wants a power of two no
+     * larger than 32768. */
+    uint32_t au = card.erase_unit;
+    au &= -au;
+    *((uint32_t *)buff) = !au ? 1 : (au > 32768U ? 32768U : au);
+    return HAL_DISK_RES_OK;
+  }
+  case HAL_DISK_IO_TRIM: {
+    const hal_disk_lba_t *range = (const hal_disk_lba_t *)buff;
+    if (range[1] < range[0] || range[1] >= card.sectors)
+      return HAL_DISK_RES_PARERR;
+    int ok;
+    uint32_t first = card_addr(range[0], 1, &ok);
+    uint32_t last = card_addr(range[1], 1, &ok);
+    ok = send_cmd(_CMD32, first) == 0 && send_cmd(_CMD33, last) == 0 &&
+             send_cmd(_CMD38, 0) == 0 && wait_ready(SD_SPI_ERASE_TIMEOUT_MS);
+    cs_deselect();
+    return ok ? HAL_DISK_RES_OK : HAL_DISK_RES_ERROR;
+  }
+  default:
+    return HAL_DISK_RES_PARERR;
+  }
+}
+
+hal_disk_result_t sd_spi_get_info(sd_spi_info_t *info) {
+  if (!info)
+    return HAL_DISK_RES_PARERR;
+  if (disk_stat & HAL_DISK_STATUS_NOINIT)
+    return HAL_DISK_RES_NOTRDY;
+  *info = card;
+  return HAL_DISK_RES_OK;
+}
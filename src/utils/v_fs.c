@@ -21,13 +21,448 @@
  */
 
 #include "utils/v_fs.h"
+#include "common/hal_cache.h"
+#include "fatfs/diskio.h"
 #include "fatfs/ff.h"
+#include "navhal_port_config.h"
+#include "utils/ram_disk.h" /* RAM_DISK */
+#include <limits.h>
+#include <string.h>
 
-#define MAX_OPEN_FILES 4
+#ifndef V_FS_FASTSEEK
+#if defined(NAVHAL_CONFIG_VFS_FASTSEEK) && NAVHAL_CONFIG_VFS_FASTSEEK
+#define V_FS_FASTSEEK 1
+#else
+#define V_FS_FASTSEEK 0
+#endif
+#endif
+#if V_FS_FASTSEEK && !FF_USE_FASTSEEK
+#error "V_FS_FASTSEEK needs FF_USE_FASTSEEK (ffconf.h)"
+#endif
+
+#ifndef V_FS_WRITE_BUFFER
+#if defined(NAVHAL_CONFIG_VFS_WRITE_BUFFER) && NAVHAL_CONFIG_VFS_WRITE_BUFFER
+#define V_FS_WRITE_BUFFER 1
+#else
+#define V_FS_WRITE_BUFFER 0
+#endif
+#endif
+
+#ifndef V_FS_DCACHE
+#if defined(NAVHAL_CONFIG_VFS_DCACHE) && NAVHAL_CONFIG_VFS_DCACHE
+#define V_FS_DCACHE 1
+#else
+#define V_FS_DCACHE 0
+#endif
+#endif
+
+#if V_FS_MAX_OPEN_FILES < 1 || V_FS_MAX_OPEN_FILES > 32
+#error "V_FS_MAX_OPEN_FILES must be 1..32"
+#endif
+
+#define FD_ALL (0xFFFFFFFFUL >> (32U - V_FS_MAX_OPEN_FILES))
 
 static FATFS fs_obj;
-static FIL open_files[MAX_OPEN_FILES];
-static uint8_t file_in_use[MAX_OPEN_FILES] = {0};
+#if RAM_DISK
+static FATFS ram_fs;
+#endif
+static FIL open_files[V_FS_MAX_OPEN_FILES];
+static uint32_t fd_used; /* Bit n set: descriptor n is open */
+
+static int fd_valid(v_fd_t fd) {
+  return fd >= 0 && fd < (int)V_FS_MAX_OPEN_FILES &&
+         (fd_used & (1UL << fd)) != 0;
+}
+
+#if FF_FS_EXFAT && !V_FS_LARGE_FILES
+#error "exFAT files need 64-bit offsets (V_FS_LARGE_FILES)"
+#endif
+
+#if V_FS_LARGE_FILES
+#define V_OFF_MAX INT64_MAX
+#else
+#define V_OFF_MAX LONG_MAX
+#endif
+
+/* *cap = size, if FatFs can hold a file that large: 4 GiB - 1 on FAT. */
+static int size_ok(v_size_t size, FSIZE_t *cap) {
+#if V_FS_LARGE_FILES && !FF_FS_EXFAT
+  if (size > (FSIZE_t)-1)
+    return 0;
+#endif
+  *cap = (FSIZE_t)size;
+  return 1;
+}
+
+/* *pos = base + offset, if that is a position both FatFs and v_off_t can
+ * hold: not before the start, and not past 4 GiB - 1 on FAT. */
+static int off_add(FSIZE_t base, v_off_t offset, FSIZE_t *pos) {
+  uint64_t limit = (FSIZE_t)-1;
+  if (limit > (uint64_t)V_OFF_MAX)
+    limit = (uint64_t)V_OFF_MAX;
+  uint64_t p;
+  if (offset < 0) {
+    uint64_t back = 0 - (uint64_t)offset;
+    if (back > base)
+      return 0;
+    p = base - back;
+  } else {
+    p = base + (uint64_t)offset;
+    if (p < base)
+      return 0;
+  }
+  if (p > limit)
+    return 0;
+  *pos = (FSIZE_t)p;
+  return 1;
+}
+
+#if V_FS_FASTSEEK
+#if V_FS_CLMT_ITEMS < 4
+#error "V_FS_CLMT_ITEMS must hold at least one fragment (4 items)"
+#endif
+
+static DWORD clmt[V_FS_MAX_OPEN_FILES][V_FS_CLMT_ITEMS];
+static FSIZE_t clmt_span[V_FS_MAX_OPEN_FILES]; /* Bytes of clusters mapped */
+
+/* Build the file's cluster link map. Too many fragments for the table is
+ * not an error: the file stays in normal mode. */
+static FRESULT clmt_build(int fd) {
+  FIL *fp = &open_files[fd];
+  if (fp->obj.sclust == 0)
+    return FR_OK; /* No clusters yet: nothing to map */
+
+  clmt[fd][0] = V_FS_CLMT_ITEMS;
+  fp->cltbl = clmt[fd];
+  FRESULT res = f_lseek(fp, CREATE_LINKMAP);
+  if (res != FR_OK) {
+    fp->cltbl = NULL;
+    return res == FR_NOT_ENOUGH_CORE ? FR_OK : res;
+  }
+
+  uint32_t clusters = 0;
+  for (const DWORD *t = &clmt[fd][1]; *t != 0; t += 2)
+    clusters += *t;
+  clmt_span[fd] = (FSIZE_t)clusters * fp->obj.fs->csize * FF_MAX_SS;
+  return FR_OK;
+}
+
+/* The map cannot grow the cluster chain: leave fast-seek mode before the
+ * file position or size would move past the mapped clusters. */
+static void clmt_release(int fd, FSIZE_t end) {
+  FIL *fp = &open_files[fd];
+  if (fp->cltbl != NULL && end > clmt_span[fd])
+    fp->cltbl = NULL;
+}
+#endif
+
+/* Streaming files (v_open_stream): data goes straight to the reserved,
+ * contiguous sectors; FatFs only sees the file again on close. */
+typedef struct {
+  uint8_t owner;         /* fd + 1, 0 = free */
+  LBA_t lba;             /* First sector of the reserved range */
+  FSIZE_t cap;           /* Reserved bytes */
+  FSIZE_t pos;           /* Bytes written */
+  BYTE tail[FF_MAX_SS];  /* Sector being filled */
+} stream_t;
+
+static stream_t streams[V_FS_MAX_STREAMS];
+
+static stream_t *stream_of(int fd) {
+  for (uint8_t i = 0; i < V_FS_MAX_STREAMS; i++)
+    if (streams[i].owner == fd + 1)
+      return &streams[i];
+  return NULL;
+}
+
+static FRESULT stream_put(const FIL *fp, const BYTE *buf, LBA_t sector,
+                          UINT count) {
+  return disk_write(fp->obj.fs->pdrv, buf, sector, count) == RES_OK
+             ? FR_OK
+             : FR_DISK_ERR;
+}
+
+/* Write the partly filled last sector, zero padded; it stays buffered. */
+static FRESULT stream_flush(const FIL *fp, const stream_t *st) {
+  if (st->pos % FF_MAX_SS == 0)
+    return FR_OK;
+  return stream_put(fp, st->tail, st->lba + st->pos / FF_MAX_SS, 1);
+}
+
+static int stream_write(int fd, stream_t *st, const BYTE *p, size_t count) {
+  const FIL *fp = &open_files[fd];
+  FSIZE_t room = st->cap - st->pos;
+  if (room == 0)
+    return -(int)FR_DENIED;
+  if (count > room)
+    count = (size_t)room;
+
+  size_t left = count;
+  while (left > 0) {
+    UINT off = (UINT)(st->pos % FF_MAX_SS);
+    FRESULT res = FR_OK;
+    if (off == 0 && left >= FF_MAX_SS) {
+      /* Whole sectors go out from the caller's buffer in one write. */
+      UINT n = (UINT)(left / FF_MAX_SS);
+      res = stream_put(fp, p, st->lba + st->pos / FF_MAX_SS, n);
+      n *= FF_MAX_SS;
+      st->pos += n;
+      p += n;
+      left -= n;
+    } else {
+      UINT n = FF_MAX_SS - off;
+      if (n > left)
+        n = (UINT)left;
+      if (off == 0)
+        memset(st->tail, 0, sizeof(st->tail));
+      memcpy(st->tail + off, p, n);
+      st->pos += n;
+      p += n;
+      left -= n;
+      if (st->pos % FF_MAX_SS == 0)
+        res = stream_put(fp, st->tail, st->lba + (st->pos - 1) / FF_MAX_SS,
+                         1);
+    }
+    if (res != FR_OK)
+      return -(int)res;
+  }
+  return (int)count;
+}
+
+/* Flush the tail and commit the written length: the clusters past it go
+ * back to the volume. */
+static FRESULT stream_close(int fd, stream_t *st) {
+  FIL *fp = &open_files[fd];
+  FRESULT res = stream_flush(fp, st);
+  if (res == FR_OK)
+    res = f_lseek(fp, st->pos);
+  if (res == FR_OK)
+    res = f_truncate(fp);
+  return res;
+}
+
+#if V_FS_WRITE_BUFFER
+#if V_FS_WBUF_SECTORS == 0 || (V_FS_WBUF_SECTORS & (V_FS_WBUF_SECTORS - 1))
+#error "V_FS_WBUF_SECTORS must be a power of two"
+#endif
+
+#define WBUF_BYTES (V_FS_WBUF_SECTORS * FF_MAX_SS)
+
+/* Write buffers (V_O_BUFFERED). FatFs' position stays at the first byte
+ * not yet written; the half being filled holds what follows it, up to the
+ * next multiple of WBUF_BYTES. The other half may still be on its way to
+ * the card (disk_write_behind). */
+typedef struct {
+  uint8_t owner; /* fd + 1, 0 = free */
+  uint8_t cur;   /* Half being filled */
+  UINT fill;     /* Bytes in it */
+  uint8_t buf[2][HAL_CACHE_ALIGN_UP(WBUF_BYTES)] NAVHAL_DMA_BUFFER;
+} wbuf_t;
+
+static wbuf_t wbufs[V_FS_MAX_WBUFS];
+
+static wbuf_t *wbuf_of(int fd) {
+  for (uint8_t i = 0; i < V_FS_MAX_WBUFS; i++)
+    if (wbufs[i].owner == fd + 1)
+      return &wbufs[i];
+  return NULL;
+}
+
+/* Hand the filled half to FatFs and switch to the other one once the card
+ * is done with it. */
+static FRESULT wbuf_flush(int fd, wbuf_t *wb) {
+  FIL *fp = &open_files[fd];
+  if (wb->fill == 0)
+    return FR_OK;
+#if V_FS_FASTSEEK
+  clmt_release(fd, f_tell(fp) + wb->fill);
+#endif
+  UINT bw;
+  const BYTE *data = wb->buf[wb->cur];
+  disk_write_behind(data, WBUF_BYTES);
+  FRESULT res = f_write(fp, data, wb->fill, &bw);
+  disk_write_behind(NULL, 0);
+  if (res == FR_OK && bw != wb->fill)
+    res = FR_DENIED; /* Volume full */
+  wb->fill = 0;
+  wb->cur ^= 1U;
+  if (disk_write_release(fp->obj.fs->pdrv, wb->buf[wb->cur], WBUF_BYTES) !=
+          RES_OK &&
+      res == FR_OK)
+    res = FR_DISK_ERR;
+  return res;
+}
+
+static int wbuf_write(int fd, wbuf_t *wb, const BYTE *p, size_t count) {
+  FIL *fp = &open_files[fd];
+  size_t left = count;
+  while (left > 0) {
+    /* The window ends at the next multiple of WBUF_BYTES. */
+    UINT room = WBUF_BYTES - (UINT)((f_tell(fp) + wb->fill) % WBUF_BYTES);
+    FRESULT res = FR_OK;
+    if (wb->fill == 0 && room == WBUF_BYTES && left >= WBUF_BYTES) {
+      /* Whole windows go out from the caller's buffer, synchronously. */
+      UINT n = (UINT)(left - left % WBUF_BYTES), bw;
+#if V_FS_FASTSEEK
+      clmt_release(fd, f_tell(fp) + n);
+#endif
+      res = f_write(fp, p, n, &bw);
+      if (res == FR_OK && bw != n)
+        res = FR_DENIED;
+      p += n;
+      left -= n;
+    } else {
+      UINT n = room < left ? room : (UINT)left;
+      memcpy(wb->buf[wb->cur] + wb->fill, p, n);
+      wb->fill += n;
+      p += n;
+      left -= n;
+      if (n == room)
+        res = wbuf_flush(fd, wb);
+    }
+    if (res != FR_OK)
+      return -(int)res;
+  }
+  return (int)count;
+}
+#endif
+
+#if V_FS_DCACHE
+#if V_FS_DCACHE_ENTRIES == 0 ||                                               \
+    (V_FS_DCACHE_ENTRIES & (V_FS_DCACHE_ENTRIES - 1))
+#error "V_FS_DCACHE_ENTRIES must be a power of two"
+#endif
+
+/* Directory entry cache: where a path's short-name entry was last found,
+ * so reopening it reads at most that directory sector instead of walking
+ * the directories on the path. Direct mapped on a hash of the path. An
+ * entry only counts on the mount it was made on (FATFS.id, unique across
+ * volumes) and while the short name there still matches.
+ *
+ * The short name alone cannot tell two long names apart (both may be
+ * SENSOR~1.CSV), so an entry must never outlive its file: any v_unlink
+ * empties the whole cache, whatever spelling of whichever path it was
+ * given. A create can then only reuse a slot that no entry points at. */
+typedef struct {
+  uint64_t key;  /* Path hash, 0 = empty */
+  FATFS *fs;     /* Volume of the entry */
+  LBA_t sect;    /* Directory sector holding the entry */
+  uint16_t ofs;  /* Byte offset of the entry in it */
+  WORD id;       /* FATFS.id of the mount */
+  BYTE name[11]; /* DIR_Name, to recheck the entry */
+} dent_t;
+
+static dent_t dcache[V_FS_DCACHE_ENTRIES];
+
+#define FNV_PRIME 0x100000001B3ULL
+
+/* 64-bit FNV-1a of the path as FatFs resolves it: the drive made explicit
+ * ("x" is "0:x"), runs of separators as one, leading and trailing ones
+ * dropped, ASCII case folded as FAT names are. */
+static uint64_t dcache_key(const char *path) {
+  uint64_t h = 0xCBF29CE484222325ULL;
+  BYTE drv = '0';
+  if (path[0] >= '0' && path[0] <= '9' && path[1] == ':') {
+    drv = (BYTE)path[0];
+    path += 2;
+  }
+  h = (h ^ drv) * FNV_PRIME;
+  h = (h ^ ':') * FNV_PRIME;
+
+  int named = 0, sep = 0;
+  for (; *path != '\0'; path++) {
+    BYTE c = (BYTE)*path;
+    if (c == '/' || c == '\\') {
+      sep = named;
+      continue;
+    }
+    if (sep)
+      h = (h ^ '/') * FNV_PRIME;
+    if (c >= 'a' && c <= 'z')
+      c -= 'a' - 'A';
+    h = (h ^ c) * FNV_PRIME;
+    named = 1;
+    sep = 0;
+  }
+  return h != 0 ? h : 1;
+}
+
+static dent_t *dcache_slot(uint64_t key) {
+  return &dcache[key & (V_FS_DCACHE_ENTRIES - 1U)];
+}
+
+static void dcache_flush(void) {
+  for (uint32_t i = 0; i < V_FS_DCACHE_ENTRIES; i++)
+    dcache[i].key = 0;
+}
+
+/* Record the entry f_open found; FatFs leaves it in the window. */
+static void dcache_remember(uint64_t key, const FIL *fp) {
+  FATFS *fs = fp->obj.fs;
+  if (fs->fs_type == FS_EXFAT || fs->winsect != fp->dir_sect)
+    return;
+  dent_t *e = dcache_slot(key);
+  e->key = key;
+  e->fs = fs;
+  e->sect = fp->dir_sect;
+  e->ofs = (uint16_t)(fp->dir_ptr - fs->win);
+  e->id = fs->id;
+  memcpy(e->name, fp->dir_ptr, sizeof(e->name));
+}
+
+/* Open an existing file from its cached entry, the way f_open would after
+ * finding it. Returns 0 to leave it to f_open: not cached, the volume needs
+ * remounting, or the window holds unwritten changes. */
+static int dcache_open(uint64_t key, FIL *fp, BYTE mode) {
+  dent_t *e = dcache_slot(key);
+  if (e->key != key)
+    return 0;
+  FATFS *fs = e->fs;
+  if (fs->fs_type == 0 || e->id != fs->id ||
+      (disk_status(fs->pdrv) & STA_NOINIT))
+    return 0;
+  if (fs->winsect != e->sect) {
+    if (fs->wflag)
+      return 0;
+    if (disk_read(fs->pdrv, fs->win, e->sect, 1) != RES_OK) {
+      fs->winsect = (LBA_t)0 - 1; /* Window contents unknown */
+      return 0;
+    }
+    fs->winsect = e->sect;
+  }
+
+  BYTE *dir = fs->win + e->ofs;
+  BYTE attr = dir[11];
+  if (memcmp(dir, e->name, sizeof(e->name)) != 0 ||
+      (attr & (AM_DIR | 0x08 /* AM_VOL */)) ||
+      ((mode & FA_WRITE) && (attr & AM_RDO))) {
+    e->key = 0;
+    return 0;
+  }
+
+  DWORD cl = (DWORD)dir[26] | (DWORD)dir[27] << 8;
+  if (fs->fs_type == FS_FAT32)
+    cl |= ((DWORD)dir[20] | (DWORD)dir[21] << 8) << 16;
+  fp->obj.fs = fs;
+  fp->obj.id = fs->id;
+  fp->obj.sclust = cl;
+  fp->obj.objsize = (DWORD)dir[28] | (DWORD)dir[29] << 8 |
+                    (DWORD)dir[30] << 16 | (DWORD)dir[31] << 24;
+#if FF_USE_FASTSEEK
+  fp->cltbl = NULL;
+#endif
+  fp->flag = mode;
+  fp->err = 0;
+  fp->sect = 0;
+  fp->fptr = 0;
+  fp->dir_sect = e->sect;
+  fp->dir_ptr = dir;
+#if !FF_FS_TINY
+  memset(fp->buf, 0, sizeof(fp->buf));
+#endif
+  return 1;
+}
+#endif
 
 int v_fs_init(void) {
   FRESULT res = f_mount(&fs_obj, "0:", 1);
@@ -37,26 +472,37 @@ int v_fs_init(void) {
   return 0;
 }
 
-v_fd_t v_open(const char *path, int flags) {
-  int fd = -1;
-  for (int i = 0; i < MAX_OPEN_FILES; i++) {
-    if (!file_in_use[i]) {
-      fd = i;
-      break;
-    }
+int v_fs_mount_ram(void) {
+#if RAM_DISK
+  static const char drv[] = {'0' + RAM_DISK_PDRV, ':', '\0'};
+  FRESULT res = f_mount(&ram_fs, drv, 1);
+  if (res == FR_NO_FILESYSTEM) {
+    BYTE work[FF_MAX_SS];
+    const MKFS_PARM opt = {.fmt = FM_ANY | FM_SFD, .n_fat = 1, .align = 1};
+    res = f_mkfs(drv, &opt, work, sizeof(work));
+    if (res == FR_OK)
+      res = f_mount(&ram_fs, drv, 1);
   }
+  if (res != FR_OK)
+    return -(int)res;
+  return 0;
+#else
+  return -(int)FR_INVALID_DRIVE;
+#endif
+}
 
-  if (fd == -1) {
+v_fd_t v_open(const char *path, int flags) {
+  uint32_t free_fds = ~fd_used & FD_ALL;
+  if (free_fds == 0)
     return -1;
-  }
+  int fd = __builtin_ctzl(free_fds); /* Lowest free descriptor */
 
+  /* V_O_RDWR is both access bits, so the access mode is a 2-bit field. */
   uint8_t mode = 0;
   if (flags & V_O_RDONLY)
     mode |= FA_READ;
   if (flags & V_O_WRONLY)
     mode |= FA_WRITE;
-  if (flags & V_O_RDWR)
-    mode |= (FA_READ | FA_WRITE);
   if (flags & V_O_CREAT)
     mode |= FA_OPEN_ALWAYS;
   if (flags & V_O_TRUNC)
@@ -64,30 +510,101 @@ v_fd_t v_open(const char *path, int flags) {
   if (flags & V_O_APPEND)
     mode |= FA_OPEN_APPEND;
 
-  FRESULT res = f_open(&open_files[fd], path, mode);
+  FRESULT res;
+#if V_FS_DCACHE
+  /* Appending seeks after the open, while the entry is still in the window
+   * for dcache_remember. */
+  uint8_t append = (mode & FA_OPEN_APPEND) == FA_OPEN_APPEND;
+  if (append)
+    mode = (uint8_t)((mode & ~FA_OPEN_APPEND) | FA_OPEN_ALWAYS);
+  uint64_t key = dcache_key(path);
+  if (!(mode & FA_CREATE_ALWAYS) && dcache_open(key, &open_files[fd], mode)) {
+    res = FR_OK;
+  } else {
+    res = f_open(&open_files[fd], path, mode);
+    if (res == FR_OK)
+      dcache_remember(key, &open_files[fd]);
+  }
+  if (res == FR_OK && append) {
+    res = f_lseek(&open_files[fd], f_size(&open_files[fd]));
+    if (res != FR_OK)
+      f_close(&open_files[fd]);
+  }
+#else
+  res = f_open(&open_files[fd], path, mode);
+#endif
   if (res != FR_OK) {
     return -(int)res;
   }
 
-  file_in_use[fd] = 1;
+#if V_FS_FASTSEEK
+  if (!(mode & FA_WRITE) || (flags & V_O_FASTSEEK)) {
+    res = clmt_build(fd);
+    if (res != FR_OK) {
+      f_close(&open_files[fd]);
+      return -(int)res;
+    }
+  }
+#endif
+
+#if V_FS_WRITE_BUFFER
+  if ((flags & V_O_BUFFERED) && (mode & FA_WRITE)) {
+    wbuf_t *wb = wbuf_of(-1); /* owner 0: a free slot */
+    if (wb != NULL) {
+      wb->owner = (uint8_t)(fd + 1);
+      wb->fill = 0;
+    }
+  }
+#endif
+
+  fd_used |= 1UL << fd;
   return fd;
 }
 
 int v_close(v_fd_t fd) {
-  if (fd < 0 || fd >= MAX_OPEN_FILES || !file_in_use[fd])
+  if (!fd_valid(fd))
     return -1;
-  FRESULT res = f_close(&open_files[fd]);
-  if (res == FR_OK) {
-    file_in_use[fd] = 0;
-    return 0;
+  FRESULT res = FR_OK;
+  stream_t *st = stream_of(fd);
+  if (st != NULL) {
+    res = stream_close(fd, st);
+    st->owner = 0;
   }
+#if V_FS_WRITE_BUFFER
+  wbuf_t *wb = wbuf_of(fd);
+  if (wb != NULL) {
+    /* The slot's next owner must not overwrite a write still in flight. */
+    res = wbuf_flush(fd, wb);
+    if (disk_write_release(open_files[fd].obj.fs->pdrv, wb->buf,
+                           sizeof(wb->buf)) != RES_OK &&
+        res == FR_OK)
+      res = FR_DISK_ERR;
+    wb->owner = 0;
+  }
+#endif
+  FRESULT cres = f_close(&open_files[fd]);
+  if (res == FR_OK)
+    res = cres;
+  if (cres == FR_OK)
+    fd_used &= ~(1UL << fd);
+  if (res == FR_OK)
+    return 0;
   return -(int)res;
 }
 
 int v_read(v_fd_t fd, void *buf, size_t count) {
-  if (fd < 0 || fd >= MAX_OPEN_FILES || !file_in_use[fd])
+  if (!fd_valid(fd))
     return -1;
 
+#if V_FS_WRITE_BUFFER
+  wbuf_t *wb = wbuf_of(fd);
+  if (wb != NULL) {
+    FRESULT wres = wbuf_flush(fd, wb);
+    if (wres != FR_OK)
+      return -(int)wres;
+  }
+#endif
+
   unsigned int br;
   FRESULT res = f_read(&open_files[fd], buf, (unsigned int)count, &br);
   if (res == FR_OK)
@@ -96,9 +613,23 @@ int v_read(v_fd_t fd, void *buf, size_t count) {
 }
 
 int v_write(v_fd_t fd, const void *buf, size_t count) {
-  if (fd < 0 || fd >= MAX_OPEN_FILES || !file_in_use[fd])
+  if (!fd_valid(fd))
     return -1;
 
+  stream_t *st = stream_of(fd);
+  if (st != NULL)
+    return stream_write(fd, st, (const BYTE *)buf, count);
+
+#if V_FS_WRITE_BUFFER
+  wbuf_t *wb = wbuf_of(fd);
+  if (wb != NULL)
+    return wbuf_write(fd, wb, (const BYTE *)buf, count);
+#endif
+
+#if V_FS_FASTSEEK
+  clmt_release(fd, f_tell(&open_files[fd]) + count);
+#endif
+
   unsigned int bw;
   FRESULT res = f_write(&open_files[fd], buf, (unsigned int)count, &bw);
   if (res == FR_OK)
@@ -106,28 +637,54 @@ int v_write(v_fd_t fd, const void *buf, size_t count) {
   return -(int)res;
 }
 
-long v_lseek(v_fd_t fd, long offset, int whence) {
-  if (fd < 0 || fd >= MAX_OPEN_FILES || !file_in_use[fd])
+v_off_t v_lseek(v_fd_t fd, v_off_t offset, int whence) {
+  if (!fd_valid(fd))
     return -1;
 
-  uint32_t target_pos = 0;
+  const stream_t *st = stream_of(fd);
+  if (st != NULL) /* Append only: the position can be read, not moved */
+    return (whence == V_SEEK_CUR && offset == 0) ? (v_off_t)st->pos
+                                                 : -(v_off_t)FR_DENIED;
+
+#if V_FS_WRITE_BUFFER
+  wbuf_t *wb = wbuf_of(fd);
+  if (wb != NULL) {
+    if (whence == V_SEEK_CUR && offset == 0)
+      return (v_off_t)(f_tell(&open_files[fd]) + wb->fill);
+    FRESULT wres = wbuf_flush(fd, wb);
+    if (wres != FR_OK)
+      return -(int)wres;
+  }
+#endif
+
+  FSIZE_t base;
   switch (whence) {
   case V_SEEK_SET:
-    target_pos = (uint32_t)offset;
+    base = 0;
     break;
   case V_SEEK_CUR:
-    target_pos = f_tell(&open_files[fd]) + (uint32_t)offset;
+    base = f_tell(&open_files[fd]);
     break;
   case V_SEEK_END:
-    target_pos = f_size(&open_files[fd]) + (uint32_t)offset;
+    base = f_size(&open_files[fd]);
     break;
   default:
     return -1;
   }
+  FSIZE_t target_pos;
+  if (!off_add(base, offset, &target_pos))
+    return -(v_off_t)FR_INVALID_PARAMETER;
+
+#if V_FS_FASTSEEK
+  /* Fast seek clips at the file size, where a writable file would grow. */
+  if ((open_files[fd].flag & FA_WRITE) &&
+      target_pos > f_size(&open_files[fd]))
+    open_files[fd].cltbl = NULL;
+#endif
 
   FRESULT res = f_lseek(&open_files[fd], target_pos);
   if (res == FR_OK)
-    return (long)f_tell(&open_files[fd]);
+    return (v_off_t)f_tell(&open_files[fd]);
   return -(int)res;
 }
 
@@ -139,6 +696,9 @@ int v_mkdir(const char *path) {
 }
 
 int v_unlink(const char *path) {
+#if V_FS_DCACHE
+  dcache_flush();
+#endif
   FRESULT res = f_unlink(path);
   if (res == FR_OK)
     return 0;
@@ -146,16 +706,71 @@ int v_unlink(const char *path) {
 }
 
 int v_sync(v_fd_t fd) {
-  if (fd < 0 || fd >= MAX_OPEN_FILES || !file_in_use[fd])
+  if (!fd_valid(fd))
     return -1;
 
-  FRESULT res = f_sync(&open_files[fd]);
+  FRESULT res;
+  const stream_t *st = stream_of(fd);
+  if (st != NULL) {
+    /* Data only: the directory entry keeps the reserved size until close. */
+    res = stream_flush(&open_files[fd], st);
+    if (res == FR_OK &&
+        disk_ioctl(open_files[fd].obj.fs->pdrv, CTRL_SYNC, NULL) != RES_OK)
+      res = FR_DISK_ERR;
+  } else {
+    res = FR_OK;
+#if V_FS_WRITE_BUFFER
+    wbuf_t *wb = wbuf_of(fd);
+    if (wb != NULL)
+      res = wbuf_flush(fd, wb);
+#endif
+    if (res == FR_OK)
+      res = f_sync(&open_files[fd]);
+  }
   if (res == FR_OK)
     return 0;
   return -(int)res;
 }
 
-int v_preallocate(const char *path, uint32_t size) {
+v_fd_t v_open_stream(const char *path, v_size_t size) {
+  FSIZE_t cap;
+  if (size == 0 || !size_ok(size, &cap))
+    return -(int)FR_INVALID_PARAMETER;
+  stream_t *st = stream_of(-1); /* owner 0: a free slot */
+  if (st == NULL)
+    return -1;
+
+  v_fd_t fd = v_open(path, V_O_WRONLY | V_O_CREAT | V_O_TRUNC);
+  if (fd < 0)
+    return fd;
+
+  /* One contiguous run of clusters, allocated and on the card before any
+   * data: from here on nothing in the FAT or the directory changes until
+   * v_close. */
+  FIL *fp = &open_files[fd];
+  FRESULT res = f_expand(fp, cap, 1);
+  if (res == FR_OK)
+    res = f_sync(fp);
+  if (res != FR_OK) {
+    f_close(fp);
+    fd_used &= ~(1UL << fd);
+    v_unlink(path);
+    return -(int)res;
+  }
+
+  const FATFS *fs = fp->obj.fs;
+  st->owner = (uint8_t)(fd + 1);
+  st->lba = fs->database + (LBA_t)fs->csize * (fp->obj.sclust - 2U);
+  st->cap = cap;
+  st->pos = 0;
+  return fd;
+}
+
+int v_preallocate(const char *path, v_size_t size) {
+  FSIZE_t cap;
+  if (!size_ok(size, &cap))
+    return -(int)FR_INVALID_PARAMETER;
+
   /* Only create the file if it does not already exist.
    * FA_CREATE_NEW returns FR_EXIST when the file is present —
    * meaning we already pre-allocated it on a previous boot. */
@@ -166,20 +781,14 @@ int v_preallocate(const char *path, uint32_t size) {
   if (res != FR_OK)
     return -(int)res;
 
-  /* Fill the file with zeros sector by sector.
-   * This commits the full FAT cluster chain to the card NOW, at boot.
-   * Subsequent writes seek in-place — no FAT modification needed. */
-  static const uint8_t zero_buf[512] = {0};
-  uint32_t remaining = size;
-  while (remaining > 0) {
-    UINT chunk = (remaining < sizeof(zero_buf)) ? remaining : sizeof(zero_buf);
-    UINT bw = 0;
-    res = f_write(&fil, zero_buf, chunk, &bw);
-    if (res != FR_OK || bw != chunk) {
-      f_close(&fil);
-      return (res != FR_OK) ? -(int)res : -1;
-    }
-    remaining -= bw;
+  /* Reserve one contiguous run of clusters and commit the FAT chain and
+   * the full size to the card now, at boot. Subsequent writes seek
+   * in-place — no FAT modification needed. */
+  res = cap > 0 ? f_expand(&fil, cap, 1) : FR_OK;
+  if (res != FR_OK) {
+    f_close(&fil);
+    v_unlink(path);
+    return -(int)res;
   }
 
   /* Flush FAT + directory entry before closing */
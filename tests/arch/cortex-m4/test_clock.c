@@ -17,6 +17,7 @@
 
 #include "test_clock.h"
 #include "navhal_port_clock.h"
+#include "family/flash_reg.h"
 #include "family/rcc_reg.h"
 #include "navhal_port_uart.h"
 #include "navtest/navtest.h"
@@ -160,6 +161,27 @@ void test_hal_clock_get_apb2clk_returns_correct_value(void) {
   TEST_ASSERT_EQUAL_UINT32(expected, result);
 }
 
+/* -------------------- Flash accelerators -------------------- */
+#define ACCEL_BITS (FLASH_ACR_PRFTEN | FLASH_ACR_ICEN | FLASH_ACR_DCEN)
+
+void test_hal_clock_init_enables_flash_accel(void) {
+  hal_clock_config_t cfg = {.source = HAL_CLOCK_SOURCE_HSI};
+  wait_uart_empty();
+  hal_clock_init(&cfg, NULL);
+  hal_uart_init(HAL_UART_2, &(hal_uart_config_t){.baudrate=9600});
+  TEST_ASSERT_EQUAL_UINT32(ACCEL_BITS, FLASH_ACR & ACCEL_BITS);
+}
+
+void test_hal_clock_set_accel_opt_out(void) {
+  hal_clock_set_accel(HAL_CLOCK_ACCEL_NO_DCACHE);
+  uint32_t partial = FLASH_ACR & ACCEL_BITS;
+  hal_clock_set_accel(HAL_CLOCK_ACCEL_NONE);
+  uint32_t none = FLASH_ACR & ACCEL_BITS;
+  hal_clock_set_accel(0);
+  TEST_ASSERT_EQUAL_UINT32(FLASH_ACR_PRFTEN | FLASH_ACR_ICEN, partial);
+  TEST_ASSERT_EQUAL_UINT32(0u, none);
+}
+
 /* -------------------- Status-return contract -------------------- */
 
 void test_hal_clock_init_returns_ok_for_hsi(void) {
@@ -196,6 +218,8 @@ NAVTEST_CASE_DECL(test_hal_clock_get_sysclk_returns_correct_value_pll);
 NAVTEST_CASE_DECL(test_hal_clock_get_ahbclk_returns_correct_value);
 NAVTEST_CASE_DECL(test_hal_clock_get_apb1clk_returns_correct_value);
 NAVTEST_CASE_DECL(test_hal_clock_get_apb2clk_returns_correct_value);
+NAVTEST_CASE_DECL(test_hal_clock_init_enables_flash_accel);
+NAVTEST_CASE_DECL(test_hal_clock_set_accel_opt_out);
 NAVTEST_CASE_DECL(test_hal_clock_init_returns_ok_for_hsi);
 NAVTEST_CASE_DECL(test_hal_clock_init_rejects_null_cfg);
 NAVTEST_CASE_DECL(test_hal_clock_init_pll_rejects_null_pll_cfg);
@@ -211,6 +235,8 @@ static const navtest_case_t clock_cases[] = {
     NAVTEST_CASE(test_hal_clock_get_ahbclk_returns_correct_value),
     NAVTEST_CASE(test_hal_clock_get_apb1clk_returns_correct_value),
     NAVTEST_CASE(test_hal_clock_get_apb2clk_returns_correct_value),
+    NAVTEST_CASE(test_hal_clock_init_enables_flash_accel),
+    NAVTEST_CASE(test_hal_clock_set_accel_opt_out),
     /* status-return contract — success + error paths */
     NAVTEST_CASE(test_hal_clock_init_returns_ok_for_hsi),
     NAVTEST_CASE(test_hal_clock_init_rejects_null_cfg),
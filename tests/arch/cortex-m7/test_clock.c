@@ -27,6 +27,8 @@
 
 #include "test_clock.h"
 #include "navhal_port_clock.h"
+#include "common/hal_cache.h"
+#include "family/flash_reg.h"
 #include "family/rcc_reg.h"
 #include "navhal_port_uart.h"
 #include "family/uart_reg.h"
@@ -124,6 +126,32 @@ void test_hal_clock_get_apb2clk_returns_correct_value(void) {
   TEST_ASSERT_EQUAL_UINT32(expected, result);
 }
 
+/* -------------------- Flash accelerators -------------------- */
+#define ACCEL_BITS (FLASH_ACR_PRFTEN | FLASH_ACR_ARTEN)
+
+void test_hal_clock_init_enables_flash_accel(void) {
+  hal_clock_config_t cfg = {.source = HAL_CLOCK_SOURCE_HSI};
+  wait_uart_empty();
+  hal_clock_init(&cfg, NULL);
+  reinit_console();
+  TEST_ASSERT_EQUAL_UINT32(ACCEL_BITS, FLASH_ACR & ACCEL_BITS);
+#if NAVHAL_HAS_CACHE
+  TEST_ASSERT_TRUE(hal_cache_dcache_enabled());
+#endif
+}
+
+void test_hal_clock_set_accel_opt_out(void) {
+  hal_clock_set_accel(HAL_CLOCK_ACCEL_NO_ICACHE | HAL_CLOCK_ACCEL_NO_DCACHE);
+  uint32_t partial = FLASH_ACR & ACCEL_BITS;
+  bool dcache = hal_cache_dcache_enabled();
+  hal_clock_set_accel(HAL_CLOCK_ACCEL_NONE);
+  uint32_t none = FLASH_ACR & ACCEL_BITS;
+  hal_clock_set_accel(0);
+  TEST_ASSERT_EQUAL_UINT32(FLASH_ACR_PRFTEN, partial);
+  TEST_ASSERT_FALSE(dcache);
+  TEST_ASSERT_EQUAL_UINT32(0u, none);
+}
+
 /* -------------------- Status-return contract -------------------- */
 void test_hal_clock_init_returns_ok_for_hsi(void) {
   hal_clock_config_t cfg = {.source = HAL_CLOCK_SOURCE_HSI};
@@ -151,6 +179,8 @@ NAVTEST_CASE_DECL(test_hal_clock_get_sysclk_returns_correct_value_pll);
 NAVTEST_CASE_DECL(test_hal_clock_get_ahbclk_returns_correct_value);
 NAVTEST_CASE_DECL(test_hal_clock_get_apb1clk_returns_correct_value);
 NAVTEST_CASE_DECL(test_hal_clock_get_apb2clk_returns_correct_value);
+NAVTEST_CASE_DECL(test_hal_clock_init_enables_flash_accel);
+NAVTEST_CASE_DECL(test_hal_clock_set_accel_opt_out);
 NAVTEST_CASE_DECL(test_hal_clock_init_returns_ok_for_hsi);
 NAVTEST_CASE_DECL(test_hal_clock_init_rejects_null_cfg);
 NAVTEST_CASE_DECL(test_hal_clock_init_pll_rejects_null_pll_cfg);
@@ -164,6 +194,8 @@ static const navtest_case_t clock_cases[] = {
     NAVTEST_CASE(test_hal_clock_get_ahbclk_returns_correct_value),
     NAVTEST_CASE(test_hal_clock_get_apb1clk_returns_correct_value),
     NAVTEST_CASE(test_hal_clock_get_apb2clk_returns_correct_value),
+    NAVTEST_CASE(test_hal_clock_init_enables_flash_accel),
+    NAVTEST_CASE(test_hal_clock_set_accel_opt_out),
     /* status-return contract — success + error paths */
     NAVTEST_CASE(test_hal_clock_init_returns_ok_for_hsi),
     NAVTEST_CASE(test_hal_clock_init_rejects_null_cfg),
@@ -38,6 +38,10 @@ void test_hal_clock_get_ahbclk_returns_correct_value(void);
 void test_hal_clock_get_apb1clk_returns_correct_value(void);
 void test_hal_clock_get_apb2clk_returns_correct_value(void);
 
+// -------------------- Flash accelerators --------------------
+void test_hal_clock_init_enables_flash_accel(void);
+void test_hal_clock_set_accel_opt_out(void);
+
 // -------------------- Status-return contract --------------------
 void test_hal_clock_init_returns_ok_for_hsi(void);
 void test_hal_clock_init_rejects_null_cfg(void);
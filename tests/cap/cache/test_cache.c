@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file tests/cap/cache/test_cache.c
+ * @brief L1 cache maintenance and cache-coherent DMA tests for NavTest.
+ */
+
+#include "test_cache.h"
+#include "common/hal_cache.h"
+#include "common/hal_features.h"
+#include "navtest/navtest.h"
+#include "navtest/navtest_pil.h"
+#include <stdint.h>
+
+#if NAVHAL_HAS_CACHE
+#if NAVHAL_HAS_DMA
+#include "navhal_port_dma.h"
+#endif
+
+static uint8_t src_buf[HAL_CACHE_ALIGN_UP(100)] NAVHAL_DMA_BUFFER;
+static uint8_t dst_buf[HAL_CACHE_ALIGN_UP(100)] NAVHAL_DMA_BUFFER;
+
+void test_cache_dcache_enable_disable(void) {
+  hal_cache_dcache_enable();
+  TEST_ASSERT_TRUE(hal_cache_dcache_enabled());
+  hal_cache_dcache_disable();
+  TEST_ASSERT_FALSE(hal_cache_dcache_enabled());
+}
+
+void test_cache_dma_buffer_attribute_aligns(void) {
+  TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)(uintptr_t)src_buf %
+                                  HAL_CACHE_LINE_SIZE);
+  TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)(uintptr_t)dst_buf %
+                                  HAL_CACHE_LINE_SIZE);
+  TEST_ASSERT_EQUAL_UINT32(32, HAL_CACHE_ALIGN_UP(1));
+  TEST_ASSERT_EQUAL_UINT32(64, HAL_CACHE_ALIGN_UP(33));
+}
+
+void test_cache_range_ops_with_dcache_off(void) {
+  hal_cache_dcache_disable();
+  src_buf[0] = 0x5A;
+  hal_cache_clean_range(src_buf, sizeof(src_buf));
+  hal_cache_invalidate_range(src_buf, sizeof(src_buf));
+  hal_cache_clean_invalidate_range(src_buf, sizeof(src_buf));
+  TEST_ASSERT_EQUAL_UINT32(0x5A, src_buf[0]);
+}
+
+void test_cache_dma_m2m_coherent_with_dcache_on(void) {
+#if NAVHAL_HAS_DMA
+  NAVTEST_SKIP_ON_PIL();
+  hal_cache_dcache_enable();
+
+  /* Warm dst into the cache so a missing invalidate would show stale data,
+   * and leave the src pattern dirty so a missing clean would copy zeros. */
+  for (uint32_t i = 0; i < sizeof(dst_buf); i++)
+    dst_buf[i] = 0;
+  for (uint32_t i = 0; i < sizeof(src_buf); i++)
+    src_buf[i] = (uint8_t)(i * 7U + 1U);
+
+  hal_dma_config_t cfg = {
+      .controller = HAL_DMA_CONTROLLER_2,
+      .stream = 0,
+      .channel = 0,
+      .direction = HAL_DMA_DIR_M2M,
+      .src_addr = (uint32_t)(uintptr_t)src_buf,
+      .dst_addr = (uint32_t)(uintptr_t)dst_buf,
+      .data_count = sizeof(src_buf),
+      .src_inc = 1,
+      .dst_inc = 1,
+      .data_width = HAL_DMA_DATA_WIDTH_8,
+      .priority = HAL_DMA_PRIORITY_LOW,
+      .fifo_mode = 1,
+  };
+  hal_dma_init(&cfg);
+  hal_dma_start(&cfg);
+  uint32_t spin = 0;
+  while (!hal_dma_transfer_complete(&cfg) && spin++ < 1000000U)
+    ;
+
+  uint32_t mismatches = 0;
+  for (uint32_t i = 0; i < sizeof(dst_buf); i++)
+    if (dst_buf[i] != (uint8_t)(i * 7U + 1U))
+      mismatches++;
+  hal_cache_dcache_disable();
+  TEST_ASSERT_EQUAL_UINT32(0, mismatches);
+#else
+  TEST_ASSERT_TRUE(1);
+#endif
+}
+
+void test_cache_dma_alloc_returns_whole_lines(void) {
+#if NAVHAL_HAS_DMA
+  uint8_t *a = hal_dma_alloc(10);
+  uint8_t *b = hal_dma_alloc(10);
+  TEST_ASSERT_NOT_NULL(a);
+  TEST_ASSERT_NOT_NULL(b);
+  TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)(uintptr_t)a % HAL_CACHE_LINE_SIZE);
+  TEST_ASSERT_EQUAL_UINT32(HAL_CACHE_LINE_SIZE, (uint32_t)(b - a));
+  TEST_ASSERT_TRUE(hal_dma_alloc(0) == NULL);
+#else
+  TEST_ASSERT_TRUE(1);
+#endif
+}
+
+void test_hal_cache_mpu_rejects_bad_region(void) {
+  /* Size not a power of two, base not aligned to size, region out of range. */
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_ERR_INVALID_ARG,
+                           (uint32_t)hal_cache_mpu_noncacheable(
+                               0, 0x20000000, 48));
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_ERR_INVALID_ARG,
+                           (uint32_t)hal_cache_mpu_noncacheable(
+                               0, 0x20000020, 64));
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_ERR_INVALID_ARG,
+                           (uint32_t)hal_cache_mpu_noncacheable(
+                               255, 0x20000000, 64));
+}
+/* PROGMEM slot for each case name on AVR; no-op elsewhere. */
+NAVTEST_CASE_DECL(test_cache_dcache_enable_disable);
+NAVTEST_CASE_DECL(test_cache_dma_buffer_attribute_aligns);
+NAVTEST_CASE_DECL(test_cache_range_ops_with_dcache_off);
+NAVTEST_CASE_DECL(test_cache_dma_m2m_coherent_with_dcache_on);
+NAVTEST_CASE_DECL(test_cache_dma_alloc_returns_whole_lines);
+NAVTEST_CASE_DECL(test_hal_cache_mpu_rejects_bad_region);
+
+
+static const navtest_case_t cache_cases[] = {
+    NAVTEST_CASE(test_cache_dcache_enable_disable),
+    NAVTEST_CASE(test_cache_dma_buffer_attribute_aligns),
+    NAVTEST_CASE(test_cache_range_ops_with_dcache_off),
+    NAVTEST_CASE(test_cache_dma_m2m_coherent_with_dcache_on),
+    NAVTEST_CASE(test_cache_dma_alloc_returns_whole_lines),
+    NAVTEST_CASE(test_hal_cache_mpu_rejects_bad_region),
+};
+
+const navtest_suite_t test_cache_suite = {
+    .name = "CACHE",
+    .cases = cache_cases,
+    .count = sizeof(cache_cases) / sizeof(cache_cases[0]),
+    .between = NULL,
+};
+
+#endif /* NAVHAL_HAS_CACHE */
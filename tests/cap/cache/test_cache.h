@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file tests/cap/cache/test_cache.h
+ * @brief L1 cache / cache-coherent DMA test declarations for NavTest.
+ */
+
+#ifndef TEST_CACHE_H
+#define TEST_CACHE_H
+
+#include "common/hal_features.h"
+#include "navtest/navtest.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#if NAVHAL_HAS_CACHE
+
+void test_cache_dcache_enable_disable(void);
+void test_cache_dma_buffer_attribute_aligns(void);
+void test_cache_range_ops_with_dcache_off(void);
+void test_cache_dma_m2m_coherent_with_dcache_on(void);
+void test_cache_dma_alloc_returns_whole_lines(void);
+void test_hal_cache_mpu_rejects_bad_region(void);
+
+extern const navtest_suite_t test_cache_suite;
+
+#endif /* NAVHAL_HAS_CACHE */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif // TEST_CACHE_H
@@ -173,6 +173,124 @@ void test_dma_clear_flags_clears_isr(void) {
   TEST_ASSERT_TRUE(1);
 }
 
+void test_dma_prepare_captures_stream_image(void) {
+  hal_dma_handle_t h;
+  dma_setUp();
+  test_cfg.channel = 2;
+  hal_dma_prepare(&test_cfg, &h);
+  TEST_ASSERT_EQUAL_UINT32(DMA1->STREAM[0].CR, h.cr);
+  TEST_ASSERT_EQUAL_UINT32(test_cfg.dst_addr, h.par);
+  TEST_ASSERT_BITS_LOW(DMA_SxCR_EN, h.cr);
+}
+
+void test_dma_restart_sets_address_and_count(void) {
+  hal_dma_handle_t h;
+  dma_setUp();
+  hal_dma_prepare(&test_cfg, &h);
+  hal_dma_restart(&h, 0x20000400, 32);
+  TEST_ASSERT_EQUAL_UINT32(0x20000400, DMA1->STREAM[0].M0AR);
+  TEST_ASSERT_EQUAL_UINT32(32, DMA1->STREAM[0].NDTR);
+  TEST_ASSERT_BITS_HIGH(DMA_SxCR_EN, DMA1->STREAM[0].CR);
+  hal_dma_stop(&test_cfg);
+}
+
+void test_dma_restart_restores_reconfigured_stream(void) {
+  hal_dma_handle_t h;
+  hal_dma_config_t other;
+  dma_setUp();
+  test_cfg.channel = 3;
+  hal_dma_prepare(&test_cfg, &h);
+
+  /* Another driver takes over the stream with a different channel. */
+  other = test_cfg;
+  other.channel = 5;
+  other.dst_addr = 0x40004404;
+  hal_dma_init(&other);
+
+  hal_dma_restart(&h, 0x20000400, 32);
+  uint32_t cr = DMA1->STREAM[0].CR;
+  TEST_ASSERT_EQUAL_UINT32(3, (cr & DMA_SxCR_CHSEL_MASK) >> DMA_SxCR_CHSEL_POS);
+  TEST_ASSERT_EQUAL_UINT32(0x40000000, DMA1->STREAM[0].PAR);
+  hal_dma_stop(&test_cfg);
+}
+
+/* -------------------- Descriptor chains -------------------- */
+
+static volatile uint32_t chain_done;
+static volatile hal_status_t chain_status;
+
+static void _chain_cb(hal_status_t status, void *ctx) {
+  chain_status = status;
+  chain_done = (uint32_t)(uintptr_t)ctx;
+}
+
+static void _chain_m2m_cfg(hal_dma_config_t *cfg) {
+  *cfg = (hal_dma_config_t){
+      .controller = HAL_DMA_CONTROLLER_2, /* only DMA2 can do M2M */
+      .stream = 0,
+      .channel = 0,
+      .direction = HAL_DMA_DIR_M2M,
+      .src_inc = 1,
+      .dst_inc = 1,
+      .data_width = HAL_DMA_DATA_WIDTH_8,
+      .priority = HAL_DMA_PRIORITY_LOW,
+      .fifo_mode = 1,
+  };
+}
+
+static int _chain_wait(void) {
+  for (uint32_t spin = 0; spin < 1000000U; spin++)
+    if (chain_done)
+      return 1;
+  return 0;
+}
+
+void test_dma_chain_runs_all_descriptors(void) {
+  NAVTEST_SKIP_ON_PIL();
+  static const uint8_t a[4] = {1, 2, 3, 4}, b[3] = {5, 6, 7}, c[2] = {8, 9};
+  static uint8_t out[9];
+  static hal_dma_chain_t chain;
+  hal_dma_config_t cfg;
+  _chain_m2m_cfg(&cfg);
+  hal_dma_chain_init(&chain, &cfg);
+
+  const hal_dma_desc_t desc[] = {
+      {(uint32_t)a, (uint32_t)&out[0], 4, 0},
+      {(uint32_t)b, (uint32_t)&out[4], 3, 0},
+      {(uint32_t)c, (uint32_t)&out[7], 2, 0},
+  };
+  chain_done = 0;
+  TEST_ASSERT_EQUAL_UINT32(HAL_OK, hal_dma_chain_start(&chain, desc, 3,
+                                                       _chain_cb, (void *)1));
+  TEST_ASSERT_TRUE(_chain_wait());
+  TEST_ASSERT_EQUAL_UINT32(HAL_OK, chain_status);
+  TEST_ASSERT_FALSE(hal_dma_chain_busy(&chain));
+  for (uint32_t i = 0; i < sizeof(out); i++)
+    TEST_ASSERT_EQUAL_UINT32(i + 1, out[i]);
+}
+
+void test_dma_chain_mem_fixed_repeats_destination(void) {
+  NAVTEST_SKIP_ON_PIL();
+  static const uint8_t src[4] = {0xA5, 0x11, 0x22, 0x33};
+  static uint8_t out[4];
+  static hal_dma_chain_t chain;
+  hal_dma_config_t cfg;
+  _chain_m2m_cfg(&cfg);
+  hal_dma_chain_init(&chain, &cfg);
+
+  /* In M2M the memory port is the destination: pinning it makes every
+   * source byte land on out[0], leaving the last one there. */
+  const hal_dma_desc_t desc[] = {
+      {(uint32_t)src, (uint32_t)out, 4, HAL_DMA_DESC_MEM_FIXED},
+  };
+  out[0] = out[1] = 0;
+  chain_done = 0;
+  hal_dma_chain_start(&chain, desc, 1, _chain_cb, (void *)1);
+  TEST_ASSERT_TRUE(_chain_wait());
+  TEST_ASSERT_EQUAL_UINT32(0x33, out[0]);
+  TEST_ASSERT_EQUAL_UINT32(0, out[1]);
+}
+
 /* -------------------- Standardized contract -------------------- */
 
 void test_hal_dma_init_rejects_null_config(void) {
@@ -189,6 +307,36 @@ void test_hal_dma_stop_rejects_null_config(void) {
   TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_ERR_INVALID_ARG,
                            (uint32_t)hal_dma_stop(NULL));
 }
+
+void test_hal_dma_prepare_rejects_null_args(void) {
+  hal_dma_handle_t h;
+  dma_setUp();
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_ERR_INVALID_ARG,
+                           (uint32_t)hal_dma_prepare(NULL, &h));
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_ERR_INVALID_ARG,
+                           (uint32_t)hal_dma_prepare(&test_cfg, NULL));
+}
+
+void test_hal_dma_restart_rejects_null_handle(void) {
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_ERR_INVALID_ARG,
+                           (uint32_t)hal_dma_restart(NULL, 0x20000000, 1));
+}
+
+void test_hal_dma_chain_start_rejects_empty_chain(void) {
+  static hal_dma_chain_t chain;
+  hal_dma_desc_t desc = {0x20000000, 0x20000100, 1, 0};
+  hal_dma_config_t cfg;
+  _chain_m2m_cfg(&cfg);
+  hal_dma_chain_init(&chain, &cfg);
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_ERR_INVALID_ARG,
+                           (uint32_t)hal_dma_chain_start(&chain, &desc, 0,
+                                                         NULL, NULL));
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_ERR_INVALID_ARG,
+                           (uint32_t)hal_dma_chain_start(&chain, NULL, 1,
+                                                         NULL, NULL));
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_ERR_INVALID_ARG,
+                           (uint32_t)hal_dma_chain_init(NULL, &cfg));
+}
 /* PROGMEM slot for each case name on AVR; no-op elsewhere. */
 NAVTEST_CASE_DECL(test_dma_clock_enable_dma1);
 NAVTEST_CASE_DECL(test_dma_clock_enable_dma2);
@@ -204,9 +352,17 @@ NAVTEST_CASE_DECL(test_dma_start_enables_stream);
 NAVTEST_CASE_DECL(test_dma_stop_disables_stream);
 NAVTEST_CASE_DECL(test_dma_transfer_complete_returns_zero_before_start);
 NAVTEST_CASE_DECL(test_dma_clear_flags_clears_isr);
+NAVTEST_CASE_DECL(test_dma_prepare_captures_stream_image);
+NAVTEST_CASE_DECL(test_dma_restart_sets_address_and_count);
+NAVTEST_CASE_DECL(test_dma_restart_restores_reconfigured_stream);
+NAVTEST_CASE_DECL(test_dma_chain_runs_all_descriptors);
+NAVTEST_CASE_DECL(test_dma_chain_mem_fixed_repeats_destination);
 NAVTEST_CASE_DECL(test_hal_dma_init_rejects_null_config);
 NAVTEST_CASE_DECL(test_hal_dma_start_rejects_null_config);
 NAVTEST_CASE_DECL(test_hal_dma_stop_rejects_null_config);
+NAVTEST_CASE_DECL(test_hal_dma_prepare_rejects_null_args);
+NAVTEST_CASE_DECL(test_hal_dma_restart_rejects_null_handle);
+NAVTEST_CASE_DECL(test_hal_dma_chain_start_rejects_empty_chain);
 
 
 static const navtest_case_t dma_cases[] = {
@@ -224,10 +380,18 @@ static const navtest_case_t dma_cases[] = {
     NAVTEST_CASE(test_dma_stop_disables_stream),
     NAVTEST_CASE(test_dma_transfer_complete_returns_zero_before_start),
     NAVTEST_CASE(test_dma_clear_flags_clears_isr),
+    NAVTEST_CASE(test_dma_prepare_captures_stream_image),
+    NAVTEST_CASE(test_dma_restart_sets_address_and_count),
+    NAVTEST_CASE(test_dma_restart_restores_reconfigured_stream),
+    NAVTEST_CASE(test_dma_chain_runs_all_descriptors),
+    NAVTEST_CASE(test_dma_chain_mem_fixed_repeats_destination),
     /* standardized contract */
     NAVTEST_CASE(test_hal_dma_init_rejects_null_config),
     NAVTEST_CASE(test_hal_dma_start_rejects_null_config),
     NAVTEST_CASE(test_hal_dma_stop_rejects_null_config),
+    NAVTEST_CASE(test_hal_dma_prepare_rejects_null_args),
+    NAVTEST_CASE(test_hal_dma_restart_rejects_null_handle),
+    NAVTEST_CASE(test_hal_dma_chain_start_rejects_empty_chain),
 };
 
 const navtest_suite_t test_dma_suite = {
@@ -47,9 +47,17 @@ void test_dma_start_enables_stream(void);
 void test_dma_stop_disables_stream(void);
 void test_dma_transfer_complete_returns_zero_before_start(void);
 void test_dma_clear_flags_clears_isr(void);
+void test_dma_prepare_captures_stream_image(void);
+void test_dma_restart_sets_address_and_count(void);
+void test_dma_restart_restores_reconfigured_stream(void);
+void test_dma_chain_runs_all_descriptors(void);
+void test_dma_chain_mem_fixed_repeats_destination(void);
 void test_hal_dma_init_rejects_null_config(void);
 void test_hal_dma_start_rejects_null_config(void);
 void test_hal_dma_stop_rejects_null_config(void);
+void test_hal_dma_prepare_rejects_null_args(void);
+void test_hal_dma_restart_rejects_null_handle(void);
+void test_hal_dma_chain_start_rejects_empty_chain(void);
 
 extern const navtest_suite_t test_dma_suite;
 
@@ -30,6 +30,7 @@
 
 #if NAVHAL_HAS_SDIO
 
+#include "common/hal_diskio.h"
 #include "navhal_port_sdio.h"
 #include "navtest/navtest.h"
 #include "navtest/navtest_pil.h"
@@ -42,17 +43,60 @@ void test_hal_sdio_init_rejects_null_config(void) {
 }
 
 void test_hal_sdio_read_block_rejects_null_buffer(void) {
-  /* Skipped: hal_sdio_read_block issues CMD17 and waits for the card to
-   * respond before returning, so on a board without an SD card present
-   * the call blocks regardless of the buffer argument. Add a pre-CMD17
-   * NULL guard in the driver to make this testable here. */
-  TEST_ASSERT_TRUE(1);
+  /* The buffer is validated before CMD17 is issued, so this returns at once
+   * even with no card on the bus. */
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_SDIO_ERROR,
+                           (uint32_t)hal_sdio_read_block(0, NULL));
 }
 
 void test_hal_sdio_write_block_rejects_null_buffer(void) {
-  /* Skipped: same as read_block — write_block issues CMD24 and waits
-   * for the card. Without a card, the call blocks regardless of args. */
-  TEST_ASSERT_TRUE(1);
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_SDIO_ERROR,
+                           (uint32_t)hal_sdio_write_block(0, NULL));
+}
+
+void test_hal_sdio_blocks_reject_bad_args(void) {
+  static uint32_t buf[512 / 4];
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_SDIO_ERROR,
+                           (uint32_t)hal_sdio_read_blocks(0, NULL, 2));
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_SDIO_ERROR,
+                           (uint32_t)hal_sdio_write_blocks(0, NULL, 2));
+  TEST_ASSERT_EQUAL_UINT32(
+      (uint32_t)HAL_SDIO_ERROR,
+      (uint32_t)hal_sdio_read_blocks(0, (uint8_t *)buf, 0));
+  TEST_ASSERT_EQUAL_UINT32(
+      (uint32_t)HAL_SDIO_ERROR,
+      (uint32_t)hal_sdio_write_blocks(0, (const uint8_t *)buf, 0));
+}
+
+void test_hal_sdio_wait_ready_idle(void) {
+  /* No write outstanding: nothing to confirm, so no CMD13 goes out and the
+   * call can't block on a missing card. Runs before the PIL round-trips,
+   * which leave a write pending. */
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_SDIO_OK,
+                           (uint32_t)hal_sdio_wait_ready());
+}
+
+#if NAVHAL_HAS_SDIO_DMA
+void test_hal_sdio_submit_rejects_bad_request(void) {
+  static uint32_t buf[512 / 4];
+  hal_sdio_request_t req = {.sector = 0, .buffer = NULL, .count = 1};
+
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_SDIO_ERROR,
+                           (uint32_t)hal_sdio_submit(NULL));
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_SDIO_ERROR,
+                           (uint32_t)hal_sdio_submit(&req));
+  req.buffer = (uint8_t *)buf;
+  req.count = 0;
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_SDIO_ERROR,
+                           (uint32_t)hal_sdio_submit(&req));
+  /* Nothing was queued. */
+  TEST_ASSERT_FALSE(hal_sdio_queue_busy());
+}
+#endif
+
+void test_hal_sdio_erase_rejects_bad_range(void) {
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_SDIO_ERROR,
+                           (uint32_t)hal_sdio_erase(10, 9));
 }
 
 void test_hal_sdio_get_sector_count_returns_value(void) {
@@ -95,6 +139,11 @@ void test_hal_sdio_block_roundtrip_pil(void) {
     return;
   }
 
+  /* Out of identification mode: default speed (<= 25 MHz) or High Speed
+   * (<= 50 MHz), never the 400 kHz handshake clock. */
+  uint32_t clk = hal_sdio_get_bus_clock();
+  TEST_ASSERT_TRUE(clk > 400000u && clk <= 50000000u);
+
   uint8_t wbuf[512];
   uint8_t rbuf[512];
   for (uint32_t i = 0; i < 512; i++) {
@@ -112,22 +161,117 @@ void test_hal_sdio_block_roundtrip_pil(void) {
     TEST_ASSERT_EQUAL_UINT32((uint32_t)wbuf[i], (uint32_t)rbuf[i]);
   }
 }
+/* PIL-only: the polled multi-block path (CMD25 + ACMD23, CMD18, CMD12)
+ * round-tripped through the Renode card, same skips as above. */
+void test_hal_sdio_multi_block_roundtrip_pil(void) {
+  NAVTEST_PIL_ONLY();
+
+  hal_sdio_config_t cfg = {.clock_div = 0, .bus_width = 0 /* 1-bit */};
+  if (hal_sdio_init(&cfg) != HAL_SDIO_OK ||
+      hal_sdio_card_init() != HAL_SDIO_OK) {
+    TEST_ASSERT_TRUE(1); /* no controller / card in this environment */
+    return;
+  }
+
+  enum { BLOCKS = 3 };
+  static uint32_t wbuf[BLOCKS * 512 / 4];
+  static uint32_t rbuf[BLOCKS * 512 / 4];
+  for (uint32_t i = 0; i < BLOCKS * 512 / 4; i++) {
+    wbuf[i] = i * 0x9E3779B9u;
+    rbuf[i] = 0;
+  }
+
+  const uint32_t sector = 0x80;
+  TEST_ASSERT_EQUAL_UINT32(
+      (uint32_t)HAL_SDIO_OK,
+      (uint32_t)hal_sdio_write_blocks(sector, (const uint8_t *)wbuf, BLOCKS));
+  TEST_ASSERT_EQUAL_UINT32(
+      (uint32_t)HAL_SDIO_OK,
+      (uint32_t)hal_sdio_read_blocks(sector, (uint8_t *)rbuf, BLOCKS));
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_SDIO_OK,
+                           (uint32_t)hal_sdio_wait_ready());
+
+  for (uint32_t i = 0; i < BLOCKS * 512 / 4; i++) {
+    TEST_ASSERT_EQUAL_UINT32(wbuf[i], rbuf[i]);
+  }
+}
+/* PIL-only: sector-at-a-time reads through hal_disk_read, as FatFs issues
+ * them for a sequential file read. With CONFIG_SDIO_READAHEAD these are
+ * served from the read-ahead window; a write into the window must not leave
+ * stale data behind. */
+void test_hal_disk_sequential_read_pil(void) {
+  NAVTEST_PIL_ONLY();
+
+  hal_sdio_config_t cfg = {.clock_div = 0, .bus_width = 0 /* 1-bit */};
+  if (hal_sdio_init(&cfg) != HAL_SDIO_OK ||
+      hal_sdio_card_init() != HAL_SDIO_OK) {
+    TEST_ASSERT_TRUE(1); /* no controller / card in this environment */
+    return;
+  }
+  hal_disk_initialize(0);
+
+  enum { BLOCKS = 12 };
+  static uint32_t wbuf[BLOCKS * 512 / 4];
+  static uint32_t rbuf[512 / 4];
+  for (uint32_t i = 0; i < BLOCKS * 512 / 4; i++)
+    wbuf[i] = i ^ 0xA5A50000u;
+
+  const uint32_t sector = 0xC0;
+  TEST_ASSERT_EQUAL_UINT32(
+      (uint32_t)HAL_DISK_RES_OK,
+      (uint32_t)hal_disk_write(0, (const uint8_t *)wbuf, sector, BLOCKS));
+
+  for (uint32_t b = 0; b < BLOCKS; b++) {
+    TEST_ASSERT_EQUAL_UINT32(
+        (uint32_t)HAL_DISK_RES_OK,
+        (uint32_t)hal_disk_read(0, (uint8_t *)rbuf, sector + b, 1));
+    for (uint32_t i = 0; i < 512 / 4; i++)
+      TEST_ASSERT_EQUAL_UINT32(wbuf[b * 128 + i], rbuf[i]);
+    if (b == 1) {
+      /* Rewrite a sector the window (if any) already holds. */
+      for (uint32_t i = 0; i < 512 / 4; i++)
+        wbuf[3 * 128 + i] = ~wbuf[3 * 128 + i];
+      TEST_ASSERT_EQUAL_UINT32(
+          (uint32_t)HAL_DISK_RES_OK,
+          (uint32_t)hal_disk_write(0, (const uint8_t *)&wbuf[3 * 128],
+                                   sector + 3, 1));
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_DISK_RES_OK,
+                           (uint32_t)hal_disk_ioctl(0, HAL_DISK_IO_SYNC, 0));
+}
 /* PROGMEM slot for each case name on AVR; no-op elsewhere. */
 NAVTEST_CASE_DECL(test_hal_sdio_init_rejects_null_config);
 NAVTEST_CASE_DECL(test_hal_sdio_read_block_rejects_null_buffer);
 NAVTEST_CASE_DECL(test_hal_sdio_write_block_rejects_null_buffer);
+NAVTEST_CASE_DECL(test_hal_sdio_blocks_reject_bad_args);
+NAVTEST_CASE_DECL(test_hal_sdio_wait_ready_idle);
+#if NAVHAL_HAS_SDIO_DMA
+NAVTEST_CASE_DECL(test_hal_sdio_submit_rejects_bad_request);
+#endif
+NAVTEST_CASE_DECL(test_hal_sdio_erase_rejects_bad_range);
 NAVTEST_CASE_DECL(test_hal_sdio_get_sector_count_returns_value);
 NAVTEST_CASE_DECL(test_hal_sdio_set_callback_smoke);
 NAVTEST_CASE_DECL(test_hal_sdio_block_roundtrip_pil);
+NAVTEST_CASE_DECL(test_hal_sdio_multi_block_roundtrip_pil);
+NAVTEST_CASE_DECL(test_hal_disk_sequential_read_pil);
 
 
 static const navtest_case_t sdio_cases[] = {
     NAVTEST_CASE(test_hal_sdio_init_rejects_null_config),
     NAVTEST_CASE(test_hal_sdio_read_block_rejects_null_buffer),
     NAVTEST_CASE(test_hal_sdio_write_block_rejects_null_buffer),
+    NAVTEST_CASE(test_hal_sdio_blocks_reject_bad_args),
+    NAVTEST_CASE(test_hal_sdio_wait_ready_idle),
+#if NAVHAL_HAS_SDIO_DMA
+    NAVTEST_CASE(test_hal_sdio_submit_rejects_bad_request),
+#endif
+    NAVTEST_CASE(test_hal_sdio_erase_rejects_bad_range),
     NAVTEST_CASE(test_hal_sdio_get_sector_count_returns_value),
     NAVTEST_CASE(test_hal_sdio_set_callback_smoke),
     NAVTEST_CASE(test_hal_sdio_block_roundtrip_pil),
+    NAVTEST_CASE(test_hal_sdio_multi_block_roundtrip_pil),
+    NAVTEST_CASE(test_hal_disk_sequential_read_pil),
 };
 
 const navtest_suite_t test_sdio_suite = {
@@ -39,9 +39,17 @@ extern "C" {
 void test_hal_sdio_init_rejects_null_config(void);
 void test_hal_sdio_read_block_rejects_null_buffer(void);
 void test_hal_sdio_write_block_rejects_null_buffer(void);
+void test_hal_sdio_blocks_reject_bad_args(void);
+void test_hal_sdio_wait_ready_idle(void);
+#if NAVHAL_HAS_SDIO_DMA
+void test_hal_sdio_submit_rejects_bad_request(void);
+#endif
+void test_hal_sdio_erase_rejects_bad_range(void);
 void test_hal_sdio_get_sector_count_returns_value(void);
 void test_hal_sdio_set_callback_smoke(void);
 void test_hal_sdio_block_roundtrip_pil(void);
+void test_hal_sdio_multi_block_roundtrip_pil(void);
+void test_hal_disk_sequential_read_pil(void);
 
 extern const navtest_suite_t test_sdio_suite;
 
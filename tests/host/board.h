@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file board.h (host stub)
+ * @brief The embedded build takes this from src/board/<board>/; the host
+ *        SD-over-SPI suite only needs the SD card wiring that sd_spi.c reads,
+ *        with chip-select on a pin of the simulated GPIO block.
+ */
+#ifndef NAVHAL_BOARD_HOST_H
+#define NAVHAL_BOARD_HOST_H
+
+#include "utils/gpio_types.h"
+#include "utils/spi_types.h"
+
+#define BOARD_SD_SPI_BUS            HAL_SPI_1
+#define BOARD_SD_SPI_CS             GPIO_PA04
+#define BOARD_SD_SPI_FAST_BAUDRATE  HAL_SPI_BAUDRATE_DIV4
+
+#endif /* NAVHAL_BOARD_HOST_H */
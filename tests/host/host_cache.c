@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file host_cache.c
+ * @brief Cache driver stand-in for the host suites; see host_cache.h.
+ */
+
+#include "host_cache.h"
+#include "common/hal_cache.h"
+#include <string.h>
+
+static bool s_dcache;
+static host_cache_stats_t s_stats;
+
+void hal_cache_icache_enable(void) {}
+
+void hal_cache_icache_disable(void) {}
+
+void hal_cache_dcache_enable(void) { s_dcache = true; }
+
+void hal_cache_dcache_disable(void) { s_dcache = false; }
+
+bool hal_cache_dcache_enabled(void) { return s_dcache; }
+
+void hal_cache_clean_range(const void *addr, size_t len) {
+  (void)addr;
+  (void)len;
+  s_stats.cleans++;
+}
+
+void hal_cache_invalidate_range(const void *addr, size_t len) {
+  uintptr_t start = (uintptr_t)addr;
+  s_stats.invalidates++;
+  s_stats.last_invalidate = start;
+  if ((start | len) & (HAL_CACHE_LINE_SIZE - 1U))
+    s_stats.split_invalidates++;
+}
+
+void hal_cache_clean_invalidate_range(const void *addr, size_t len) {
+  (void)addr;
+  (void)len;
+  s_stats.clean_invalidates++;
+}
+
+hal_status_t hal_cache_mpu_noncacheable(uint8_t region, uintptr_t base,
+                                        size_t size) {
+  (void)region;
+  (void)base;
+  (void)size;
+  return HAL_OK;
+}
+
+host_cache_stats_t host_cache_stats(void) { return s_stats; }
+
+void host_cache_reset_stats(void) { memset(&s_stats, 0, sizeof(s_stats)); }
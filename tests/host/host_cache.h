@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file host_cache.h
+ * @brief Stand-in for the Cortex-M7 cache driver (cache.c) on the host.
+ *
+ * @details
+ * The host has no cache to maintain, so this only records what the drivers
+ * ask of one: the D-cache enable state (::hal_cache_dcache_enabled answers
+ * from it, so the drivers take their cache-on paths) and every range
+ * operation. An invalidate that starts or ends inside a 32-byte line is
+ * counted separately: on silicon it would also discard whatever the CPU
+ * had stored in the rest of that line.
+ */
+#ifndef HOST_CACHE_H
+#define HOST_CACHE_H
+
+#include <stdint.h>
+
+/** @brief Range operations since the last ::host_cache_reset_stats. */
+typedef struct {
+  uint32_t cleans;             /**< hal_cache_clean_range calls */
+  uint32_t invalidates;        /**< hal_cache_invalidate_range calls */
+  uint32_t clean_invalidates;  /**< hal_cache_clean_invalidate_range calls */
+  uint32_t split_invalidates;  /**< Invalidates of a partly covered line */
+  uintptr_t last_invalidate;   /**< Start of the latest invalidate */
+} host_cache_stats_t;
+
+/** @brief Counters since start-up or the last ::host_cache_reset_stats. */
+host_cache_stats_t host_cache_stats(void);
+
+/** @brief Zero the counters. */
+void host_cache_reset_stats(void);
+
+#endif /* HOST_CACHE_H */
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file host_disk_file.c
+ * @brief hal_disk_* on a host disk image file (see host_disk_file.h).
+ *
+ * Trimmed sectors are punched out of the file, so an image churned by many
+ * create/delete cycles stays sparse; where the file system cannot punch
+ * holes they simply keep their data, which a trim allows.
+ */
+
+#define _GNU_SOURCE /* fallocate */
+#include "host_disk_file.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SS 512U
+
+static struct {
+  int fd; /* -1 = no disk */
+  hal_disk_status_t stat;
+  host_disk_file_config_t cfg;
+  host_disk_file_stats_t stats;
+} disk = {.fd = -1, .stat = HAL_DISK_STATUS_NOINIT | HAL_DISK_STATUS_NODISK};
+
+/* Charge a command to the virtual clock, and to the real one if asked. */
+static void charge(uint32_t per_sector_us, uint32_t count) {
+  uint64_t us = disk.cfg.cmd_us + (uint64_t)per_sector_us * count;
+  disk.stats.busy_us += us;
+  if (disk.cfg.sleep && us != 0) {
+    struct timespec ts = {.tv_sec = (time_t)(us / 1000000U),
+                          .tv_nsec = (long)(us % 1000000U) * 1000L};
+    while (nanosleep(&ts, &ts) != 0)
+      ;
+  }
+}
+
+static int in_range(hal_disk_lba_t sector, uint32_t count) {
+  return count != 0U && sector < disk.cfg.sectors &&
+         count <= disk.cfg.sectors - sector;
+}
+
+static hal_disk_result_t ready(uint8_t pdrv) {
+  if (pdrv != 0)
+    return HAL_DISK_RES_PARERR;
+  if (disk.stat & HAL_DISK_STATUS_NOINIT)
+    return HAL_DISK_RES_NOTRDY;
+  return HAL_DISK_RES_OK;
+}
+
+/* ---- hal_disk_* --------------------------------------------------------- */
+
+hal_disk_status_t hal_disk_initialize(uint8_t pdrv) {
+  if (pdrv != 0)
+    return HAL_DISK_STATUS_NOINIT;
+  if (disk.fd >= 0)
+    disk.stat = HAL_DISK_STATUS_OK;
+  return disk.stat;
+}
+
+hal_disk_status_t hal_disk_status(uint8_t pdrv) {
+  return pdrv == 0 ? disk.stat : HAL_DISK_STATUS_NOINIT;
+}
+
+hal_disk_result_t hal_disk_read(uint8_t pdrv, uint8_t *buff,
+                                hal_disk_lba_t sector, uint32_t count) {
+  hal_disk_result_t res = ready(pdrv);
+  if (res != HAL_DISK_RES_OK)
+    return res;
+  if (buff == NULL || !in_range(sector, count))
+    return HAL_DISK_RES_PARERR;
+
+  size_t len = (size_t)count * SS;
+  ssize_t got = pread(disk.fd, buff, len, (off_t)sector * SS);
+  if (got < 0)
+    return HAL_DISK_RES_ERROR;
+  /* Past the end of a short image: never written, so zeros. */
+  memset(buff + got, 0, len - (size_t)got);
+
+  disk.stats.read_cmds++;
+  disk.stats.sectors_read += count;
+  charge(disk.cfg.read_us, count);
+  return HAL_DISK_RES_OK;
+}
+
+hal_disk_result_t hal_disk_write(uint8_t pdrv, const uint8_t *buff,
+                                 hal_disk_lba_t sector, uint32_t count) {
+  hal_disk_result_t res = ready(pdrv);
+  if (res != HAL_DISK_RES_OK)
+    return res;
+  if (buff == NULL || !in_range(sector, count))
+    return HAL_DISK_RES_PARERR;
+
+  size_t len = (size_t)count * SS;
+  if (pwrite(disk.fd, buff, len, (off_t)sector * SS) != (ssize_t)len)
+    return HAL_DISK_RES_ERROR;
+
+  disk.stats.write_cmds++;
+  disk.stats.sectors_written += count;
+  charge(disk.cfg.write_us, count);
+  return HAL_DISK_RES_OK;
+}
+
+hal_disk_result_t hal_disk_ioctl(uint8_t pdrv, uint8_t cmd, void *buff) {
+  hal_disk_result_t res = ready(pdrv);
+  if (res != HAL_DISK_RES_OK)
+    return res;
+
+  switch (cmd) {
+  case HAL_DISK_IO_SYNC:
+    /* The page cache is the disk here: nothing to wait for but the cost. */
+    disk.stats.syncs++;
+    charge(0, 0);
+    return HAL_DISK_RES_OK;
+  case HAL_DISK_IO_GET_SECTOR_COUNT:
+    *((hal_disk_lba_t *)buff) = disk.cfg.sectors;
+    return HAL_DISK_RES_OK;
+  case HAL_DISK_IO_GET_SECTOR_SIZE:
+    *((uint16_t *)buff) = SS;
+    return HAL_DISK_RES_OK;
+  case HAL_DISK_IO_GET_BLOCK_SIZE:
+    *((uint32_t *)buff) = disk.cfg.block ? disk.cfg.block : 1U;
+    return HAL_DISK_RES_OK;
+  case HAL_DISK_IO_TRIM: {
+    const hal_disk_lba_t *range = (const hal_disk_lba_t *)buff;
+    if (range[1] < range[0] || !in_range(range[0], 1) ||
+        !in_range(range[1], 1))
+      return HAL_DISK_RES_PARERR;
+    fallocate(disk.fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+              (off_t)range[0] * SS, (off_t)(range[1] - range[0] + 1U) * SS);
+    disk.stats.trims++;
+    return HAL_DISK_RES_OK;
+  }
+  default:
+    /* HAL_DISK_IO_WRITE_ASYNC included: every write completes in place. */
+    return HAL_DISK_RES_PARERR;
+  }
+}
+
+/* ---- Test API ----------------------------------------------------------- */
+
+bool host_disk_file_attach(const host_disk_file_config_t *cfg) {
+  if (!cfg || !cfg->sectors)
+    return false;
+  host_disk_file_detach();
+
+  int fd;
+  if (cfg->image) {
+    fd = open(cfg->image, O_RDWR | O_CREAT, 0644);
+  } else {
+    const char *dir = getenv("TMPDIR");
+    char path[256];
+    snprintf(path, sizeof(path), "%s/navhal-disk-XXXXXX",
+             dir && *dir ? dir : "/tmp");
+    fd = mkstemp(path);
+    if (fd >= 0)
+      unlink(path); /* Gone with the descriptor */
+  }
+  if (fd < 0)
+    return false;
+
+  /* Sized up front, sparse, so a new image mounts and reads as zeros. */
+  off_t size = (off_t)cfg->sectors * SS;
+  if (lseek(fd, 0, SEEK_END) < size && ftruncate(fd, size) != 0) {
+    close(fd);
+    return false;
+  }
+
+  disk.fd = fd;
+  disk.cfg = *cfg;
+  disk.stat = HAL_DISK_STATUS_NOINIT;
+  memset(&disk.stats, 0, sizeof(disk.stats));
+  return true;
+}
+
+void host_disk_file_detach(void) {
+  if (disk.fd >= 0)
+    close(disk.fd);
+  memset(&disk, 0, sizeof(disk));
+  disk.fd = -1;
+  disk.stat = HAL_DISK_STATUS_NOINIT | HAL_DISK_STATUS_NODISK;
+}
+
+host_disk_file_stats_t host_disk_file_stats(void) { return disk.stats; }
+
+void host_disk_file_reset_stats(void) {
+  memset(&disk.stats, 0, sizeof(disk.stats));
+}
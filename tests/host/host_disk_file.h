@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file host_disk_file.h
+ * @brief hal_disk_* backend on a host disk image file.
+ *
+ * @details
+ * Drive 0 is served straight from a file with pread/pwrite, so FatFs and
+ * v_fs run on the host without any card protocol in between — the SD
+ * models (host_sd.h, host_sd_spi.h) are for testing the drivers, this is
+ * for measuring what the filesystem layers ask of the disk. The image is
+ * a real FAT volume: it can be kept, inspected or mounted afterwards.
+ *
+ * Every command is charged a simulated latency, ::host_disk_file_config_t
+ * ::cmd_us plus a cost per sector, onto a virtual clock
+ * (::host_disk_file_stats_t::busy_us). That makes timing results
+ * reproducible across hosts; with ::host_disk_file_config_t::sleep the
+ * backend also sleeps it, for runs that must feel the delay in real time.
+ */
+#ifndef HOST_DISK_FILE_H
+#define HOST_DISK_FILE_H
+
+#include "common/hal_diskio.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief The disk to attach. */
+typedef struct {
+  const char *image; /**< Image file, created or extended to size; NULL
+                          for an unnamed temporary one */
+  uint32_t sectors;  /**< Capacity in 512-byte sectors */
+  uint32_t cmd_us;   /**< Simulated cost of each read, write or sync */
+  uint32_t read_us;  /**< ... plus this per sector read */
+  uint32_t write_us; /**< ... plus this per sector written */
+  uint32_t block;    /**< Erase block reported to FatFs, in sectors; 0 = 1 */
+  uint8_t sleep;     /**< 1 = also sleep the simulated latency */
+} host_disk_file_config_t;
+
+/** @brief Counters since attach or ::host_disk_file_reset_stats. */
+typedef struct {
+  uint32_t read_cmds;       /**< hal_disk_read calls that reached the file */
+  uint32_t write_cmds;      /**< hal_disk_write calls that reached the file */
+  uint32_t syncs;           /**< HAL_DISK_IO_SYNC requests */
+  uint32_t trims;           /**< HAL_DISK_IO_TRIM requests */
+  uint64_t sectors_read;    /**< Sectors the reads transferred */
+  uint64_t sectors_written; /**< Sectors the writes transferred */
+  uint64_t busy_us;         /**< Simulated time spent on all of them */
+} host_disk_file_stats_t;
+
+/**
+ * @brief Open the image as drive 0, not yet initialised. Existing contents
+ *        are kept; a new or short file reads as zeros.
+ * @return false for a bad configuration or a file that cannot be opened or
+ *         sized.
+ */
+bool host_disk_file_attach(const host_disk_file_config_t *cfg);
+
+/** @brief Close the image; drive 0 then reports ::HAL_DISK_STATUS_NODISK. */
+void host_disk_file_detach(void);
+
+/** @brief Counters since attach or the last ::host_disk_file_reset_stats. */
+host_disk_file_stats_t host_disk_file_stats(void);
+
+/** @brief Zero the counters. */
+void host_disk_file_reset_stats(void);
+
+#endif /* HOST_DISK_FILE_H */
@@ -15,17 +15,25 @@
  * limitations under the License.
  */
 
+#define _GNU_SOURCE /* REG_ERR / REG_EFL in ucontext_t */
 #include "host_mmio.h"
+#include "navhal_port_config.h"
+#include "navhal_port_interrupt.h"
+#include "family/dma_reg.h"
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
 
-/* APB1/APB2 + AHB1-GPIO live in 0x40000000..0x40023FFF on the F7 (RCC at
- * 0x40023800, flash interface at 0x40023C00, GPIO A.. at 0x40020000, USART/
- * SPI/I2C/TIM below). One mapping covers everything the drivers touch. */
+/* APB1/APB2 + AHB1 live in 0x40000000..0x400267FF on the F7 (DMA1/DMA2 at
+ * 0x40026000/0x40026400, RCC at 0x40023800, flash interface at 0x40023C00,
+ * GPIO A.. at 0x40020000, USART/SPI/I2C/TIM below). One mapping covers
+ * everything the drivers touch. */
 #define PERIPH_BASE 0x40000000UL
-#define PERIPH_SIZE 0x00024000UL
+#define PERIPH_SIZE 0x00027000UL
 
 /* On-chip flash — the flash driver programs/erases the KV-store sectors. */
 #define FLASH_BASE 0x08000000UL
@@ -41,15 +49,351 @@ static void map_fixed(uintptr_t addr, size_t size) {
   }
 }
 
+/* ---- Simulated DMA engine ----------------------------------------------- */
+
+/* The real stream vectors, defined by dma.c. */
+extern void DMA1_Stream0_IRQHandler(void);
+extern void DMA1_Stream1_IRQHandler(void);
+extern void DMA1_Stream2_IRQHandler(void);
+extern void DMA1_Stream3_IRQHandler(void);
+extern void DMA1_Stream4_IRQHandler(void);
+extern void DMA1_Stream5_IRQHandler(void);
+extern void DMA1_Stream6_IRQHandler(void);
+extern void DMA1_Stream7_IRQHandler(void);
+extern void DMA2_Stream0_IRQHandler(void);
+extern void DMA2_Stream1_IRQHandler(void);
+extern void DMA2_Stream2_IRQHandler(void);
+extern void DMA2_Stream3_IRQHandler(void);
+extern void DMA2_Stream4_IRQHandler(void);
+extern void DMA2_Stream5_IRQHandler(void);
+extern void DMA2_Stream6_IRQHandler(void);
+extern void DMA2_Stream7_IRQHandler(void);
+
+static const struct {
+  void (*handler)(void);
+  hal_irq_t irqn;
+} _dma_vectors[16] = {
+    {DMA1_Stream0_IRQHandler, DMA1_Stream0_IRQn},
+    {DMA1_Stream1_IRQHandler, DMA1_Stream1_IRQn},
+    {DMA1_Stream2_IRQHandler, DMA1_Stream2_IRQn},
+    {DMA1_Stream3_IRQHandler, DMA1_Stream3_IRQn},
+    {DMA1_Stream4_IRQHandler, DMA1_Stream4_IRQn},
+    {DMA1_Stream5_IRQHandler, DMA1_Stream5_IRQn},
+    {DMA1_Stream6_IRQHandler, DMA1_Stream6_IRQn},
+    {DMA1_Stream7_IRQHandler, DMA1_Stream7_IRQn},
+    {DMA2_Stream0_IRQHandler, DMA2_Stream0_IRQn},
+    {DMA2_Stream1_IRQHandler, DMA2_Stream1_IRQn},
+    {DMA2_Stream2_IRQHandler, DMA2_Stream2_IRQn},
+    {DMA2_Stream3_IRQHandler, DMA2_Stream3_IRQn},
+    {DMA2_Stream4_IRQHandler, DMA2_Stream4_IRQn},
+    {DMA2_Stream5_IRQHandler, DMA2_Stream5_IRQn},
+    {DMA2_Stream6_IRQHandler, DMA2_Stream6_IRQn},
+    {DMA2_Stream7_IRQHandler, DMA2_Stream7_IRQn},
+};
+
+/* Bound on how often one call may re-run re-armed streams (a chain of more
+ * descriptors than this finishes over several calls). */
+#define DMA_MAX_PASSES 256U
+
+static uint16_t _dma_fail_mask; /* bit = controller * 8 + stream */
+static host_dma_stats_t _dma_stats;
+
+/** Apply the write-1-to-clear flag registers to LISR/HISR. */
+static void _dma_apply_ifcr(DMA_Typedef *dma) {
+  dma->LISR &= ~dma->LIFCR;
+  dma->HISR &= ~dma->HIFCR;
+  dma->LIFCR = 0;
+  dma->HIFCR = 0;
+}
+
+static uint32_t _dma_load(uintptr_t addr, uint32_t size) {
+  if (size == 1)
+    return *(volatile uint8_t *)addr;
+  if (size == 2)
+    return *(volatile uint16_t *)addr;
+  return *(volatile uint32_t *)addr;
+}
+
+static void _dma_store(uintptr_t addr, uint32_t size, uint32_t v) {
+  if (size == 1)
+    *(volatile uint8_t *)addr = (uint8_t)v;
+  else if (size == 2)
+    *(volatile uint16_t *)addr = (uint16_t)v;
+  else
+    *(volatile uint32_t *)addr = v;
+}
+
+/**
+ * Move one stream's NDTR items. The peripheral side is accessed once per
+ * item at PSIZE, as the bus would, so a trapped data register (a FIFO)
+ * sees one load or store per word. The memory side is moved byte by byte:
+ * it advances when it increments and otherwise wraps within its own MSIZE
+ * element, so it packs/unpacks whatever its width.
+ */
+static uint32_t _dma_copy(DMA_Stream_Typedef *s) {
+  uint32_t cr = s->CR;
+  uint32_t psize = 1U << ((cr & DMA_SxCR_PSIZE_MASK) >> DMA_SxCR_PSIZE_POS);
+  uint32_t msize = 1U << ((cr & DMA_SxCR_MSIZE_MASK) >> DMA_SxCR_MSIZE_POS);
+  uint32_t bytes = s->NDTR * psize;
+
+  /* M2M uses PAR as source and M0AR as destination, like P2M. */
+  int to_periph = (cr & DMA_SxCR_DIR_MASK) == DMA_SxCR_DIR_M2P;
+  int pinc = (cr & DMA_SxCR_PINC) != 0;
+  int minc = (cr & DMA_SxCR_MINC) != 0;
+  uintptr_t par = s->PAR;
+  uintptr_t mar = s->M0AR;
+
+  for (uint32_t b = 0; b < bytes; b += psize) {
+    uintptr_t p = par + (pinc ? b : 0);
+    uint32_t v = to_periph ? 0 : _dma_load(p, psize);
+    for (uint32_t i = 0; i < psize; i++) {
+      volatile uint8_t *m =
+          (volatile uint8_t *)(mar + (minc ? b + i : (b + i) % msize));
+      if (to_periph)
+        v |= (uint32_t)*m << (8 * i);
+      else
+        *m = (uint8_t)(v >> (8 * i));
+    }
+    if (to_periph)
+      _dma_store(p, psize, v);
+  }
+  return bytes;
+}
+
+/** Run one enabled stream to completion and raise its IRQ if enabled. */
+static void _dma_run_stream(DMA_Typedef *dma, uint8_t stream, uint8_t slot) {
+  DMA_Stream_Typedef *s = &dma->STREAM[stream];
+  uint32_t cr = s->CR;
+  uint32_t flags;
+
+  if (_dma_fail_mask & (1U << slot)) {
+    _dma_fail_mask &= (uint16_t)~(1U << slot);
+    s->CR = cr & ~DMA_SxCR_EN;
+    flags = DMA_ISR_TEIF(stream);
+  } else {
+    uint32_t ndtr = s->NDTR;
+    _dma_stats.bytes += _dma_copy(s);
+    if (cr & DMA_SxCR_CIRC) {
+      s->NDTR = ndtr; /* reload; EN stays set */
+    } else {
+      s->NDTR = 0;
+      s->CR = cr & ~DMA_SxCR_EN;
+    }
+    flags = DMA_ISR_HTIF(stream) | DMA_ISR_TCIF(stream);
+  }
+  *DMA_ISR_REG(dma, stream) |= flags;
+  _dma_stats.transfers++;
+
+  uint32_t enabled = 0;
+  if (cr & DMA_SxCR_TCIE)
+    enabled |= DMA_ISR_TCIF(stream);
+  if (cr & DMA_SxCR_HTIE)
+    enabled |= DMA_ISR_HTIF(stream);
+  if (cr & DMA_SxCR_TEIE)
+    enabled |= DMA_ISR_TEIF(stream);
+  if (!(flags & enabled) || !host_irq_enabled(_dma_vectors[slot].irqn))
+    return;
+
+  _dma_stats.irqs++;
+  _dma_vectors[slot].handler();
+  _dma_apply_ifcr(dma);
+}
+
+unsigned host_dma_run(void) {
+  DMA_Typedef *const ctrl[2] = {DMA1, DMA2};
+  unsigned done = 0;
+  uint16_t lapped = 0; /* circular streams already run in this call */
+
+  _dma_apply_ifcr(DMA1);
+  _dma_apply_ifcr(DMA2);
+
+  for (unsigned pass = 0; pass < DMA_MAX_PASSES; pass++) {
+    unsigned ran = 0;
+    for (uint8_t slot = 0; slot < 16; slot++) {
+      DMA_Typedef *dma = ctrl[slot / 8];
+      uint8_t stream = slot % 8;
+      uint32_t cr = dma->STREAM[stream].CR;
+      if (!(cr & DMA_SxCR_EN) || (lapped & (1U << slot)))
+        continue;
+      if (cr & DMA_SxCR_CIRC)
+        lapped |= (uint16_t)(1U << slot);
+      _dma_run_stream(dma, stream, slot);
+      ran++;
+    }
+    if (ran == 0)
+      break;
+    done += ran;
+  }
+  return done;
+}
+
+void host_dma_fail_next(uint8_t controller, uint8_t stream) {
+  _dma_fail_mask |= (uint16_t)(1U << (((controller == 2) ? 8U : 0U) +
+                                      (stream & 0x7U)));
+}
+
+host_dma_stats_t host_dma_stats(void) { return _dma_stats; }
+
+/* ---- Trapped devices ---------------------------------------------------- */
+
+#if defined(__x86_64__) && defined(__linux__)
+#define HOST_TRAP_SUPPORTED 1
+#define EFL_TF 0x100U  /* x86 trap flag: single-step */
+#define PF_WRITE 0x2U  /* page-fault error code: the access was a store */
+#else
+#define HOST_TRAP_SUPPORTED 0
+#endif
+
+#define HOST_MAX_DEVICES 4
+
+static const host_mmio_device_t *_devices[HOST_MAX_DEVICES];
+
+/* The access being single-stepped between the SIGSEGV and SIGTRAP halves. */
+static struct {
+  const host_mmio_device_t *dev;
+  uintptr_t page;
+  uintptr_t addr;
+  int write;
+} _trap;
+
+static uintptr_t _page_mask(void) { return ~((uintptr_t)getpagesize() - 1U); }
+
+/** Page-aligned [first, end) span of @p dev's registers. */
+static uintptr_t _span(const host_mmio_device_t *dev, uintptr_t *end) {
+  *end = (dev->base + dev->size + (uintptr_t)getpagesize() - 1U) &
+         _page_mask();
+  return dev->base & _page_mask();
+}
+
+static void _protect(const host_mmio_device_t *dev, int prot) {
+  uintptr_t end;
+  uintptr_t first = _span(dev, &end);
+  mprotect((void *)first, end - first, prot);
+}
+
+static void _protect_all(int prot) {
+  for (unsigned i = 0; i < HOST_MAX_DEVICES; i++)
+    if (_devices[i])
+      _protect(_devices[i], prot);
+}
+
+/** The device whose pages hold @p addr (hooks only run inside its range). */
+static const host_mmio_device_t *_device_at(uintptr_t addr) {
+  for (unsigned i = 0; i < HOST_MAX_DEVICES; i++) {
+    uintptr_t end;
+    if (_devices[i] && addr >= _span(_devices[i], &end) && addr < end)
+      return _devices[i];
+  }
+  return NULL;
+}
+
+#if HOST_TRAP_SUPPORTED
+/* First half: a load or store hit a protected device page. Open the page,
+ * let the device refresh the register for a load, and single-step the
+ * faulting instruction. */
+static void _on_segv(int sig, siginfo_t *si, void *ctx) {
+  ucontext_t *uc = ctx;
+  uintptr_t addr = (uintptr_t)si->si_addr;
+  const host_mmio_device_t *dev = _device_at(addr);
+
+  if (dev == NULL) {
+    signal(sig, SIG_DFL); /* a genuine crash: re-fault with the default */
+    return;
+  }
+  _trap.dev = dev;
+  _trap.page = addr & _page_mask();
+  _trap.addr = addr;
+  _trap.write = (uc->uc_mcontext.gregs[REG_ERR] & PF_WRITE) != 0;
+  mprotect((void *)_trap.page, (size_t)getpagesize(), PROT_READ | PROT_WRITE);
+
+  int inside = addr >= dev->base && addr < dev->base + dev->size;
+  if (inside && !_trap.write && dev->read)
+    dev->read((uint32_t)(addr - dev->base));
+  uc->uc_mcontext.gregs[REG_EFL] |= EFL_TF;
+}
+
+/* Second half: the instruction has run. Pass a store to the device, then
+ * close the page again. */
+static void _on_trap(int sig, siginfo_t *si, void *ctx) {
+  ucontext_t *uc = ctx;
+  (void)sig;
+  (void)si;
+  uc->uc_mcontext.gregs[REG_EFL] &= ~(greg_t)EFL_TF;
+  if (_trap.dev == NULL)
+    return;
+
+  const host_mmio_device_t *dev = _trap.dev;
+  _trap.dev = NULL;
+  if (_trap.write && _trap.addr >= dev->base &&
+      _trap.addr < dev->base + dev->size && dev->write)
+    dev->write((uint32_t)(_trap.addr - dev->base));
+  mprotect((void *)_trap.page, (size_t)getpagesize(), PROT_NONE);
+}
+
+static void _install_handlers(void) {
+  static int installed;
+  if (installed)
+    return;
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_flags = SA_SIGINFO;
+  sigemptyset(&sa.sa_mask);
+  sa.sa_sigaction = _on_segv;
+  sigaction(SIGSEGV, &sa, NULL);
+  sa.sa_sigaction = _on_trap;
+  sigaction(SIGTRAP, &sa, NULL);
+  installed = 1;
+}
+#endif
+
+bool host_mmio_attach(const host_mmio_device_t *dev) {
+#if HOST_TRAP_SUPPORTED
+  for (unsigned i = 0; i < HOST_MAX_DEVICES; i++) {
+    if (_devices[i] == NULL) {
+      _install_handlers();
+      _devices[i] = dev;
+      _protect(dev, PROT_NONE);
+      return true;
+    }
+  }
+#else
+  (void)dev;
+#endif
+  return false;
+}
+
+void host_mmio_detach(const host_mmio_device_t *dev) {
+  for (unsigned i = 0; i < HOST_MAX_DEVICES; i++) {
+    if (_devices[i] == dev) {
+      _protect(dev, PROT_READ | PROT_WRITE);
+      _devices[i] = NULL;
+    }
+  }
+  /* Pages shared with a device that stays attached. */
+  _protect_all(PROT_NONE);
+}
+
+/* ---- Setup / reset ------------------------------------------------------ */
+
 void host_mmio_setup(void) {
   map_fixed(PERIPH_BASE, PERIPH_SIZE);
   map_fixed(FLASH_BASE, FLASH_SIZE);
+  map_fixed(HOST_SRAM_BASE, HOST_SRAM_SIZE);
   host_mmio_reset();
 }
 
 void host_mmio_reset(void) {
+  _protect_all(PROT_READ | PROT_WRITE);
   memset((void *)PERIPH_BASE, 0, PERIPH_SIZE);
+  for (unsigned i = 0; i < HOST_MAX_DEVICES; i++)
+    if (_devices[i] && _devices[i]->reset)
+      _devices[i]->reset();
+  _protect_all(PROT_NONE);
   memset((void *)FLASH_BASE, 0xFF, FLASH_SIZE); /* erased flash reads as 0xFF */
+  memset((void *)HOST_SRAM_BASE, 0, HOST_SRAM_SIZE);
+  host_irq_reset();
+  _dma_fail_mask = 0;
+  memset(&_dma_stats, 0, sizeof(_dma_stats));
 }
 
 void host_reg_set(uintptr_t addr, uint32_t bits) {
@@ -27,16 +27,40 @@
  * on the resulting register/memory state and pre-seed the "ready" flags that
  * the drivers' on-target busy-waits poll.
  *
- * This is a *logic* harness, not a hardware model: it does not simulate
- * peripheral side effects (a write to a control register does not move data on
- * a bus). It exercises the driver's register-manipulation and control-flow
- * logic — where most port bugs live — at host speed, in CI, with no board.
+ * This is a *logic* harness, not a hardware model: apart from the DMA engine
+ * below it does not simulate peripheral side effects (a write to a control
+ * register does not move data on a bus). It exercises the driver's
+ * register-manipulation and control-flow logic — where most port bugs live —
+ * at host speed, in CI, with no board.
+ *
+ * The one exception is DMA. ::host_dma_run plays the part of both DMA
+ * controllers: every stream a driver has enabled is run to completion — the
+ * memory copy, NDTR, EN, the LISR/HISR flags — and, like the NVIC would, the
+ * stream's `DMAx_StreamY_IRQHandler` is called if the stream's interrupt
+ * enables and its NVIC line are set. The engine is stepped explicitly rather
+ * than triggered by the EN write (plain memory has no write side effects), so
+ * a test decides exactly when "hardware" runs and every run is reproducible.
+ * Stream address registers are 32 bits wide: buffers a stream points at must
+ * live in the simulated SRAM at ::HOST_SRAM_BASE, not on the host stack/heap.
+ *
+ * Peripherals whose registers do have side effects — a command register
+ * that starts a bus transaction, a FIFO that pops on every read — can be
+ * attached as trapped devices (::host_mmio_attach). Their pages are mapped
+ * without access; each driver load or store faults, the device hook runs
+ * (before a load, after a store) and the instruction is single-stepped with
+ * the page open. x86-64 Linux only. The SD card model in host_sd.h is one.
  */
 #ifndef HOST_MMIO_H
 #define HOST_MMIO_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
+/** @brief Simulated on-chip SRAM (F7 SRAM1), mapped alongside the peripherals
+ *  so DMA buffers have 32-bit addresses. Zeroed by ::host_mmio_reset. */
+#define HOST_SRAM_BASE 0x20020000UL
+#define HOST_SRAM_SIZE 0x00060000UL /**< 384 KB */
+
 /** @brief Map the peripheral + flash regions (call once at startup). Aborts on
  *  failure (e.g. the fixed address is unavailable). */
 void host_mmio_setup(void);
@@ -52,4 +76,88 @@ void host_reg_set(uintptr_t addr, uint32_t bits);
 /** @brief Clear bits in a 32-bit peripheral register. */
 void host_reg_clear(uintptr_t addr, uint32_t bits);
 
+/* ---- Trapped devices ---------------------------------------------------- */
+
+/**
+ * @brief A register block with access side effects.
+ *
+ * Hooks get the byte offset of the access from @c base and run in signal
+ * context with the device's pages open: they may read and write the
+ * device's own registers, but must not touch another trapped device.
+ */
+typedef struct {
+  uintptr_t base;                 /**< First register */
+  uint32_t size;                  /**< Bytes covered */
+  void (*read)(uint32_t offset);  /**< Before a load: refresh the register */
+  void (*write)(uint32_t offset); /**< After a store: act on the new value */
+  void (*reset)(void); /**< After ::host_mmio_reset cleared the registers */
+} host_mmio_device_t;
+
+/**
+ * @brief Trap every access to @p dev's registers from now on.
+ * @return false if the host cannot trap accesses or all slots are taken.
+ */
+bool host_mmio_attach(const host_mmio_device_t *dev);
+
+/** @brief Stop trapping @p dev; its registers become plain memory again. */
+void host_mmio_detach(const host_mmio_device_t *dev);
+
+/* ---- Simulated NVIC and timebase (host_stubs.c) ------------------------ */
+
+/** @brief True if the driver has enabled NVIC line @p irq. */
+bool host_irq_enabled(int irq);
+
+/** @brief Disable every NVIC line and drop attached callbacks. Called by
+ *  ::host_mmio_reset. */
+void host_irq_reset(void);
+
+/**
+ * @brief Call @p hook on every hal_timebase_get_millis, or stop with NULL.
+ *
+ * Driver wait loops read the time between sleeps, so a hook that plays the
+ * pending interrupts lets a blocking call complete the way it would on a
+ * board. The hook must not read the timebase itself.
+ */
+void host_timebase_set_hook(void (*hook)(void));
+
+/* ---- Simulated DMA engine ----------------------------------------------- */
+
+/** @brief Running totals since the last ::host_mmio_reset, for profiling the
+ *  async pipelines on the host. */
+typedef struct {
+  uint32_t transfers; /**< Streams run to completion (or error) */
+  uint32_t bytes;     /**< Bytes moved */
+  uint32_t irqs;      /**< Stream IRQ handlers invoked */
+} host_dma_stats_t;
+
+/**
+ * @brief Run every enabled DMA stream until the engine is idle.
+ *
+ * Pending LIFCR/HIFCR writes are applied first (they are write-1-to-clear on
+ * silicon). Each enabled stream then moves NDTR items from source to
+ * destination honouring DIR, PINC/MINC and PSIZE/MSIZE (the peripheral side
+ * with one PSIZE access per item, so a trapped FIFO register such as SDIO's
+ * sees one access per word), sets HTIF + TCIF, drops EN (or reloads NDTR in
+ * circular mode) and raises its IRQ. Streams a handler re-arms — descriptor
+ * chains — are run in the same call. A circular stream completes one lap
+ * per call.
+ *
+ * @return Number of stream transfers completed.
+ */
+unsigned host_dma_run(void);
+
+/**
+ * @brief Make the next run of a stream fail with a transfer error.
+ *
+ * The stream is disabled with TEIF set and nothing copied, as a bus error
+ * would on silicon.
+ *
+ * @param controller 1 or 2.
+ * @param stream     0..7.
+ */
+void host_dma_fail_next(uint8_t controller, uint8_t stream);
+
+/** @brief Totals since the last ::host_mmio_reset. */
+host_dma_stats_t host_dma_stats(void);
+
 #endif /* HOST_MMIO_H */
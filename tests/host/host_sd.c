@@ -0,0 +1,730 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file host_sd.c
+ * @brief SD card model for the host driver suite; see host_sd.h.
+ *
+ * The register hooks run in signal context (host_mmio.c), so nothing here
+ * allocates or does stdio; the image is mapped once at attach time.
+ */
+
+#include "host_sd.h"
+#include "host_mmio.h"
+#include "navhal_port_config.h"
+#include "common/hal_sdio.h"
+#include "family/sdio_reg.h"
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SD_BLOCK 512U
+#define SD_STATUS_BYTES 64U
+#define SD_RCA 0x1234U
+
+/* OCR (R3) */
+#define OCR_VOLTAGES 0x00FF8000U
+#define OCR_CCS (1U << 30)
+#define OCR_READY (1U << 31)
+
+/* Card status (R1) */
+#define R1_OUT_OF_RANGE (1U << 31)
+#define R1_ADDRESS_ERROR (1U << 30)
+#define R1_BLOCK_LEN_ERROR (1U << 29)
+#define R1_ERASE_SEQ_ERROR (1U << 28)
+#define R1_ILLEGAL_COMMAND (1U << 22)
+#define R1_READY_FOR_DATA (1U << 8)
+#define R1_APP_CMD (1U << 5)
+#define R1_STATE_POS 9U
+
+typedef enum {
+  ST_IDLE = 0,
+  ST_READY = 1,
+  ST_IDENT = 2,
+  ST_STBY = 3,
+  ST_TRAN = 4,
+  ST_DATA = 5,
+  ST_RCV = 6,
+  ST_PRG = 7,
+} sd_state_t;
+
+typedef enum { RESP_NONE, RESP_R1, RESP_R2, RESP_R3, RESP_R6, RESP_R7 } sd_resp_t;
+
+/* What the card sends or expects on DAT. */
+typedef enum { XFER_NONE, XFER_READ, XFER_WRITE, XFER_STATUS } sd_xfer_t;
+
+static struct {
+  host_sd_config_t cfg;
+  int fd;
+  uint8_t *image;
+  size_t image_bytes;
+  uint8_t attached;
+
+  /* Card */
+  sd_state_t state;
+  uint8_t app;       /* the previous command was CMD55 */
+  uint8_t init_left; /* ACMD41 busy replies still to give */
+  uint8_t wide_bus;  /* ACMD6 selected 4 bits */
+  uint8_t high_speed;
+  uint32_t errors; /* R1 error bits for the next status */
+  uint32_t erase_first;
+  uint32_t erase_last;
+  uint8_t erase_set; /* bit 0: CMD32 seen, bit 1: CMD33 seen */
+  uint32_t busy;     /* busy reads left (DAT0 low) */
+
+  /* Card data phase */
+  sd_xfer_t xfer;
+  uint8_t multi;
+  uint8_t no_data; /* a data command was rejected: DTIMEOUT once armed */
+  uint32_t pos;    /* sector being transferred */
+  uint32_t fill;   /* bytes of the current block moved */
+  uint8_t block[SD_BLOCK];
+  uint8_t status[SD_STATUS_BYTES];
+  host_sd_fault_t data_fault;
+
+  /* Controller side */
+  uint8_t dpsm; /* DCTRL.DTEN */
+  uint8_t rx;   /* DCTRL.DTDIR */
+  uint32_t remaining; /* bytes of DLEN still to move */
+  uint32_t sta;       /* static STA flags until cleared through ICR */
+
+  uint8_t fail_cmd;
+  host_sd_fault_t fail;
+  host_sd_stats_t stats;
+} sd;
+
+/* ---- Card registers ------------------------------------------------------ */
+
+/** Set @p width bits of @p value at CSD bit @p pos of RESP1..4 ([127:0]). */
+static void _csd_put(uint32_t csd[4], unsigned pos, unsigned width,
+                     uint32_t value) {
+  for (unsigned i = 0; i < width; i++, pos++) {
+    if (value & (1U << i))
+      csd[3 - pos / 32] |= 1U << (pos % 32);
+  }
+}
+
+static void _build_csd(uint32_t csd[4]) {
+  memset(csd, 0, 4 * sizeof(uint32_t));
+  if (sd.cfg.sdsc) {
+    /* Capacity = (C_SIZE + 1) * 2^(C_SIZE_MULT + 2) * 2^READ_BL_LEN. */
+    unsigned mult = 0;
+    while (mult < 7 && sd.cfg.sectors / (4U << mult) > 4096U)
+      mult++;
+    _csd_put(csd, 126, 2, 0);
+    _csd_put(csd, 80, 4, 9); /* READ_BL_LEN: 512 */
+    _csd_put(csd, 62, 12, sd.cfg.sectors / (4U << mult) - 1U);
+    _csd_put(csd, 47, 3, mult);
+  } else {
+    _csd_put(csd, 126, 2, 1);
+    _csd_put(csd, 80, 4, 9);
+    _csd_put(csd, 48, 22, sd.cfg.sectors / 1024U - 1U);
+  }
+  _csd_put(csd, 46, 1, 1);   /* ERASE_BLK_EN */
+  _csd_put(csd, 39, 7, 127); /* SECTOR_SIZE: 128 blocks */
+  _csd_put(csd, 22, 4, 9);   /* WRITE_BL_LEN: 512 */
+  _csd_put(csd, 0, 1, 1);
+}
+
+static void _build_cid(uint32_t cid[4]) {
+  cid[0] = 0x034E4156U; /* MID 0x03, OID "NA", PNM "V..." */
+  cid[1] = 0x48414C53U; /* "HALS" */
+  cid[2] = 0x10000000U; /* PRV 1.0 */
+  cid[3] = 0x00000001U;
+}
+
+/* CMD6 status block: group 1 function 1 (High Speed) support in bit 401,
+ * the function selected for group 1 in bits 379:376. */
+static void _build_switch_status(uint32_t arg) {
+  uint8_t want = arg & 0xFU;
+  uint8_t hs_ok = !sd.cfg.no_high_speed;
+
+  memset(sd.status, 0, sizeof(sd.status));
+  sd.status[1] = 100; /* max current, mA */
+  sd.status[13] = (uint8_t)(0x01U | (hs_ok ? 0x02U : 0U));
+  if (want == 0xFU)
+    sd.status[16] = sd.high_speed ? 1U : 0U;
+  else if (want == 0U || (want == 1U && hs_ok))
+    sd.status[16] = want;
+  else
+    sd.status[16] = 0xFU;
+
+  if ((arg & (1U << 31)) && sd.status[16] != 0xFU && want != 0xFU)
+    sd.high_speed = want == 1U;
+}
+
+static void _build_sd_status(void) {
+  memset(sd.status, 0, sizeof(sd.status));
+  sd.status[0] = sd.wide_bus ? 0x80U : 0x00U; /* DAT_BUS_WIDTH */
+  sd.status[10] = (uint8_t)(sd.cfg.au_size << 4);
+}
+
+/* ---- Busy and status ----------------------------------------------------- */
+
+/** One busy read: @return 1 if the card was still busy. */
+static int _busy_poll(void) {
+  if (sd.busy == 0)
+    return 0;
+  sd.busy--;
+  sd.stats.busy_polls++;
+  if (sd.busy == 0 && sd.state == ST_PRG)
+    sd.state = ST_TRAN;
+  return 1;
+}
+
+static void _go_busy(void) {
+  sd.busy = sd.cfg.busy_polls;
+  sd.state = sd.busy ? ST_PRG : ST_TRAN;
+}
+
+/** R1 for a command received in @p state, @p app if it was taken as an
+ *  application command; error bits are clear-on-read. */
+static uint32_t _r1(sd_state_t state, uint8_t app) {
+  uint32_t r1 = sd.errors | ((uint32_t)state << R1_STATE_POS);
+  if (state != ST_PRG)
+    r1 |= R1_READY_FOR_DATA;
+  if (app)
+    r1 |= R1_APP_CMD;
+  sd.errors = 0;
+  return r1;
+}
+
+/* ---- Data phase ---------------------------------------------------------- */
+
+static int _rx_active(void) {
+  return sd.dpsm && sd.rx && sd.remaining &&
+         (sd.xfer == XFER_READ || sd.xfer == XFER_STATUS);
+}
+
+static int _tx_active(void) {
+  return sd.dpsm && !sd.rx && sd.remaining && sd.xfer == XFER_WRITE;
+}
+
+/** Called whenever the card or the DPSM side changes: an armed DPSM facing a
+ *  card that will never send reports a data timeout. */
+static void _data_check(void) {
+  if (sd.dpsm && sd.remaining && sd.no_data) {
+    sd.sta |= SDIO_STA_DTIMEOUT;
+    sd.no_data = 0;
+  }
+}
+
+/** Translate a data command argument to a sector, flagging bad addresses. */
+static int _sector(uint32_t arg, uint32_t *sector) {
+  uint32_t s = arg;
+  if (sd.cfg.sdsc) {
+    if (arg % SD_BLOCK) {
+      sd.errors |= R1_ADDRESS_ERROR;
+      return 0;
+    }
+    s = arg / SD_BLOCK;
+  }
+  if (s >= sd.cfg.sectors) {
+    sd.errors |= R1_OUT_OF_RANGE;
+    return 0;
+  }
+  *sector = s;
+  return 1;
+}
+
+static void _begin_data(sd_xfer_t xfer, uint8_t multi, uint32_t sector) {
+  sd.xfer = xfer;
+  sd.multi = multi;
+  sd.pos = sector;
+  sd.fill = 0;
+  sd.state = xfer == XFER_WRITE ? ST_RCV : ST_DATA;
+  if (sd.data_fault == HOST_SD_FAULT_DATA_TIMEOUT) {
+    sd.data_fault = HOST_SD_FAULT_NONE;
+    sd.xfer = XFER_NONE;
+    sd.no_data = 1;
+    if (!multi)
+      sd.state = ST_TRAN;
+  }
+}
+
+/** The end of the card's data run: back to tran (reads) or programming. */
+static void _end_data(void) {
+  sd.xfer = XFER_NONE;
+  if (sd.state == ST_DATA)
+    sd.state = ST_TRAN;
+}
+
+/** A full block crossed the bus in either direction. */
+static void _block_done(void) {
+  sd.fill = 0;
+
+  if (sd.data_fault == HOST_SD_FAULT_DATA_CRC) {
+    sd.data_fault = HOST_SD_FAULT_NONE;
+    sd.sta |= SDIO_STA_DCRCFAIL;
+    sd.remaining = 0; /* the DPSM stops on the error */
+    sd.xfer = XFER_NONE;
+    if (!sd.multi)
+      sd.state = ST_TRAN;
+    return;
+  }
+
+  sd.sta |= SDIO_STA_DBCKEND;
+  switch (sd.xfer) {
+  case XFER_STATUS:
+    _end_data();
+    return;
+  case XFER_READ:
+    sd.stats.blocks_read++;
+    break;
+  case XFER_WRITE:
+    memcpy(sd.image + (size_t)sd.pos * SD_BLOCK, sd.block, SD_BLOCK);
+    sd.stats.blocks_written++;
+    break;
+  default:
+    return;
+  }
+
+  sd.pos++;
+  if (sd.xfer == XFER_WRITE) {
+    sd.busy = sd.cfg.busy_polls;
+    if (!sd.multi) {
+      sd.xfer = XFER_NONE;
+      _go_busy();
+      return;
+    }
+  } else if (!sd.multi) {
+    _end_data();
+    return;
+  }
+
+  /* Multi-block: running off the end of the card stops the data. */
+  if (sd.pos >= sd.cfg.sectors) {
+    sd.errors |= R1_OUT_OF_RANGE;
+    sd.xfer = XFER_NONE;
+    if (sd.remaining) {
+      sd.remaining = 0;
+      sd.sta |= SDIO_STA_DTIMEOUT;
+    }
+  }
+}
+
+/** Account for one 32-bit FIFO word moved by the driver. */
+static void _word_moved(void) {
+  uint32_t block = sd.xfer == XFER_STATUS ? SD_STATUS_BYTES : SD_BLOCK;
+
+  sd.fill += 4;
+  sd.remaining -= 4;
+  if (sd.fill == block)
+    _block_done();
+  if (sd.remaining == 0 &&
+      !(sd.sta & (SDIO_STA_DCRCFAIL | SDIO_STA_DTIMEOUT)))
+    sd.sta |= SDIO_STA_DATAEND;
+}
+
+static uint32_t _fifo_pop(void) {
+  const uint8_t *src = sd.xfer == XFER_STATUS
+                           ? sd.status
+                           : sd.image + (size_t)sd.pos * SD_BLOCK;
+  uint32_t word;
+  memcpy(&word, src + sd.fill, sizeof(word));
+  _word_moved();
+  return word;
+}
+
+static void _fifo_push(uint32_t word) {
+  memcpy(sd.block + sd.fill, &word, sizeof(word));
+  _word_moved();
+}
+
+/* ---- Commands ------------------------------------------------------------ */
+
+/** Execute @p cmd; @return the response kind, or RESP_NONE if illegal. */
+static sd_resp_t _execute(uint8_t cmd, uint32_t arg, uint32_t resp[4]) {
+  sd_state_t state = sd.state;
+  uint8_t app = sd.app;
+  uint32_t sector;
+
+  sd.app = 0;
+  if (app) {
+    switch (cmd) {
+    case SD_ACMD_SD_SEND_OP_COND:
+      if (state != ST_IDLE && state != ST_READY)
+        return RESP_NONE;
+      resp[0] = OCR_VOLTAGES;
+      if (sd.init_left) {
+        sd.init_left--;
+        return RESP_R3;
+      }
+      resp[0] |= OCR_READY | (sd.cfg.sdsc ? 0U : OCR_CCS);
+      sd.state = ST_READY;
+      return RESP_R3;
+    case SD_ACMD_SET_BUS_WIDTH:
+      if (state != ST_TRAN)
+        return RESP_NONE;
+      sd.wide_bus = (arg & 3U) == 2U;
+      resp[0] = _r1(state, 1);
+      return RESP_R1;
+    case SD_ACMD_SD_STATUS:
+      if (state != ST_TRAN)
+        return RESP_NONE;
+      resp[0] = _r1(state, 1);
+      _build_sd_status();
+      _begin_data(XFER_STATUS, 0, 0);
+      return RESP_R1;
+    case SD_ACMD_SET_WR_BLK_ERASE_COUNT:
+      if (state != ST_TRAN)
+        return RESP_NONE;
+      resp[0] = _r1(state, 1);
+      return RESP_R1;
+    default:
+      break; /* not an ACMD: handled as the plain command */
+    }
+  }
+
+  switch (cmd) {
+  case SD_CMD_GO_IDLE_STATE:
+    sd.state = ST_IDLE;
+    sd.init_left = sd.cfg.init_polls;
+    sd.wide_bus = 0;
+    sd.high_speed = 0;
+    sd.busy = 0;
+    sd.xfer = XFER_NONE;
+    return RESP_NONE; /* CMD0 has no response */
+
+  case SD_CMD_HS_SEND_EXT_CSD: /* SEND_IF_COND */
+    if (state != ST_IDLE)
+      return RESP_NONE;
+    resp[0] = arg & 0xFFFU;
+    return RESP_R7;
+
+  case SD_CMD_APP_CMD:
+    sd.app = 1;
+    resp[0] = _r1(state, 1);
+    return RESP_R1;
+
+  case SD_CMD_ALL_SEND_CID:
+    if (state != ST_READY)
+      return RESP_NONE;
+    _build_cid(resp);
+    sd.state = ST_IDENT;
+    return RESP_R2;
+
+  case SD_CMD_SEND_REL_ADDR:
+    if (state != ST_IDENT && state != ST_STBY)
+      return RESP_NONE;
+    sd.state = ST_STBY;
+    resp[0] = (SD_RCA << 16) | ((uint32_t)state << R1_STATE_POS) |
+              R1_READY_FOR_DATA;
+    return RESP_R6;
+
+  case 9: /* SEND_CSD */
+    if (state != ST_STBY || (arg >> 16) != SD_RCA)
+      return RESP_NONE;
+    _build_csd(resp);
+    return RESP_R2;
+
+  case SD_CMD_SELECT_DESELECT_CARD:
+    if ((arg >> 16) == SD_RCA) {
+      if (state != ST_STBY)
+        return RESP_NONE;
+      sd.state = ST_TRAN;
+    } else {
+      if (state != ST_TRAN)
+        return RESP_NONE;
+      sd.state = ST_STBY;
+    }
+    resp[0] = _r1(state, 0);
+    return RESP_R1;
+
+  case SD_CMD_SEND_STATUS:
+    if (state < ST_STBY || (arg >> 16) != SD_RCA)
+      return RESP_NONE;
+    resp[0] = _r1(state, 0);
+    if (state == ST_PRG)
+      _busy_poll();
+    return RESP_R1;
+
+  case SD_CMD_SET_BLOCKLEN:
+    if (state != ST_TRAN)
+      return RESP_NONE;
+    if (arg != SD_BLOCK)
+      sd.errors |= R1_BLOCK_LEN_ERROR;
+    resp[0] = _r1(state, 0);
+    return RESP_R1;
+
+  case SD_CMD_SWITCH_FUNC:
+    if (state != ST_TRAN)
+      return RESP_NONE;
+    resp[0] = _r1(state, 0);
+    _build_switch_status(arg);
+    _begin_data(XFER_STATUS, 0, 0);
+    return RESP_R1;
+
+  case SD_CMD_READ_SINGLE_BLOCK:
+  case SD_CMD_READ_MULT_BLOCK:
+  case SD_CMD_WRITE_SINGLE_BLOCK:
+  case SD_CMD_WRITE_MULT_BLOCK: {
+    if (state != ST_TRAN)
+      return RESP_NONE;
+    int ok = _sector(arg, &sector);
+    resp[0] = _r1(state, 0);
+    if (!ok) {
+      sd.no_data = 1;
+      return RESP_R1;
+    }
+    int write = cmd == SD_CMD_WRITE_SINGLE_BLOCK ||
+                cmd == SD_CMD_WRITE_MULT_BLOCK;
+    if (write)
+      sd.stats.write_cmds++;
+    else
+      sd.stats.read_cmds++;
+    _begin_data(write ? XFER_WRITE : XFER_READ,
+                cmd == SD_CMD_READ_MULT_BLOCK ||
+                    cmd == SD_CMD_WRITE_MULT_BLOCK,
+                sector);
+    return RESP_R1;
+  }
+
+  case SD_CMD_STOP_TRANSMISSION:
+    if (state != ST_DATA && state != ST_RCV)
+      return RESP_NONE;
+    resp[0] = _r1(state, 0);
+    sd.xfer = XFER_NONE;
+    if (state == ST_RCV && sd.busy)
+      sd.state = ST_PRG;
+    else
+      sd.state = ST_TRAN;
+    return RESP_R1;
+
+  case SD_CMD_ERASE_WR_BLK_START:
+  case SD_CMD_ERASE_WR_BLK_END:
+    if (state != ST_TRAN)
+      return RESP_NONE;
+    if (_sector(arg, &sector)) {
+      if (cmd == SD_CMD_ERASE_WR_BLK_START) {
+        sd.erase_first = sector;
+        sd.erase_set = 1;
+      } else if (sd.erase_set & 1U) {
+        sd.erase_last = sector;
+        sd.erase_set |= 2U;
+      } else {
+        sd.errors |= R1_ERASE_SEQ_ERROR;
+      }
+    }
+    resp[0] = _r1(state, 0);
+    return RESP_R1;
+
+  case SD_CMD_ERASE:
+    if (state != ST_TRAN)
+      return RESP_NONE;
+    if (sd.erase_set != 3U || sd.erase_last < sd.erase_first) {
+      sd.errors |= R1_ERASE_SEQ_ERROR;
+      sd.erase_set = 0;
+      resp[0] = _r1(state, 0);
+      return RESP_R1;
+    }
+    resp[0] = _r1(state, 0);
+    /* DATA_STAT_AFTER_ERASE = 0: erased blocks read as zeros. */
+    memset(sd.image + (size_t)sd.erase_first * SD_BLOCK, 0,
+           (size_t)(sd.erase_last - sd.erase_first + 1U) * SD_BLOCK);
+    sd.erase_set = 0;
+    sd.stats.erases++;
+    _go_busy();
+    return RESP_R1;
+
+  default:
+    return RESP_NONE;
+  }
+}
+
+static void _on_command(void) {
+  uint32_t reg = SDIO->CMD;
+  if (!(reg & SDIO_CMD_CPSMEN))
+    return;
+
+  uint8_t cmd = reg & SDIO_CMD_CMDINDEX_Msk;
+  uint32_t waitresp = reg & SDIO_CMD_WAITRESP_Msk;
+  uint32_t resp[4] = {0, 0, 0, 0};
+
+  sd.stats.commands++;
+
+  if ((SDIO->POWER & SDIO_POWER_PWRCTRL_Msk) != SDIO_POWER_PWRCTRL_ON ||
+      !(SDIO->CLKCR & SDIO_CLKCR_CLKEN)) {
+    sd.sta |= waitresp ? SDIO_STA_CTIMEOUT : SDIO_STA_CMDSENT;
+    return;
+  }
+
+  if (sd.fail != HOST_SD_FAULT_NONE && sd.fail_cmd == cmd) {
+    host_sd_fault_t fault = sd.fail;
+    sd.fail = HOST_SD_FAULT_NONE;
+    if (fault == HOST_SD_FAULT_CMD_TIMEOUT) {
+      sd.app = 0;
+      sd.sta |= SDIO_STA_CTIMEOUT;
+      return;
+    }
+    if (fault == HOST_SD_FAULT_CMD_CRC) {
+      sd.app = 0;
+      sd.sta |= SDIO_STA_CCRCFAIL;
+      return;
+    }
+    sd.data_fault = fault; /* picked up by the data phase */
+  }
+
+  sd_resp_t kind = _execute(cmd, SDIO->ARG, resp);
+  if (kind == RESP_NONE) {
+    if (cmd != SD_CMD_GO_IDLE_STATE)
+      sd.errors |= R1_ILLEGAL_COMMAND;
+    sd.sta |= waitresp ? SDIO_STA_CTIMEOUT : SDIO_STA_CMDSENT;
+  } else if (!waitresp) {
+    sd.sta |= SDIO_STA_CMDSENT;
+  } else {
+    SDIO->RESPCMD = (kind == RESP_R2 || kind == RESP_R3) ? 0x3FU : cmd;
+    SDIO->RESP1 = resp[0];
+    SDIO->RESP2 = resp[1];
+    SDIO->RESP3 = resp[2];
+    SDIO->RESP4 = resp[3];
+    /* R3 carries no CRC; the CPSM flags that as a CRC failure. */
+    sd.sta |= kind == RESP_R3 ? SDIO_STA_CCRCFAIL : SDIO_STA_CMDREND;
+  }
+  _data_check();
+}
+
+/* ---- Register hooks ------------------------------------------------------ */
+
+#define OFF(reg) offsetof(SDIO_Reg_Typedef, reg)
+
+static void _on_read(uint32_t offset) {
+  if (offset == OFF(STA)) {
+    uint32_t dyn = 0;
+    if (_rx_active()) {
+      dyn |= SDIO_STA_RXACT | SDIO_STA_RXDAVL;
+      if (sd.remaining >= 8U * 4U)
+        dyn |= SDIO_STA_RXFIFOHF;
+    } else if (_tx_active()) {
+      dyn |= SDIO_STA_TXACT | SDIO_STA_TXFIFOHE | SDIO_STA_TXFIFOE;
+    } else if (sd.dpsm && !sd.rx && _busy_poll()) {
+      dyn |= SDIO_STA_TXACT; /* the DPSM waits out DAT0 busy */
+    }
+    SDIO->STA = sd.sta | dyn;
+  } else if (offset == OFF(FIFO)) {
+    SDIO->FIFO = _rx_active() ? _fifo_pop() : 0U;
+  } else if (offset == OFF(FIFOCNT)) {
+    SDIO->FIFOCNT = sd.dpsm ? sd.remaining / 4U : 0U;
+  }
+}
+
+static void _on_write(uint32_t offset) {
+  if (offset == OFF(CMD)) {
+    _on_command();
+  } else if (offset == OFF(ICR)) {
+    sd.sta &= ~SDIO->ICR;
+  } else if (offset == OFF(DCTRL)) {
+    uint32_t dctrl = SDIO->DCTRL;
+    sd.dpsm = (dctrl & SDIO_DCTRL_DTEN) != 0;
+    sd.rx = (dctrl & SDIO_DCTRL_DTDIR) != 0;
+    sd.remaining = sd.dpsm ? (SDIO->DLEN & 0x01FFFFFFU) : 0U;
+    _data_check();
+  } else if (offset == OFF(FIFO)) {
+    if (_tx_active())
+      _fifo_push(SDIO->FIFO);
+  }
+}
+
+/* The controller is reset with the registers; the card keeps its state. */
+static void _on_reset(void) {
+  sd.dpsm = 0;
+  sd.rx = 0;
+  sd.remaining = 0;
+  sd.sta = 0;
+}
+
+static const host_mmio_device_t sd_device = {
+    .base = SDIO_BASE,
+    .size = sizeof(SDIO_Reg_Typedef),
+    .read = _on_read,
+    .write = _on_write,
+    .reset = _on_reset,
+};
+
+/* ---- Public API ---------------------------------------------------------- */
+
+bool host_sd_attach(const host_sd_config_t *cfg) {
+  if (cfg == NULL || sd.attached || cfg->sectors == 0 ||
+      (cfg->sdsc ? cfg->sectors % 4U : cfg->sectors % 1024U) != 0 ||
+      (cfg->sdsc && cfg->sectors > 4096U * 512U) || cfg->au_size > 0xFU)
+    return false;
+
+  memset(&sd, 0, sizeof(sd));
+  sd.cfg = *cfg;
+  sd.image_bytes = (size_t)cfg->sectors * SD_BLOCK;
+
+  if (cfg->image) {
+    sd.fd = open(cfg->image, O_RDWR | O_CREAT, 0644);
+  } else {
+    char path[] = "/tmp/host_sd_XXXXXX";
+    sd.fd = mkstemp(path);
+    if (sd.fd >= 0)
+      unlink(path);
+  }
+  if (sd.fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(sd.fd, &st) != 0 ||
+      ((size_t)st.st_size < sd.image_bytes &&
+       ftruncate(sd.fd, (off_t)sd.image_bytes) != 0)) {
+    close(sd.fd);
+    return false;
+  }
+  void *p = mmap(NULL, sd.image_bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                 sd.fd, 0);
+  if (p == MAP_FAILED) {
+    close(sd.fd);
+    return false;
+  }
+  sd.image = p;
+
+  if (!host_mmio_attach(&sd_device)) {
+    munmap(sd.image, sd.image_bytes);
+    close(sd.fd);
+    return false;
+  }
+  sd.state = ST_IDLE;
+  sd.init_left = cfg->init_polls;
+  sd.attached = 1;
+  return true;
+}
+
+void host_sd_detach(void) {
+  if (!sd.attached)
+    return;
+  host_mmio_detach(&sd_device);
+  msync(sd.image, sd.image_bytes, MS_SYNC);
+  munmap(sd.image, sd.image_bytes);
+  close(sd.fd);
+  sd.attached = 0;
+}
+
+void host_sd_fail_next(uint8_t cmd, host_sd_fault_t fault) {
+  sd.fail_cmd = cmd;
+  sd.fail = fault;
+}
+
+uint8_t *host_sd_image(void) { return sd.image; }
+
+host_sd_stats_t host_sd_stats(void) { return sd.stats; }
+
+void host_sd_reset_stats(void) { memset(&sd.stats, 0, sizeof(sd.stats)); }
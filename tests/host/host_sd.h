@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file host_sd.h
+ * @brief Behavioural SD card behind the simulated SDIO registers.
+ *
+ * @details
+ * Attaches to the SDIO register block as a trapped device (host_mmio.h), so
+ * the real sdio.c — and diskio.c and FatFs above it — run against it
+ * unmodified. The model answers what the controller would see from a card:
+ *
+ * - Command path: a CMD write with CPSMEN is decoded and answered at once
+ *   with CMDREND (CMDSENT for CMD0, CCRCFAIL for the CRC-less R3), and the
+ *   RESP registers filled in. The card follows the SD state machine
+ *   (idle, ready, ident, stby, tran, data, rcv, prg); a command that is
+ *   illegal in the current state gets no response (CTIMEOUT) and sets
+ *   ILLEGAL_COMMAND in the next R1.
+ * - Supported commands: CMD0, 2, 3, 6, 7, 8, 9, 12, 13, 16, 17, 18, 24, 25,
+ *   32, 33, 38, 55 and ACMD6, 13, 23, 41 — enough for sdio.c's init,
+ *   geometry, High Speed switch, transfer and erase sequences. SDHC cards
+ *   are block addressed, SDSC cards byte addressed.
+ * - Data path: once both the data command and DCTRL.DTEN have been seen,
+ *   FIFO loads pop card data and FIFO stores fill the card's block buffer;
+ *   STA reports RXDAVL/RXFIFOHF or TXFIFOHE, DBCKEND per block and DATAEND
+ *   after DLEN bytes. The FIFO never under- or overruns: data is produced
+ *   and consumed at the pace the driver moves it, as hardware flow control
+ *   would have it.
+ * - Busy: after each written block, and after an erase, the card keeps DAT0
+ *   low for ::host_sd_config_t::busy_polls status reads. A busy read is
+ *   either an STA load that shows TXACT or a CMD13 that reports prg.
+ * - Errors: ::host_sd_fail_next injects a command timeout, a response CRC
+ *   failure, a data CRC failure or a data timeout into the next use of a
+ *   command. Reads and writes beyond the end of the card get OUT_OF_RANGE
+ *   and no data, which the controller shows as DTIMEOUT.
+ *
+ * The card data lives in an image file, mapped shared, so a test can
+ * inspect it directly (::host_sd_image) or keep it for later runs.
+ * The FIFO may be serviced by the driver or by the DMA engine of
+ * host_mmio.h (::host_dma_run), which loads and stores it a word at a time.
+ * The model raises no interrupts itself: a test of the DMA backend calls
+ * SDIO_IRQHandler while STA has an unmasked flag up (test_sdio_dma.c).
+ */
+#ifndef HOST_SD_H
+#define HOST_SD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief Failure injected by ::host_sd_fail_next. */
+typedef enum {
+  HOST_SD_FAULT_NONE = 0,
+  HOST_SD_FAULT_CMD_TIMEOUT, /**< No response (CTIMEOUT); not executed */
+  HOST_SD_FAULT_CMD_CRC,     /**< Response CRC error (CCRCFAIL); not executed */
+  HOST_SD_FAULT_DATA_CRC,    /**< First data block fails its CRC (DCRCFAIL) */
+  HOST_SD_FAULT_DATA_TIMEOUT /**< The data phase never starts (DTIMEOUT) */
+} host_sd_fault_t;
+
+/** @brief The card to insert. */
+typedef struct {
+  const char *image; /**< Backing file, created or extended to size; NULL
+                          for an anonymous temporary file */
+  uint32_t sectors;  /**< Capacity in 512-byte sectors: a multiple of 1024
+                          (SDHC) or of 4 (SDSC) */
+  uint8_t sdsc;      /**< 1 = standard capacity: byte addresses, CSD v1 */
+  uint8_t no_high_speed; /**< 1 = CMD6 reports High Speed unsupported */
+  uint8_t au_size;   /**< SD_STATUS AU_SIZE code, 0 = not reported */
+  uint8_t init_polls; /**< ACMD41 replies that still report power-up busy */
+  uint16_t busy_polls; /**< Busy reads after each written block or erase */
+} host_sd_config_t;
+
+/** @brief Counters since attach or ::host_sd_reset_stats. */
+typedef struct {
+  uint32_t commands;       /**< Commands with CPSMEN, answered or not */
+  uint32_t read_cmds;      /**< CMD17 + CMD18 accepted */
+  uint32_t write_cmds;     /**< CMD24 + CMD25 accepted */
+  uint32_t blocks_read;    /**< 512-byte blocks sent to the host */
+  uint32_t blocks_written; /**< 512-byte blocks programmed */
+  uint32_t erases;         /**< CMD38 erases performed */
+  uint32_t busy_polls;     /**< Status reads answered with busy */
+} host_sd_stats_t;
+
+/**
+ * @brief Insert a card: map its image and start trapping the SDIO registers.
+ *
+ * The card starts powered up in the idle state. Call after
+ * ::host_mmio_setup; the card survives ::host_mmio_reset, which only
+ * resets the controller side (flags, data path).
+ *
+ * @return false for a bad configuration, an image that cannot be mapped,
+ *         or a host that cannot trap register accesses.
+ */
+bool host_sd_attach(const host_sd_config_t *cfg);
+
+/** @brief Remove the card; the image file keeps its contents. */
+void host_sd_detach(void);
+
+/**
+ * @brief Make the next use of command @p cmd fail with @p fault.
+ *
+ * @p cmd is the command index, so 13 matches both CMD13 and ACMD13.
+ */
+void host_sd_fail_next(uint8_t cmd, host_sd_fault_t fault);
+
+/** @brief The card contents (::host_sd_config_t::sectors * 512 bytes). */
+uint8_t *host_sd_image(void);
+
+/** @brief Counters since attach or the last ::host_sd_reset_stats. */
+host_sd_stats_t host_sd_stats(void);
+
+/** @brief Zero the counters. */
+void host_sd_reset_stats(void);
+
+#endif /* HOST_SD_H */
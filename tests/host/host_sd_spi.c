@@ -0,0 +1,583 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file host_sd_spi.c
+ * @brief Behavioural SD card in SPI mode, standing in for hal_spi.
+ *
+ * @details
+ * Byte-level model: every byte clocked by the host returns the card's next
+ * output byte (queued response, busy, or streamed read data) and is then
+ * fed to the card's input side (command framing, write data). See
+ * host_sd_spi.h for what is modelled.
+ *
+ * The image is an anonymous mapping that only takes memory where it has
+ * been written, and erased pages are handed back, so multi-gigabyte cards
+ * (exFAT, files over 4 GiB) cost little more than the data on them.
+ */
+
+#define _DEFAULT_SOURCE /* MAP_ANONYMOUS, MADV_DONTNEED */
+#include "host_sd_spi.h"
+#include "board.h"
+#include "common/hal_gpio.h"
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define SS 512U
+
+typedef enum {
+  PH_CMD,        /* listening for a command frame */
+  PH_READ,       /* CMD18: streaming blocks until CMD12 */
+  PH_WRITE_WAIT, /* CMD24/25: waiting for a start (or stop) token */
+  PH_WRITE_DATA  /* receiving a block and its CRC */
+} phase_t;
+
+static struct {
+  host_sd_spi_config_t cfg;
+  uint8_t *image;
+  int attached;
+  int cs_low;
+  hal_spi_baudrate_t baudrate;
+
+  int idle;  /* R1 in-idle-state bit: until ACMD41 completes */
+  int app;   /* CMD55 seen, next command is an ACMD */
+  int crc_on;
+  uint8_t init_left;
+
+  uint8_t frame[6];
+  uint8_t frame_len;
+  uint8_t out[600];
+  uint16_t out_len, out_pos;
+  uint32_t busy;
+
+  phase_t phase;
+  int multi;
+  int streaming_block; /* the queue holds a CMD18 block */
+  uint32_t block;      /* next block of a transfer */
+  uint8_t data[SS + 2];
+  uint16_t data_len;
+  uint32_t erase_start, erase_end;
+
+  uint8_t fail_cmd;
+  host_sd_spi_fault_t fail;
+  int data_fault; /* DATA_CRC armed for the current transfer */
+
+  host_sd_spi_stats_t stats;
+} sd;
+
+/* Zero [off, off + len) of the image; whole pages go back to the kernel and
+ * read as zeros from then on. */
+static void image_zero(size_t off, size_t len) {
+  size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  size_t lo = (off + page - 1U) / page * page;
+  size_t hi = (off + len) / page * page;
+  if (lo >= hi) {
+    memset(sd.image + off, 0, len);
+    return;
+  }
+  memset(sd.image + off, 0, lo - off);
+  madvise(sd.image + lo, hi - lo, MADV_DONTNEED);
+  memset(sd.image + hi, 0, off + len - hi);
+}
+
+/* ---- CRCs --------------------------------------------------------------- */
+
+static uint8_t crc7(const uint8_t *p, unsigned len) {
+  uint8_t crc = 0;
+  while (len--) {
+    uint8_t d = *p++;
+    for (int i = 0; i < 8; i++, d <<= 1) {
+      crc <<= 1;
+      if ((d ^ crc) & 0x80U)
+        crc ^= 0x09U;
+    }
+  }
+  return crc & 0x7FU;
+}
+
+static uint16_t crc16(const uint8_t *p, unsigned len) {
+  uint16_t crc = 0;
+  while (len--) {
+    crc ^= (uint16_t)(*p++ << 8);
+    for (int i = 0; i < 8; i++)
+      crc = (uint16_t)((crc & 0x8000U) ? ((unsigned)crc << 1) ^ 0x1021U
+                                        : (unsigned)crc << 1);
+  }
+  return crc;
+}
+
+/* ---- Output queue ------------------------------------------------------- */
+
+static void q_clear(void) { sd.out_len = sd.out_pos = 0; }
+
+static void q_put(uint8_t b) {
+  if (sd.out_len < sizeof(sd.out))
+    sd.out[sd.out_len++] = b;
+}
+
+/** NCR of one byte, then the R1. */
+static void q_r1(uint8_t r1) {
+  q_put(0xFF);
+  q_put(r1);
+}
+
+/** A data block: one gap byte, the start token, data, CRC16. */
+static void q_block(const uint8_t *p, unsigned len) {
+  uint16_t crc = crc16(p, len);
+  if (sd.data_fault) {
+    crc ^= 0x5A5AU;
+    sd.data_fault = 0;
+  }
+  q_put(0xFF);
+  q_put(0xFE);
+  for (unsigned i = 0; i < len; i++)
+    q_put(p[i]);
+  q_put((uint8_t)(crc >> 8));
+  q_put((uint8_t)crc);
+}
+
+/* ---- Registers ---------------------------------------------------------- */
+
+static int is_sdhc(void) { return !sd.cfg.sdsc && !sd.cfg.v1; }
+
+static void build_csd(uint8_t csd[16]) {
+  memset(csd, 0, 16);
+  if (is_sdhc()) {
+    uint32_t c_size = sd.cfg.sectors / 1024U - 1U;
+    csd[0] = 0x40; /* CSD 2.0 */
+    csd[5] = 0x59; /* CCC low nibble, READ_BL_LEN = 9 */
+    csd[7] = (uint8_t)((c_size >> 16) & 0x3FU);
+    csd[8] = (uint8_t)(c_size >> 8);
+    csd[9] = (uint8_t)c_size;
+  } else {
+    /* Smallest C_SIZE_MULT that fits C_SIZE in 12 bits. */
+    unsigned mult = 0;
+    while ((sd.cfg.sectors >> (mult + 2U)) > 4096U)
+      mult++;
+    uint32_t c_size = (sd.cfg.sectors >> (mult + 2U)) - 1U;
+    csd[5] = 0x59;
+    csd[6] = (uint8_t)((c_size >> 10) & 0x03U);
+    csd[7] = (uint8_t)(c_size >> 2);
+    csd[8] = (uint8_t)((c_size & 0x03U) << 6);
+    csd[9] = (uint8_t)((mult >> 1) & 0x03U);
+    csd[10] = (uint8_t)((mult & 1U) << 7);
+  }
+  /* ERASE_BLK_EN, SECTOR_SIZE = 127 (128 blocks), WRITE_BL_LEN = 9 */
+  csd[10] |= 0x40U | 0x3FU;
+  csd[11] = 0x80;
+  csd[12] = 0x02;
+  csd[13] = 0x40;
+  csd[15] = (uint8_t)((crc7(csd, 15) << 1) | 1U);
+}
+
+/** Block index for a data command, or -1 with @p r1 set. */
+static int64_t address(uint32_t arg, uint8_t *r1) {
+  uint32_t block = arg;
+  if (!is_sdhc()) {
+    if (arg % SS) {
+      *r1 = 0x20; /* address error */
+      return -1;
+    }
+    block = arg / SS;
+  }
+  if (block >= sd.cfg.sectors) {
+    *r1 = 0x40; /* parameter error */
+    return -1;
+  }
+  return block;
+}
+
+/* ---- Commands ----------------------------------------------------------- */
+
+static void exec(void) {
+  uint8_t cmd = sd.frame[0] & 0x3FU;
+  uint32_t arg = ((uint32_t)sd.frame[1] << 24) | ((uint32_t)sd.frame[2] << 16) |
+                 ((uint32_t)sd.frame[3] << 8) | sd.frame[4];
+  int app = sd.app;
+  sd.app = 0;
+  sd.stats.commands++;
+
+  if (sd.fail != HOST_SD_SPI_FAULT_NONE && sd.fail_cmd == cmd) {
+    host_sd_spi_fault_t f = sd.fail;
+    sd.fail = HOST_SD_SPI_FAULT_NONE;
+    if (f == HOST_SD_SPI_FAULT_NO_RESPONSE)
+      return;
+    if (f == HOST_SD_SPI_FAULT_CMD_CRC) {
+      q_r1((uint8_t)(0x08U | (sd.idle ? 1U : 0U)));
+      return;
+    }
+    sd.data_fault = 1;
+  }
+
+  if ((cmd == 0 || cmd == 8 || sd.crc_on) &&
+      sd.frame[5] != (uint8_t)((crc7(sd.frame, 5) << 1) | 1U)) {
+    q_r1((uint8_t)(0x08U | (sd.idle ? 1U : 0U)));
+    return;
+  }
+
+  uint8_t idle = sd.idle ? 1U : 0U;
+  switch (cmd) {
+  case 0:
+    sd.idle = 1;
+    sd.crc_on = 0;
+    sd.init_left = sd.cfg.init_polls;
+    sd.phase = PH_CMD;
+    sd.stats.cmd0_baudrate = sd.baudrate;
+    q_r1(0x01);
+    return;
+  case 8:
+    if (sd.cfg.v1) {
+      q_r1((uint8_t)(0x04U | idle));
+      return;
+    }
+    q_r1(idle);
+    q_put(0x00);
+    q_put(0x00);
+    q_put((uint8_t)((arg >> 8) & 0x0FU));
+    q_put((uint8_t)arg);
+    return;
+  case 55:
+    sd.app = 1;
+    q_r1(idle);
+    return;
+  case 41:
+    if (!app)
+      break;
+    if (sd.init_left) {
+      sd.init_left--;
+      q_r1(0x01);
+      return;
+    }
+    /* An SDHC card stays in idle until the host announces HCS. */
+    if (is_sdhc() && !(arg & (1UL << 30))) {
+      q_r1(0x01);
+      return;
+    }
+    sd.idle = 0;
+    q_r1(0x00);
+    return;
+  case 58:
+    q_r1(idle);
+    q_put((uint8_t)((sd.idle ? 0x00U : 0x80U) |
+                    (!sd.idle && is_sdhc() ? 0x40U : 0x00U)));
+    q_put(0xFF);
+    q_put(0x80);
+    q_put(0x00);
+    return;
+  case 59:
+    sd.crc_on = (int)(arg & 1U);
+    sd.stats.crc_on = (uint8_t)sd.crc_on;
+    q_r1(idle);
+    return;
+  default:
+    break;
+  }
+
+  if (sd.idle) {
+    q_r1(0x05); /* illegal before initialisation */
+    return;
+  }
+
+  uint8_t r1 = 0;
+  int64_t block;
+  switch (cmd) {
+  case 9: {
+    uint8_t csd[16];
+    build_csd(csd);
+    q_r1(0x00);
+    q_block(csd, sizeof(csd));
+    return;
+  }
+  case 12:
+    if (sd.phase == PH_READ && sd.streaming_block && sd.out_pos < sd.out_len)
+      sd.stats.blocks_read--; /* the block being prefetched is dropped */
+    q_clear();
+    sd.phase = PH_CMD;
+    sd.streaming_block = 0;
+    q_put(0xFF); /* stuff byte */
+    q_put(0x00);
+    return;
+  case 13:
+    q_r1(0x00);
+    q_put(0x00);
+    if (app) {
+      uint8_t status[64] = {0};
+      status[10] = (uint8_t)(sd.cfg.au_size << 4);
+      q_block(status, sizeof(status));
+    }
+    return;
+  case 16:
+    q_r1(arg == SS ? 0x00 : 0x40);
+    return;
+  case 17:
+  case 18:
+    if ((block = address(arg, &r1)) < 0) {
+      q_r1(r1);
+      return;
+    }
+    sd.stats.read_cmds++;
+    sd.stats.data_baudrate = sd.baudrate;
+    q_r1(0x00);
+    if (cmd == 17) {
+      q_block(sd.image + (size_t)block * SS, SS);
+      sd.stats.blocks_read++;
+    } else {
+      sd.phase = PH_READ;
+      sd.block = (uint32_t)block;
+    }
+    return;
+  case 23:
+    if (!app)
+      break;
+    sd.stats.pre_erase = arg;
+    q_r1(0x00);
+    return;
+  case 24:
+  case 25:
+    if ((block = address(arg, &r1)) < 0) {
+      q_r1(r1);
+      return;
+    }
+    sd.stats.write_cmds++;
+    sd.stats.data_baudrate = sd.baudrate;
+    sd.phase = PH_WRITE_WAIT;
+    sd.multi = cmd == 25;
+    sd.block = (uint32_t)block;
+    q_r1(0x00);
+    return;
+  case 32:
+  case 33:
+    if ((block = address(arg, &r1)) < 0) {
+      q_r1(r1);
+      return;
+    }
+    if (cmd == 32)
+      sd.erase_start = (uint32_t)block;
+    else
+      sd.erase_end = (uint32_t)block;
+    q_r1(0x00);
+    return;
+  case 38:
+    if (sd.erase_end < sd.erase_start) {
+      q_r1(0x10); /* erase sequence error */
+      return;
+    }
+    image_zero((size_t)sd.erase_start * SS,
+               (size_t)(sd.erase_end - sd.erase_start + 1U) * SS);
+    sd.stats.erases++;
+    q_r1(0x00);
+    sd.busy = sd.cfg.busy_bytes;
+    return;
+  default:
+    break;
+  }
+  q_r1(0x04); /* illegal command */
+}
+
+/** A written block (and its CRC) is complete. */
+static void program_block(void) {
+  uint16_t crc = (uint16_t)((sd.data[SS] << 8) | sd.data[SS + 1]);
+  int bad_crc = sd.data_fault || (sd.crc_on && crc != crc16(sd.data, SS));
+  sd.data_fault = 0;
+  sd.phase = sd.multi ? PH_WRITE_WAIT : PH_CMD;
+  if (bad_crc) {
+    q_put(0x0B); /* data rejected: CRC error */
+    return;
+  }
+  if (sd.block >= sd.cfg.sectors) {
+    q_put(0x0D); /* data rejected: write error */
+    return;
+  }
+  memcpy(sd.image + (size_t)sd.block * SS, sd.data, SS);
+  sd.block++;
+  sd.stats.blocks_written++;
+  q_put(0xE5); /* data accepted */
+  sd.busy = sd.cfg.busy_bytes;
+}
+
+static void card_in(uint8_t in) {
+  switch (sd.phase) {
+  case PH_WRITE_WAIT:
+    if (in == (sd.multi ? 0xFCU : 0xFEU)) {
+      sd.phase = PH_WRITE_DATA;
+      sd.data_len = 0;
+    } else if (sd.multi && in == 0xFDU) {
+      q_put(0xFF); /* one byte before busy starts */
+      sd.busy = sd.cfg.busy_bytes;
+      sd.phase = PH_CMD;
+    }
+    return;
+  case PH_WRITE_DATA:
+    sd.data[sd.data_len++] = in;
+    if (sd.data_len == sizeof(sd.data))
+      program_block();
+    return;
+  default:
+    break;
+  }
+
+  if (sd.frame_len == 0 && (in & 0xC0U) != 0x40U)
+    return;
+  sd.frame[sd.frame_len++] = in;
+  if (sd.frame_len == sizeof(sd.frame)) {
+    sd.frame_len = 0;
+    exec();
+  }
+}
+
+static uint8_t card_out(void) {
+  if (sd.out_pos == sd.out_len && sd.phase == PH_READ && sd.busy == 0) {
+    q_clear();
+    sd.streaming_block = 0;
+    if (sd.block >= sd.cfg.sectors) {
+      q_put(0x08); /* error token: out of range */
+      sd.phase = PH_CMD;
+    } else {
+      q_block(sd.image + (size_t)sd.block * SS, SS);
+      sd.block++;
+      sd.stats.blocks_read++;
+      sd.streaming_block = 1;
+    }
+  }
+  if (sd.out_pos < sd.out_len) {
+    uint8_t b = sd.out[sd.out_pos++];
+    if (sd.out_pos == sd.out_len)
+      q_clear();
+    return b;
+  }
+  if (sd.busy) {
+    sd.busy--;
+    sd.stats.busy_bytes++;
+    return 0x00;
+  }
+  return 0xFF;
+}
+
+/* ---- Chip select -------------------------------------------------------- */
+
+/* hal_gpio_write only ever sets one of the pin's two BSRR bits; consume it. */
+static void cs_sample(void) {
+  GPIOx_Typedef *port = GPIO_GET_PORT(BOARD_SD_SPI_CS);
+  uint32_t bit = 1U << GPIO_GET_PIN(BOARD_SD_SPI_CS);
+  uint32_t bsrr = port->BSRR;
+  if (bsrr & (bit << 16))
+    sd.cs_low = 1;
+  if (bsrr & bit) {
+    if (sd.cs_low) {
+      /* Deselecting ends any transfer in progress; busy carries on. */
+      sd.frame_len = 0;
+      q_clear();
+      sd.phase = PH_CMD;
+      sd.streaming_block = 0;
+    }
+    sd.cs_low = 0;
+  }
+  port->BSRR = 0;
+}
+
+static uint8_t exchange(uint8_t in) {
+  cs_sample();
+  if (!sd.attached || !sd.cs_low)
+    return 0xFF;
+  uint8_t out = card_out();
+  card_in(in);
+  return out;
+}
+
+/* ---- hal_spi, as seen by the driver ------------------------------------- */
+
+hal_status_t hal_spi_init(hal_spi_instance_t spi,
+                          const hal_spi_config_t *config) {
+  if (spi != BOARD_SD_SPI_BUS || !config)
+    return HAL_ERR_INVALID_ARG;
+  sd.baudrate = config->baudrate;
+  return HAL_OK;
+}
+
+hal_status_t hal_spi_transmit(hal_spi_instance_t spi, const uint8_t *data,
+                              uint16_t size, uint32_t timeout) {
+  if (spi != BOARD_SD_SPI_BUS || !data)
+    return HAL_ERR_INVALID_ARG;
+  for (uint16_t i = 0; i < size; i++)
+    (void)exchange(data[i]);
+  return HAL_OK;
+}
+
+hal_status_t hal_spi_receive(hal_spi_instance_t spi, uint8_t *data,
+                             uint16_t size, uint32_t timeout) {
+  if (spi != BOARD_SD_SPI_BUS || !data)
+    return HAL_ERR_INVALID_ARG;
+  for (uint16_t i = 0; i < size; i++)
+    data[i] = exchange(0xFF);
+  return HAL_OK;
+}
+
+hal_status_t hal_spi_transmit_receive(hal_spi_instance_t spi,
+                                      const uint8_t *tx_data, uint8_t *rx_data,
+                                      uint16_t size, uint32_t timeout) {
+  if (spi != BOARD_SD_SPI_BUS || !tx_data || !rx_data)
+    return HAL_ERR_INVALID_ARG;
+  for (uint16_t i = 0; i < size; i++)
+    rx_data[i] = exchange(tx_data[i]);
+  return HAL_OK;
+}
+
+/* ---- Test API ----------------------------------------------------------- */
+
+bool host_sd_spi_attach(const host_sd_spi_config_t *cfg) {
+  if (!cfg || !cfg->sectors)
+    return false;
+  if ((cfg->sdsc || cfg->v1) ? (cfg->sectors % 4U) != 0
+                             : (cfg->sectors % 1024U) != 0)
+    return false;
+  host_sd_spi_detach();
+  void *image = mmap(NULL, (size_t)cfg->sectors * SS, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (image == MAP_FAILED)
+    return false;
+  sd.image = image;
+  sd.cfg = *cfg;
+  sd.idle = 1;
+  sd.init_left = cfg->init_polls;
+  sd.attached = 1;
+  return true;
+}
+
+void host_sd_spi_detach(void) {
+  if (sd.image)
+    munmap(sd.image, (size_t)sd.cfg.sectors * SS);
+  hal_spi_baudrate_t baudrate = sd.baudrate;
+  memset(&sd, 0, sizeof(sd));
+  sd.baudrate = baudrate;
+}
+
+void host_sd_spi_fail_next(uint8_t cmd, host_sd_spi_fault_t fault) {
+  sd.fail_cmd = cmd;
+  sd.fail = fault;
+}
+
+uint8_t *host_sd_spi_image(void) { return sd.image; }
+
+host_sd_spi_stats_t host_sd_spi_stats(void) { return sd.stats; }
+
+void host_sd_spi_reset_stats(void) {
+  memset(&sd.stats, 0, sizeof(sd.stats));
+  sd.stats.crc_on = (uint8_t)sd.crc_on;
+  sd.stats.cmd0_baudrate = sd.baudrate;
+  sd.stats.data_baudrate = sd.baudrate;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file host_sd_spi.h
+ * @brief Behavioural SD card in SPI mode, standing in for hal_spi.
+ *
+ * @details
+ * The model provides hal_spi_init / hal_spi_transmit / hal_spi_receive /
+ * hal_spi_transmit_receive itself, so src/utils/sd_spi.c — and FatFs above
+ * it — run unmodified with the card on the other end of every byte. Chip
+ * select is read back from the GPIO BSRR writes hal_gpio_write makes to the
+ * simulated port (host_mmio.h), on the board.h @c BOARD_SD_SPI_CS pin.
+ *
+ * - Commands are decoded when their sixth byte arrives and answered after
+ *   one byte of NCR. CMD0 and CMD8 must carry a valid CRC7; after CMD59
+ *   every command and every written data block must too.
+ * - Supported: CMD0, 8, 9, 12, 13, 16, 17, 18, 24, 25, 32, 33, 38, 55, 58,
+ *   59 and ACMD13, 23, 41. An SD 1.x card rejects CMD8; standard-capacity
+ *   cards are byte addressed, SDHC cards block addressed.
+ * - CMD18 streams blocks until CMD12; CMD25 takes 0xFC blocks until the
+ *   0xFD stop token. After each written block, the stop token and CMD38 the
+ *   card holds DO low for ::host_sd_spi_config_t::busy_bytes bytes.
+ * - Reads past the end get an out-of-range error token, and a start address
+ *   past the end a parameter error.
+ */
+#ifndef HOST_SD_SPI_H
+#define HOST_SD_SPI_H
+
+#include "common/hal_spi.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief Failure injected by ::host_sd_spi_fail_next. */
+typedef enum {
+  HOST_SD_SPI_FAULT_NONE = 0,
+  HOST_SD_SPI_FAULT_NO_RESPONSE, /**< DO stays high; not executed */
+  HOST_SD_SPI_FAULT_CMD_CRC,     /**< R1 reports a command CRC error */
+  HOST_SD_SPI_FAULT_DATA_CRC     /**< First data block gets a bad CRC16, or
+                                      the written one is answered 0x0B */
+} host_sd_spi_fault_t;
+
+/** @brief The card to insert. */
+typedef struct {
+  uint32_t sectors;    /**< Capacity in 512-byte sectors: a multiple of 1024
+                            (SDHC) or of 4 (standard capacity) */
+  uint8_t sdsc;        /**< 1 = standard capacity: byte addresses, CSD v1 */
+  uint8_t v1;          /**< 1 = SD 1.x: no CMD8 (implies sdsc) */
+  uint8_t au_size;     /**< SD_STATUS AU_SIZE code, 0 = not reported */
+  uint8_t init_polls;  /**< ACMD41 replies that still report idle */
+  uint16_t busy_bytes; /**< Busy bytes after a written block or an erase */
+} host_sd_spi_config_t;
+
+/** @brief Counters since attach or ::host_sd_spi_reset_stats. */
+typedef struct {
+  uint32_t commands;       /**< Complete command frames, answered or not */
+  uint32_t read_cmds;      /**< CMD17 + CMD18 accepted */
+  uint32_t write_cmds;     /**< CMD24 + CMD25 accepted */
+  uint32_t blocks_read;    /**< Blocks sent in full */
+  uint32_t blocks_written; /**< Blocks programmed */
+  uint32_t erases;         /**< CMD38 erases performed */
+  uint32_t busy_bytes;     /**< Bytes answered with DO held low */
+  uint32_t pre_erase;      /**< Argument of the last ACMD23 */
+  uint8_t crc_on;          /**< CMD59 state */
+  hal_spi_baudrate_t cmd0_baudrate; /**< Bus divider when CMD0 arrived */
+  hal_spi_baudrate_t data_baudrate; /**< Divider at the last data command */
+} host_sd_spi_stats_t;
+
+/**
+ * @brief Insert a card with zeroed contents, powered up and not yet in SPI
+ *        mode. Call after ::host_mmio_setup.
+ * @return false for a bad configuration or if the image cannot be allocated.
+ */
+bool host_sd_spi_attach(const host_sd_spi_config_t *cfg);
+
+/** @brief Remove the card; the bus then reads 0xFF, as with no card. */
+void host_sd_spi_detach(void);
+
+/** @brief Make the next use of command @p cmd (or ACMD @p cmd) fail. */
+void host_sd_spi_fail_next(uint8_t cmd, host_sd_spi_fault_t fault);
+
+/** @brief The card contents (::host_sd_spi_config_t::sectors * 512 bytes). */
+uint8_t *host_sd_spi_image(void);
+
+/** @brief Counters since attach or the last ::host_sd_spi_reset_stats. */
+host_sd_spi_stats_t host_sd_spi_stats(void);
+
+/** @brief Zero the counters (the CMD59 state is kept). */
+void host_sd_spi_reset_stats(void);
+
+#endif /* HOST_SD_SPI_H */
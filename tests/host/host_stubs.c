@@ -21,23 +21,80 @@
  *        call but that aren't part of the driver suite (NVIC, timebase, FPU).
  *
  * The timebase counter advances on every read so that driver timeout loops
- * (`hal_spi_*`) terminate deterministically.
+ * (`hal_spi_*`) terminate deterministically; a test can hook those reads
+ * to deliver simulated interrupts while a driver waits. The NVIC stub
+ * records which lines are enabled and which callbacks are attached, so the
+ * simulated DMA engine (host_mmio.c) only raises interrupts a driver has
+ * asked for.
  */
 
 #include "common/hal_status.h"
+#include "host_mmio.h"
 #include "navhal_port_interrupt.h"
 #include <stdint.h>
+#include <string.h>
 
 static uint32_t s_millis = 0;
-uint32_t hal_timebase_get_millis(void) { return s_millis++; }
+static void (*s_millis_hook)(void);
+uint32_t hal_timebase_get_millis(void) {
+  if (s_millis_hook)
+    s_millis_hook();
+  return s_millis++;
+}
 uint32_t hal_timebase_get_micros(void) { return s_millis++; }
 uint32_t hal_timebase_get_tick(void) { return s_millis++; }
+/* Card power-up and busy polls (sdio.c) need no real time to pass. */
+void hal_delay_ms(uint32_t ms) { s_millis += ms; }
+
+void host_timebase_set_hook(void (*hook)(void)) { s_millis_hook = hook; }
 
+#define HOST_MAX_IRQ 128
+static uint32_t s_irq_enabled[HOST_MAX_IRQ / 32];
+static hal_interrupt_callback_t s_irq_callbacks[HOST_MAX_IRQ];
+
+hal_status_t hal_interrupt_enable_with_priority(hal_irq_t irq,
+                                                uint8_t priority) {
+  (void)priority;
+  if (irq < 0 || irq >= HOST_MAX_IRQ)
+    return HAL_ERR_INVALID_ARG;
+  s_irq_enabled[irq / 32] |= 1U << (irq % 32);
+  return HAL_OK;
+}
 hal_status_t hal_interrupt_enable(hal_irq_t irq) {
-  (void)irq;
+  return hal_interrupt_enable_with_priority(irq, HAL_IRQ_PRIORITY_DEFAULT);
+}
+hal_status_t hal_interrupt_set_priority(hal_irq_t irq, uint8_t priority) {
+  (void)priority;
+  if (irq < 0 || irq >= HOST_MAX_IRQ)
+    return HAL_ERR_INVALID_ARG;
   return HAL_OK;
 }
 hal_status_t hal_interrupt_disable(hal_irq_t irq) {
-  (void)irq;
+  if (irq < 0 || irq >= HOST_MAX_IRQ)
+    return HAL_ERR_INVALID_ARG;
+  s_irq_enabled[irq / 32] &= ~(1U << (irq % 32));
   return HAL_OK;
 }
+hal_status_t hal_interrupt_attach_callback(hal_irq_t irq,
+                                           hal_interrupt_callback_t callback) {
+  if (irq < 0 || irq >= HOST_MAX_IRQ)
+    return HAL_ERR_INVALID_ARG;
+  s_irq_callbacks[irq] = callback;
+  return HAL_OK;
+}
+hal_status_t hal_interrupt_detach_callback(hal_irq_t irq) {
+  return hal_interrupt_attach_callback(irq, NULL);
+}
+void hal_interrupt_dispatch(hal_irq_t irq) {
+  if (irq >= 0 && irq < HOST_MAX_IRQ && s_irq_callbacks[irq])
+    s_irq_callbacks[irq]();
+}
+
+bool host_irq_enabled(int irq) {
+  return irq >= 0 && irq < HOST_MAX_IRQ &&
+         (s_irq_enabled[irq / 32] & (1U << (irq % 32))) != 0;
+}
+void host_irq_reset(void) {
+  memset(s_irq_enabled, 0, sizeof(s_irq_enabled));
+  memset(s_irq_callbacks, 0, sizeof(s_irq_callbacks));
+}
@@ -26,8 +26,10 @@
 #include "navtest/navtest.h"
 #include "test_conversion.h"
 #include "test_crc_sw.h"
+#include "test_disk_cache.h"
 #include "test_gpio_encoding.h"
 #include "test_hal_status.h"
+#include "test_lat_hist.h"
 
 #include <stdio.h>
 
@@ -36,6 +38,8 @@ static const navtest_suite_t *const host_suites[] = {
     &test_conversion_suite,
     &test_crc_sw_suite,
     &test_gpio_encoding_suite,
+    &test_disk_cache_suite,
+    &test_lat_hist_suite,
 };
 
 int main(void) {
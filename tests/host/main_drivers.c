@@ -32,11 +32,14 @@ extern const navtest_suite_t test_i2c_driver_suite;
 extern const navtest_suite_t test_spi_driver_suite;
 extern const navtest_suite_t test_clock_driver_suite;
 extern const navtest_suite_t test_flash_driver_suite;
+extern const navtest_suite_t test_dma_driver_suite;
+extern const navtest_suite_t test_sdio_driver_suite;
 
 static const navtest_suite_t *const driver_suites[] = {
     &test_gpio_driver_suite,  &test_uart_driver_suite,
     &test_i2c_driver_suite,   &test_spi_driver_suite,
     &test_clock_driver_suite, &test_flash_driver_suite,
+    &test_dma_driver_suite,   &test_sdio_driver_suite,
 };
 
 int main(void) {
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file tests/host/main_sd_bench.c
+ * @brief Entry point for the SD benchmark on the host SD card model.
+ *
+ * @details
+ * Without arguments it runs the benchmark's test suite (ctest). With
+ * @c --sweep it is the hardware-free run mode of sample 29_hal_sd_bench:
+ * the full default sweep runs against a fresh model card and its JSON lines
+ * go to stdout, in the same format the board prints over UART, for
+ * comparing host-side tooling or driver changes without a board. An
+ * optional second argument names the card image file to use.
+ *
+ * A build of its own because sdio.c initialises the card once per process
+ * and the driver suite removes its card at the end.
+ */
+
+#include "host_mmio.h"
+#include "host_sd.h"
+#include "sd_bench.h"
+#include "common/hal_diskio.h"
+#include "common/hal_sdio.h"
+#include "family/rcc_reg.h"
+#include "ff.h"
+#include "navtest/navtest.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+extern const navtest_suite_t test_sd_bench_suite;
+
+static void out(const char *s) { fputs(s, stdout); }
+
+static uint32_t host_clock(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+
+static int sweep(const char *image) {
+  static uint8_t buf[16384 + 4] __attribute__((aligned(4)));
+  static const uint32_t sizes[] = {512, 4096, 16384};
+  static const uint16_t counts[] = {8, 32};
+  static const uint8_t aligns[] = {0, 1};
+  static FATFS fs;
+  static uint8_t work[FF_MAX_SS];
+
+  const host_sd_config_t card = {.image = image,
+                                 .sectors = 65536, /* 32 MiB */
+                                 .au_size = 7,
+                                 .busy_polls = 4};
+  if (!host_sd_attach(&card)) {
+    fputs("sd_bench: register trapping unavailable\n", stderr);
+    return 1;
+  }
+  RCC->PLLCFGR = 8U | (192U << 6) | (8U << 24);
+  RCC->CFGR = 0x2U << 2;
+  const hal_sdio_config_t sd = {.bus_width = 1};
+  if (hal_sdio_init(&sd) != HAL_SDIO_OK || hal_sdio_card_init() != HAL_SDIO_OK ||
+      hal_disk_initialize(0) != HAL_DISK_STATUS_OK) {
+    fputs("sd_bench: card initialisation failed\n", stderr);
+    return 1;
+  }
+
+  sd_bench_config_t cfg = {.puts = out,
+                           .clock = host_clock,
+                           .clock_hz = 1000000000U,
+                           .bus_hz = hal_sdio_get_bus_clock(),
+                           .buf = buf,
+                           .buf_len = sizeof(buf),
+                           .sizes = sizes,
+                           .n_sizes = 3,
+                           .counts = counts,
+                           .n_counts = 2,
+                           .aligns = aligns,
+                           .n_aligns = 2,
+                           .layers = SD_BENCH_SDIO | SD_BENCH_DISK,
+                           .lba = 0,
+                           .sectors = card.sectors,
+                           .path = "0:BENCH.BIN"};
+  uint32_t failed = sd_bench_run(&cfg);
+
+  /* The raw layers are done with the card: format it for the FatFs runs. */
+  if (f_mkfs("0:", NULL, work, sizeof(work)) != FR_OK ||
+      f_mount(&fs, "0:", 1) != FR_OK) {
+    fputs("sd_bench: cannot format the card\n", stderr);
+    return 1;
+  }
+  cfg.layers = SD_BENCH_FATFS;
+  failed += sd_bench_run(&cfg);
+  f_mount(NULL, "0:", 0);
+  host_sd_detach();
+  return failed != 0;
+}
+
+int main(int argc, char **argv) {
+  host_mmio_setup();
+
+  if (argc > 1 && strcmp(argv[1], "--sweep") == 0)
+    return sweep(argc > 2 ? argv[2] : NULL);
+
+  navtest_write("\r\n"
+                "|========================================|\r\n"
+                "|    NAVHAL host SD benchmark suite      |\r\n"
+                "|========================================|\r\n");
+
+  int failed = navtest_run_suite(&test_sd_bench_suite);
+
+  navtest_write("\n=========== FINAL RESULTS ===========\n");
+  navtest_write("Total tests run: ");
+  _navtest_print_uint32(test_sd_bench_suite.count);
+  navtest_write("\nTotal failures:  ");
+  _navtest_print_uint32((uint32_t)failed);
+  navtest_write("\n");
+  return failed;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file tests/host/main_sd_spi.c
+ * @brief Entry point for the host SD-over-SPI suites (sd_spi.c, and v_fs
+ *        on top of it, with the RAM disk as a second drive). A build of its
+ *        own because sd_spi.c provides hal_disk_* and hal_spi_* is the card
+ *        model, where the driver suite links the SDIO backend and spi_f7.c.
+ */
+
+#include "host_mmio.h"
+#include "navtest/navtest.h"
+
+#include <stddef.h>
+
+extern const navtest_suite_t test_sd_spi_suite;
+extern const navtest_suite_t test_v_fs_suite;
+extern const navtest_suite_t test_ram_disk_suite;
+
+static const navtest_suite_t *const sd_spi_suites[] = {
+    &test_sd_spi_suite,
+    &test_v_fs_suite,
+    &test_ram_disk_suite,
+};
+
+int main(void) {
+  host_mmio_setup();
+
+  navtest_write("\r\n"
+                "|========================================|\r\n"
+                "|    NAVHAL host SD-over-SPI suite       |\r\n"
+                "|========================================|\r\n");
+
+  int failed = 0;
+  uint32_t total = 0;
+  const size_t n = sizeof(sd_spi_suites) / sizeof(sd_spi_suites[0]);
+  for (size_t i = 0; i < n; i++) {
+    failed += navtest_run_suite(sd_spi_suites[i]);
+    total += sd_spi_suites[i]->count;
+  }
+
+  navtest_write("\n=========== FINAL RESULTS ===========\n");
+  navtest_write("Total tests run: ");
+  _navtest_print_uint32(total);
+  navtest_write("\nTotal failures:  ");
+  _navtest_print_uint32((uint32_t)failed);
+  navtest_write("\n");
+  return failed;
+}
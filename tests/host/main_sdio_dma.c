@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file tests/host/main_sdio_dma.c
+ * @brief Entry point for the host suite of the SDIO DMA backend. A build of
+ *        its own because sdio.c and diskio.c are compiled with the request
+ *        queue here, where the driver suite links their polled form.
+ */
+
+#include "host_mmio.h"
+#include "navtest/navtest.h"
+
+extern const navtest_suite_t test_sdio_dma_suite;
+
+int main(void) {
+  host_mmio_setup();
+
+  navtest_write("\r\n"
+                "|========================================|\r\n"
+                "|    NAVHAL host SDIO DMA suite          |\r\n"
+                "|========================================|\r\n");
+
+  int failed = navtest_run_suite(&test_sdio_dma_suite);
+
+  navtest_write("\n=========== FINAL RESULTS ===========\n");
+  navtest_write("Total tests run: ");
+  _navtest_print_uint32(test_sdio_dma_suite.count);
+  navtest_write("\nTotal failures:  ");
+  _navtest_print_uint32((uint32_t)failed);
+  navtest_write("\n");
+  return failed;
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file tests/host/main_vfs_bench.c
+ * @brief Entry point for the v_fs benchmark on the file-backed host disk.
+ *
+ * @details
+ * Without arguments it runs the benchmark's test suite (ctest). With
+ * @c --bench it formats a fresh volume and runs the default workloads —
+ * appends in three record sizes, random reads of each appended file and
+ * create/delete churn — printing one JSON line per workload after a
+ * @c meta line that records the disk and the FatFs / v_fs build options:
+ *
+ *   tests_host_vfs_bench --bench [--image FILE] [--sectors N]
+ *                        [--cmd-us N] [--read-us N] [--write-us N] [--sleep]
+ *
+ * The sector counts are deterministic for a given build, so two builds of
+ * this target with different options can be compared line by line.
+ */
+
+#include "host_disk_file.h"
+#include "vfs_bench.h"
+#include "utils/v_fs.h"
+#include "ff.h"
+#include "navtest/navtest.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* As v_fs.c resolves them without Kconfig, for the meta line. */
+#ifndef V_FS_FASTSEEK
+#define V_FS_FASTSEEK 0
+#endif
+#ifndef V_FS_WRITE_BUFFER
+#define V_FS_WRITE_BUFFER 0
+#endif
+#ifndef V_FS_DCACHE
+#define V_FS_DCACHE 0
+#endif
+
+extern const navtest_suite_t test_vfs_bench_suite;
+
+static void out(const char *s) { fputs(s, stdout); }
+
+static int bench(int argc, char **argv) {
+  static uint8_t buf[4096];
+  static uint8_t work[FF_MAX_SS];
+  static const uint32_t records[] = {64, 512, 4096};
+
+  host_disk_file_config_t disk = {.sectors = 131072, /* 64 MiB */
+                                  .cmd_us = 100,
+                                  .read_us = 25,
+                                  .write_us = 50};
+  for (int i = 2; i < argc; i++) {
+    const char *val = i + 1 < argc ? argv[i + 1] : NULL;
+    if (strcmp(argv[i], "--sleep") == 0) {
+      disk.sleep = 1;
+      continue;
+    }
+    if (val == NULL)
+      goto usage;
+    if (strcmp(argv[i], "--image") == 0)
+      disk.image = val;
+    else if (strcmp(argv[i], "--sectors") == 0)
+      disk.sectors = (uint32_t)strtoul(val, NULL, 0);
+    else if (strcmp(argv[i], "--cmd-us") == 0)
+      disk.cmd_us = (uint32_t)strtoul(val, NULL, 0);
+    else if (strcmp(argv[i], "--read-us") == 0)
+      disk.read_us = (uint32_t)strtoul(val, NULL, 0);
+    else if (strcmp(argv[i], "--write-us") == 0)
+      disk.write_us = (uint32_t)strtoul(val, NULL, 0);
+    else
+      goto usage;
+    i++;
+  }
+
+  if (!host_disk_file_attach(&disk)) {
+    fputs("vfs_bench: cannot open the disk image\n", stderr);
+    return 1;
+  }
+  if (f_mkfs("0:", NULL, work, sizeof(work)) != FR_OK || v_fs_init() != 0) {
+    fputs("vfs_bench: cannot format the disk\n", stderr);
+    return 1;
+  }
+
+  for (uint32_t i = 0; i < sizeof(buf); i++)
+    buf[i] = (uint8_t)(i * 7U + 0x5A);
+
+  printf("{\"type\":\"meta\",\"version\":1,\"sectors\":%" PRIu32
+         ",\"cmd_us\":%" PRIu32 ",\"read_us\":%" PRIu32
+         ",\"write_us\":%" PRIu32 ",\"ff_fs_tiny\":%d,\"ff_use_lfn\":%d"
+         ",\"ff_fs_exfat\":%d,\"fastseek\":%d,\"write_buffer\":%d"
+         ",\"wbuf_sectors\":%u,\"dcache\":%d}\r\n",
+         disk.sectors, disk.cmd_us, disk.read_us, disk.write_us, FF_FS_TINY,
+         FF_USE_LFN, FF_FS_EXFAT, V_FS_FASTSEEK, V_FS_WRITE_BUFFER,
+         (unsigned)V_FS_WBUF_SECTORS, V_FS_DCACHE);
+
+  uint32_t points = 0, failed = 0;
+  vfs_bench_result_t r;
+  for (uint32_t i = 0; i < sizeof(records) / sizeof(records[0]); i++) {
+    const uint32_t n = (1024U * 1024U) / records[i]; /* 1 MiB per file */
+    r = vfs_bench_append("APPEND.BIN", buf, records[i], n);
+    vfs_bench_print(&r, out);
+    failed += r.err != 0;
+    r = vfs_bench_seek("APPEND.BIN", buf, records[i], 1000, 1);
+    vfs_bench_print(&r, out);
+    failed += r.err != 0;
+    points += 2;
+  }
+  r = vfs_bench_churn("CHURN", buf, 2048, 64, 4);
+  vfs_bench_print(&r, out);
+  failed += r.err != 0;
+  points++;
+
+  printf("{\"type\":\"done\",\"points\":%" PRIu32 ",\"failed\":%" PRIu32
+         "}\r\n",
+         points, failed);
+  f_mount(NULL, "0:", 0);
+  host_disk_file_detach();
+  return failed != 0;
+
+usage:
+  fputs("usage: tests_host_vfs_bench --bench [--image FILE] [--sectors N]\n"
+        "         [--cmd-us N] [--read-us N] [--write-us N] [--sleep]\n",
+        stderr);
+  return 2;
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1 && strcmp(argv[1], "--bench") == 0)
+    return bench(argc, argv);
+
+  navtest_write("\r\n"
+                "|========================================|\r\n"
+                "|    NAVHAL host v_fs benchmark suite    |\r\n"
+                "|========================================|\r\n");
+
+  int failed = navtest_run_suite(&test_vfs_bench_suite);
+
+  navtest_write("\n=========== FINAL RESULTS ===========\n");
+  navtest_write("Total tests run: ");
+  _navtest_print_uint32(test_vfs_bench_suite.count);
+  navtest_write("\nTotal failures:  ");
+  _navtest_print_uint32((uint32_t)failed);
+  navtest_write("\n");
+  return failed;
+}
@@ -19,8 +19,12 @@
  * @file navhal_target.h (host driver-suite stub)
  * @brief The embedded build generates this from Kconfig; the host driver suite
  *        compiles the vendor drivers directly, so the capabilities here only
- *        need to satisfy navhal_port_config.h. The DMA-backend caps are off so
- *        no DMA code paths are pulled into the host build.
+ *        need to satisfy navhal_port_config.h. DMA itself is on — dma.c runs
+ *        against the simulated engine in host_mmio.c — but the per-driver
+ *        DMA-backend caps stay off. SDIO is built in its polled form and
+ *        runs against the card model in host_sd.c; tests_host_sdio_dma
+ *        overrides NAVHAL_HAS_SDIO_DMA to build its request queue instead,
+ *        and its _cache variant NAVHAL_HAS_CACHE (host_cache.c).
  */
 #ifndef NAVHAL_TARGET_H
 #define NAVHAL_TARGET_H
@@ -34,13 +38,18 @@
 #define NAVHAL_HAS_INTERRUPT 1
 #define NAVHAL_HAS_FLASH 1
 #define NAVHAL_HAS_CRC_HW 1
-#define NAVHAL_HAS_DMA 0
+#define NAVHAL_HAS_DMA 1
 #define NAVHAL_HAS_FPU 0
 #define NAVHAL_HAS_CYCLE_COUNTER 0
-#define NAVHAL_HAS_SDIO 0
+#define NAVHAL_HAS_SDIO 1
 #define NAVHAL_HAS_UART_DMA 0
 #define NAVHAL_HAS_I2C_DMA 0
+#ifndef NAVHAL_HAS_SDIO_DMA
 #define NAVHAL_HAS_SDIO_DMA 0
+#endif
+#ifndef NAVHAL_HAS_CACHE
+#define NAVHAL_HAS_CACHE 0
+#endif
 
 #define NAVHAL_TARGET_ARCH "cortex-m7"
 #define NAVHAL_TARGET_VENDOR "stm32"
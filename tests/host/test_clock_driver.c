@@ -19,11 +19,13 @@
  * @file test_clock_driver.c
  * @brief Deep host (SIL) tests for clock_f7.c clock-getter math against
  *        simulated RCC. Pre-seeds CFGR (source + prescalers) and PLLCFGR and
- *        asserts get_sysclk / ahb / apb1 / apb2 decode correctly.
+ *        asserts get_sysclk / ahb / apb1 / apb2 decode correctly, plus the
+ *        FLASH_ACR accelerator state hal_clock_init leaves behind.
  */
 
 #include "host_mmio.h"
 #include "navhal_port_clock.h"
+#include "family/flash_reg.h"
 #include "family/rcc_reg.h"
 #include "navtest/navtest.h"
 #include <stdint.h>
@@ -92,6 +94,30 @@ void test_host_clock_init_rejects_null(void) {
                            (uint32_t)hal_clock_init(&cfg, NULL));
 }
 
+void test_host_clock_init_enables_accel(void) {
+  host_mmio_reset();
+  RCC->CR |= RCC_CR_HSIRDY;
+  hal_clock_config_t cfg = {.source = HAL_CLOCK_SOURCE_HSI};
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_OK,
+                           (uint32_t)hal_clock_init(&cfg, NULL));
+  TEST_ASSERT_EQUAL_UINT32(FLASH_ACR_PRFTEN | FLASH_ACR_ARTEN,
+                           FLASH_ACR & (FLASH_ACR_PRFTEN | FLASH_ACR_ARTEN |
+                                        FLASH_ACR_ARTRST));
+}
+
+void test_host_clock_accel_opt_out(void) {
+  host_mmio_reset();
+  RCC->CR |= RCC_CR_HSIRDY;
+  FLASH_ACR = FLASH_ACR_PRFTEN | FLASH_ACR_ARTEN;
+  hal_clock_config_t cfg = {.source = HAL_CLOCK_SOURCE_HSI,
+                            .accel_disable = HAL_CLOCK_ACCEL_NONE};
+  hal_clock_init(&cfg, NULL);
+  TEST_ASSERT_EQUAL_UINT32(0u, FLASH_ACR & ~FLASH_ACR_LATENCY_Msk);
+
+  hal_clock_set_accel(HAL_CLOCK_ACCEL_NO_ICACHE);
+  TEST_ASSERT_EQUAL_UINT32(FLASH_ACR_PRFTEN, FLASH_ACR);
+}
+
 NAVTEST_CASE_DECL(test_host_clock_sysclk_hsi);
 NAVTEST_CASE_DECL(test_host_clock_sysclk_hse);
 NAVTEST_CASE_DECL(test_host_clock_sysclk_pll_from_hsi);
@@ -100,6 +126,8 @@ NAVTEST_CASE_DECL(test_host_clock_ahb_prescaler);
 NAVTEST_CASE_DECL(test_host_clock_apb1_prescaler);
 NAVTEST_CASE_DECL(test_host_clock_apb2_prescaler);
 NAVTEST_CASE_DECL(test_host_clock_init_rejects_null);
+NAVTEST_CASE_DECL(test_host_clock_init_enables_accel);
+NAVTEST_CASE_DECL(test_host_clock_accel_opt_out);
 
 static const navtest_case_t clock_driver_cases[] = {
     NAVTEST_CASE(test_host_clock_sysclk_hsi),
@@ -110,6 +138,8 @@ static const navtest_case_t clock_driver_cases[] = {
     NAVTEST_CASE(test_host_clock_apb1_prescaler),
     NAVTEST_CASE(test_host_clock_apb2_prescaler),
     NAVTEST_CASE(test_host_clock_init_rejects_null),
+    NAVTEST_CASE(test_host_clock_init_enables_accel),
+    NAVTEST_CASE(test_host_clock_accel_opt_out),
 };
 
 const navtest_suite_t test_clock_driver_suite = {
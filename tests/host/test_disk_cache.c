@@ -0,0 +1,308 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file tests/host/test_disk_cache.c
+ * @brief Host-runnable tests for the write-back sector cache.
+ *
+ * src/utils/disk_cache.c is pure logic over hal_disk_read/hal_disk_write;
+ * this file supplies those two as a RAM disk that counts backend calls, so
+ * the tests can assert on what the cache defers, merges and writes back.
+ * Default geometry: 16 sectors, 4 ways, so sector @c s maps to set @c s%4.
+ */
+
+#include "test_disk_cache.h"
+#include "utils/disk_cache.h"
+#include <string.h>
+
+#define SS DISK_CACHE_SECTOR_SIZE
+#define FAKE_SECTORS 64U
+
+static uint8_t fake_disk[FAKE_SECTORS][SS];
+static uint32_t fake_reads;
+static uint32_t fake_writes;
+static uint32_t fake_last_sector;
+static uint32_t fake_last_count;
+static uint8_t fake_fail;
+
+hal_disk_result_t hal_disk_read(uint8_t pdrv, uint8_t *buff, uint32_t sector,
+                                uint32_t count) {
+  (void)pdrv;
+  if (sector + count > FAKE_SECTORS)
+    return HAL_DISK_RES_PARERR;
+  memcpy(buff, fake_disk[sector], count * SS);
+  fake_reads++;
+  return HAL_DISK_RES_OK;
+}
+
+hal_disk_result_t hal_disk_write(uint8_t pdrv, const uint8_t *buff,
+                                 uint32_t sector, uint32_t count) {
+  (void)pdrv;
+  if (fake_fail)
+    return HAL_DISK_RES_ERROR;
+  if (sector + count > FAKE_SECTORS)
+    return HAL_DISK_RES_PARERR;
+  memcpy(fake_disk[sector], buff, count * SS);
+  fake_writes++;
+  fake_last_sector = sector;
+  fake_last_count = count;
+  return HAL_DISK_RES_OK;
+}
+
+static void fill(uint8_t *p, uint8_t seed) {
+  for (uint32_t i = 0; i < SS; i++)
+    p[i] = (uint8_t)(seed + i);
+}
+
+/** Empty cache, zeroed counters, disk sector n filled with seed n. */
+static void reset(void) {
+  disk_cache_invalidate(0);
+  disk_cache_reset_stats();
+  for (uint32_t s = 0; s < FAKE_SECTORS; s++)
+    fill(fake_disk[s], (uint8_t)s);
+  fake_reads = 0;
+  fake_writes = 0;
+  fake_last_sector = 0;
+  fake_last_count = 0;
+  fake_fail = 0;
+}
+
+static disk_cache_stats_t stats(void) {
+  disk_cache_stats_t st;
+  disk_cache_get_stats(&st);
+  return st;
+}
+
+void test_disk_cache_rejects_bad_args(void) {
+  reset();
+  uint8_t buf[SS];
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_DISK_RES_PARERR,
+                           (uint32_t)disk_cache_read(0, NULL, 0, 1));
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_DISK_RES_PARERR,
+                           (uint32_t)disk_cache_read(0, buf, 0, 0));
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_DISK_RES_PARERR,
+                           (uint32_t)disk_cache_write(0, NULL, 0, 1));
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_DISK_RES_PARERR,
+                           (uint32_t)disk_cache_write(0, buf, 0, 0));
+  TEST_ASSERT_EQUAL_UINT32(0u, fake_reads + fake_writes);
+}
+
+void test_disk_cache_read_miss_then_hit(void) {
+  reset();
+  uint8_t buf[SS];
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_DISK_RES_OK,
+                           (uint32_t)disk_cache_read(0, buf, 5, 1));
+  TEST_ASSERT_TRUE(memcmp(buf, fake_disk[5], SS) == 0);
+  memset(buf, 0, SS);
+  disk_cache_read(0, buf, 5, 1);
+  TEST_ASSERT_TRUE(memcmp(buf, fake_disk[5], SS) == 0);
+
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_reads);
+  TEST_ASSERT_EQUAL_UINT32(1u, stats().misses);
+  TEST_ASSERT_EQUAL_UINT32(1u, stats().hits);
+}
+
+void test_disk_cache_sync_merges_adjacent_writes(void) {
+  reset();
+  uint8_t buf[SS];
+  for (uint8_t s = 8; s <= 10; s++) {
+    fill(buf, (uint8_t)(0xA0 + s));
+    disk_cache_write(0, buf, s, 1);
+  }
+  /* Nothing reaches the disk until the sync... */
+  TEST_ASSERT_EQUAL_UINT32(0u, fake_writes);
+  TEST_ASSERT_EQUAL_UINT32(9u, fake_disk[9][0]);
+
+  /* ...which issues the three sectors as one multi-block write. */
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_DISK_RES_OK,
+                           (uint32_t)disk_cache_sync(0));
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_writes);
+  TEST_ASSERT_EQUAL_UINT32(3u, fake_last_count);
+  fill(buf, 0xA9);
+  TEST_ASSERT_TRUE(memcmp(buf, fake_disk[9], SS) == 0);
+  TEST_ASSERT_EQUAL_UINT32(3u, stats().writebacks);
+  TEST_ASSERT_EQUAL_UINT32(1u, stats().writeback_ops);
+
+  /* Lines are clean now: a second sync writes nothing. */
+  disk_cache_sync(0);
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_writes);
+}
+
+void test_disk_cache_eviction_writes_back_run(void) {
+  reset();
+  uint8_t buf[SS];
+  fill(buf, 0x55);
+  /* 0 and 1 share a way; 4, 8, 12 fill the rest of set 0. */
+  const uint32_t order[] = {0, 1, 4, 8, 12};
+  for (uint32_t i = 0; i < sizeof(order) / sizeof(order[0]); i++)
+    disk_cache_write(0, buf, order[i], 1);
+  TEST_ASSERT_EQUAL_UINT32(0u, fake_writes);
+
+  /* Set 0 is full: 16 evicts LRU sector 0, taking dirty neighbour 1 along. */
+  disk_cache_write(0, buf, 16, 1);
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_writes);
+  TEST_ASSERT_EQUAL_UINT32(2u, fake_last_count);
+  TEST_ASSERT_TRUE(memcmp(buf, fake_disk[0], SS) == 0);
+  TEST_ASSERT_TRUE(memcmp(buf, fake_disk[1], SS) == 0);
+  TEST_ASSERT_EQUAL_UINT32(1u, stats().evictions);
+
+  /* Sector 1 is still cached, now clean: reading it is a hit. */
+  disk_cache_read(0, buf, 1, 1);
+  TEST_ASSERT_EQUAL_UINT32(0u, fake_reads);
+}
+
+/* Sector 0 cached clean in way 0, then 1, 5, 9, 13 dirty in set 1, with
+ * sector 1 in way 0 right after it. */
+static void dirty_set1_after_clean_0(uint8_t *buf) {
+  disk_cache_read(0, buf, 0, 1);
+  fill(buf, 0x33);
+  const uint32_t order[] = {1, 5, 9, 13};
+  for (uint32_t i = 0; i < sizeof(order) / sizeof(order[0]); i++)
+    disk_cache_write(0, buf, order[i], 1);
+}
+
+void test_disk_cache_eviction_skips_empty_neighbour(void) {
+  reset();
+  uint8_t buf[SS];
+
+  /* 17 evicts LRU sector 1 alone: clean sector 0 before it in the same way
+   * is not part of its dirty run. */
+  dirty_set1_after_clean_0(buf);
+  disk_cache_write(0, buf, 17, 1);
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_writes);
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_last_sector);
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_last_count);
+  TEST_ASSERT_TRUE(memcmp(buf, fake_disk[1], SS) == 0);
+
+  /* Nor is a line that no longer holds valid data. */
+  reset();
+  dirty_set1_after_clean_0(buf);
+  disk_cache_discard(0, 0, 1);
+  disk_cache_write(0, buf, 17, 1);
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_writes);
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_last_sector);
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_last_count);
+
+  /* A sync writes the rest of set 1, one sector at a time, never sector 0. */
+  disk_cache_sync(0);
+  TEST_ASSERT_EQUAL_UINT32(5u, fake_writes);
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_last_count);
+  uint8_t want[SS];
+  fill(want, 0);
+  TEST_ASSERT_TRUE(memcmp(want, fake_disk[0], SS) == 0);
+}
+
+void test_disk_cache_multi_read_sees_dirty_lines(void) {
+  reset();
+  uint8_t one[SS];
+  uint8_t four[4 * SS];
+  fill(one, 0xC3);
+  disk_cache_write(0, one, 21, 1);
+
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_DISK_RES_OK,
+                           (uint32_t)disk_cache_read(0, four, 20, 4));
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_reads); /* one pass-through request */
+  TEST_ASSERT_TRUE(memcmp(four, fake_disk[20], SS) == 0);
+  TEST_ASSERT_TRUE(memcmp(four + SS, one, SS) == 0);
+  TEST_ASSERT_TRUE(memcmp(four + 2 * SS, fake_disk[22], 2 * SS) == 0);
+  TEST_ASSERT_EQUAL_UINT32(4u, stats().bypassed);
+}
+
+void test_disk_cache_multi_write_refreshes_lines(void) {
+  reset();
+  uint8_t one[SS];
+  uint8_t two[2 * SS];
+  disk_cache_read(0, one, 30, 1); /* clean copy */
+  fill(one, 0x11);
+  disk_cache_write(0, one, 31, 1); /* dirty copy */
+
+  fill(two, 0x77);
+  fill(two + SS, 0x88);
+  disk_cache_write(0, two, 30, 2);
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_writes);
+  TEST_ASSERT_EQUAL_UINT32(2u, fake_last_count);
+
+  /* Both cached copies now hold the new data and nothing is left dirty. */
+  disk_cache_read(0, one, 31, 1);
+  TEST_ASSERT_TRUE(memcmp(one, two + SS, SS) == 0);
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_reads);
+  disk_cache_sync(0);
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_writes);
+}
+
+void test_disk_cache_failed_sync_stays_dirty(void) {
+  reset();
+  uint8_t buf[SS];
+  fill(buf, 0xE0);
+  disk_cache_write(0, buf, 40, 1);
+
+  fake_fail = 1;
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_DISK_RES_ERROR,
+                           (uint32_t)disk_cache_sync(0));
+  fake_fail = 0;
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_DISK_RES_OK,
+                           (uint32_t)disk_cache_sync(0));
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_writes);
+  TEST_ASSERT_TRUE(memcmp(buf, fake_disk[40], SS) == 0);
+}
+
+void test_disk_cache_discard_drops_dirty_lines(void) {
+  reset();
+  uint8_t buf[SS];
+  fill(buf, 0x3C);
+  disk_cache_write(0, buf, 50, 1);
+  disk_cache_write(0, buf, 51, 1);
+
+  /* Trimmed sectors are neither written back nor served from RAM. */
+  disk_cache_discard(0, 50, 1);
+  disk_cache_sync(0);
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_writes);
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_last_count);
+  TEST_ASSERT_EQUAL_UINT32(50u, fake_disk[50][0]);
+  disk_cache_read(0, buf, 50, 1);
+  TEST_ASSERT_EQUAL_UINT32(1u, fake_reads);
+}
+
+/* PROGMEM slot for each case name on AVR; no-op elsewhere. */
+NAVTEST_CASE_DECL(test_disk_cache_rejects_bad_args);
+NAVTEST_CASE_DECL(test_disk_cache_read_miss_then_hit);
+NAVTEST_CASE_DECL(test_disk_cache_sync_merges_adjacent_writes);
+NAVTEST_CASE_DECL(test_disk_cache_eviction_writes_back_run);
+NAVTEST_CASE_DECL(test_disk_cache_eviction_skips_empty_neighbour);
+NAVTEST_CASE_DECL(test_disk_cache_multi_read_sees_dirty_lines);
+NAVTEST_CASE_DECL(test_disk_cache_multi_write_refreshes_lines);
+NAVTEST_CASE_DECL(test_disk_cache_failed_sync_stays_dirty);
+NAVTEST_CASE_DECL(test_disk_cache_discard_drops_dirty_lines);
+
+static const navtest_case_t disk_cache_cases[] = {
+    NAVTEST_CASE(test_disk_cache_rejects_bad_args),
+    NAVTEST_CASE(test_disk_cache_read_miss_then_hit),
+    NAVTEST_CASE(test_disk_cache_sync_merges_adjacent_writes),
+    NAVTEST_CASE(test_disk_cache_eviction_writes_back_run),
+    NAVTEST_CASE(test_disk_cache_eviction_skips_empty_neighbour),
+    NAVTEST_CASE(test_disk_cache_multi_read_sees_dirty_lines),
+    NAVTEST_CASE(test_disk_cache_multi_write_refreshes_lines),
+    NAVTEST_CASE(test_disk_cache_failed_sync_stays_dirty),
+    NAVTEST_CASE(test_disk_cache_discard_drops_dirty_lines),
+};
+
+const navtest_suite_t test_disk_cache_suite = {
+    .name = "DISK CACHE (host)",
+    .cases = disk_cache_cases,
+    .count = sizeof(disk_cache_cases) / sizeof(disk_cache_cases[0]),
+    .between = NULL,
+};
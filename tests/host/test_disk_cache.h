@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TEST_HOST_DISK_CACHE_H
+#define TEST_HOST_DISK_CACHE_H
+
+#include "navtest/navtest.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+void test_disk_cache_rejects_bad_args(void);
+void test_disk_cache_read_miss_then_hit(void);
+void test_disk_cache_sync_merges_adjacent_writes(void);
+void test_disk_cache_eviction_writes_back_run(void);
+void test_disk_cache_multi_read_sees_dirty_lines(void);
+void test_disk_cache_multi_write_refreshes_lines(void);
+void test_disk_cache_failed_sync_stays_dirty(void);
+void test_disk_cache_discard_drops_dirty_lines(void);
+
+extern const navtest_suite_t test_disk_cache_suite;
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif
@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file test_dma_driver.c
+ * @brief Deep host (SIL) tests for dma.c against the simulated DMA engine in
+ *        host_mmio.c. Buffers live in the simulated SRAM so the 32-bit stream
+ *        address registers can name them; each test arms a stream through the
+ *        real driver, steps the engine with host_dma_run() and asserts on the
+ *        copied memory, the stream registers and the ISR side effects.
+ */
+
+#include "host_mmio.h"
+#include "navhal_port_config.h"
+#include "navhal_port_dma.h"
+#include "navhal_port_interrupt.h"
+#include "family/dma_reg.h"
+#include "navtest/navtest.h"
+#include <stdint.h>
+#include <string.h>
+
+#define SRC ((uint8_t *)HOST_SRAM_BASE)
+#define DST ((uint8_t *)(HOST_SRAM_BASE + 0x1000))
+
+static void fill(uint8_t *p, uint32_t n, uint8_t seed) {
+  for (uint32_t i = 0; i < n; i++)
+    p[i] = (uint8_t)(seed + i);
+}
+
+static hal_dma_config_t m2m_cfg(uint16_t count) {
+  return (hal_dma_config_t){.controller = HAL_DMA_CONTROLLER_2,
+                            .stream = 0,
+                            .direction = HAL_DMA_DIR_M2M,
+                            .src_addr = (uint32_t)(uintptr_t)SRC,
+                            .dst_addr = (uint32_t)(uintptr_t)DST,
+                            .data_count = count,
+                            .src_inc = 1,
+                            .dst_inc = 1,
+                            .data_width = HAL_DMA_DATA_WIDTH_8,
+                            .fifo_mode = 1};
+}
+
+static volatile uint32_t s_irq_count;
+static void count_irq(void) { s_irq_count++; }
+
+void test_host_dma_m2m_copies_and_completes(void) {
+  host_mmio_reset();
+  fill(SRC, 64, 0x40);
+  hal_dma_config_t cfg = m2m_cfg(64);
+  hal_dma_init(&cfg);
+  hal_dma_start(&cfg);
+
+  TEST_ASSERT_EQUAL_UINT32(1u, host_dma_run());
+  TEST_ASSERT_TRUE(memcmp(SRC, DST, 64) == 0);
+  TEST_ASSERT_EQUAL_UINT32(0u, DMA2->STREAM[0].NDTR);
+  TEST_ASSERT_EQUAL_UINT32(0u, DMA2->STREAM[0].CR & DMA_SxCR_EN);
+  TEST_ASSERT_TRUE(hal_dma_transfer_complete(&cfg));
+  TEST_ASSERT_EQUAL_UINT32(64u, host_dma_stats().bytes);
+  /* Nothing enabled any more: a second step is a no-op. */
+  TEST_ASSERT_EQUAL_UINT32(0u, host_dma_run());
+}
+
+void test_host_dma_p2m_reads_fixed_register(void) {
+  host_mmio_reset();
+  /* SPI1->DR stands in for any fixed data register; only the memory side
+   * increments, so every item re-reads the same word. */
+  volatile uint32_t *reg = (volatile uint32_t *)0x4001300CUL;
+  *reg = 0x44332211u;
+  hal_dma_config_t cfg = {.controller = HAL_DMA_CONTROLLER_2,
+                          .stream = 2,
+                          .direction = HAL_DMA_DIR_P2M,
+                          .src_addr = (uint32_t)(uintptr_t)reg,
+                          .dst_addr = (uint32_t)(uintptr_t)DST,
+                          .data_count = 3,
+                          .src_inc = 0,
+                          .dst_inc = 1,
+                          .data_width = HAL_DMA_DATA_WIDTH_32};
+  hal_dma_init(&cfg);
+  hal_dma_start(&cfg);
+  host_dma_run();
+
+  const uint8_t expect[] = {0x11, 0x22, 0x33, 0x44, 0x11, 0x22,
+                            0x33, 0x44, 0x11, 0x22, 0x33, 0x44};
+  TEST_ASSERT_TRUE(memcmp(expect, DST, sizeof(expect)) == 0);
+  TEST_ASSERT_EQUAL_UINT32(0u, DST[sizeof(expect)]);
+}
+
+void test_host_dma_irq_only_when_nvic_enabled(void) {
+  host_mmio_reset();
+  s_irq_count = 0;
+  hal_interrupt_attach_callback(DMA2_Stream0_IRQn, count_irq);
+
+  hal_dma_config_t cfg = m2m_cfg(8);
+  hal_dma_init(&cfg);
+  hal_dma_start(&cfg);
+  host_dma_run();
+  TEST_ASSERT_EQUAL_UINT32(0u, s_irq_count); /* NVIC line still off */
+
+  hal_interrupt_enable(DMA2_Stream0_IRQn);
+  hal_dma_start(&cfg);
+  host_dma_run();
+  TEST_ASSERT_EQUAL_UINT32(1u, s_irq_count);
+  TEST_ASSERT_EQUAL_UINT32(1u, host_dma_stats().irqs);
+  /* The dma.c ISR cleared the stream's flags on the way out. */
+  TEST_ASSERT_FALSE(hal_dma_transfer_complete(&cfg));
+}
+
+void test_host_dma_restart_rearms_prepared_stream(void) {
+  host_mmio_reset();
+  fill(SRC, 32, 1);
+  hal_dma_config_t cfg = m2m_cfg(16);
+  hal_dma_handle_t h;
+  hal_dma_prepare(&cfg, &h);
+
+  /* M2M takes its destination from M0AR: re-arm twice into two halves. */
+  hal_dma_restart(&h, (uint32_t)(uintptr_t)DST, 16);
+  host_dma_run();
+  hal_dma_restart(&h, (uint32_t)(uintptr_t)(DST + 16), 16);
+  host_dma_run();
+
+  TEST_ASSERT_TRUE(memcmp(SRC, DST, 16) == 0);
+  TEST_ASSERT_TRUE(memcmp(SRC, DST + 16, 16) == 0);
+  TEST_ASSERT_EQUAL_UINT32(2u, host_dma_stats().transfers);
+}
+
+void test_host_dma_circular_reloads_ndtr(void) {
+  host_mmio_reset();
+  hal_dma_config_t cfg = m2m_cfg(4);
+  cfg.circular = 1;
+  hal_dma_init(&cfg);
+  hal_dma_start(&cfg);
+
+  TEST_ASSERT_EQUAL_UINT32(1u, host_dma_run()); /* one lap per call */
+  TEST_ASSERT_EQUAL_UINT32(1u, host_dma_run());
+  TEST_ASSERT_EQUAL_UINT32(4u, DMA2->STREAM[0].NDTR);
+  TEST_ASSERT_TRUE((DMA2->STREAM[0].CR & DMA_SxCR_EN) != 0);
+  hal_dma_stop(&cfg);
+  TEST_ASSERT_EQUAL_UINT32(0u, host_dma_run());
+}
+
+void test_host_dma_byte_memory_side_unaligned(void) {
+  host_mmio_reset();
+  volatile uint32_t *reg = (volatile uint32_t *)0x4001300CUL;
+  *reg = 0xDDCCBBAAu;
+  /* A 32-bit peripheral into an odd address: the FIFO packs the words and
+   * writes them back a byte at a time. */
+  hal_dma_config_t cfg = {.controller = HAL_DMA_CONTROLLER_2,
+                          .stream = 3,
+                          .direction = HAL_DMA_DIR_P2M,
+                          .src_addr = (uint32_t)(uintptr_t)reg,
+                          .dst_addr = (uint32_t)(uintptr_t)(DST + 1),
+                          .data_count = 2,
+                          .src_inc = 0,
+                          .dst_inc = 1,
+                          .data_width = HAL_DMA_DATA_WIDTH_32,
+                          .fifo_mode = 1,
+                          .mem_byte_access = 1};
+  hal_dma_init(&cfg);
+  TEST_ASSERT_EQUAL_UINT32(DMA_SxCR_MSIZE_8,
+                           DMA2->STREAM[3].CR & DMA_SxCR_MSIZE_MASK);
+  TEST_ASSERT_EQUAL_UINT32(DMA_SxCR_PSIZE_32,
+                           DMA2->STREAM[3].CR & DMA_SxCR_PSIZE_MASK);
+  hal_dma_start(&cfg);
+  host_dma_run();
+
+  /* NDTR still counts peripheral words: two of them, eight bytes. */
+  const uint8_t expect[] = {0x00, 0xAA, 0xBB, 0xCC, 0xDD,
+                            0xAA, 0xBB, 0xCC, 0xDD, 0x00};
+  TEST_ASSERT_TRUE(memcmp(expect, DST, sizeof(expect)) == 0);
+}
+
+static volatile hal_status_t s_chain_status;
+static volatile uint32_t s_chain_calls;
+static void chain_done(hal_status_t status, void *ctx) {
+  (void)ctx;
+  s_chain_status = status;
+  s_chain_calls++;
+}
+
+void test_host_dma_chain_runs_every_descriptor(void) {
+  host_mmio_reset();
+  fill(SRC, 48, 0x80);
+  s_chain_calls = 0;
+  hal_dma_config_t cfg = m2m_cfg(0);
+  hal_dma_chain_t chain;
+  hal_dma_chain_init(&chain, &cfg);
+
+  /* Gather three source pieces into one contiguous destination. */
+  const hal_dma_desc_t desc[] = {
+      {(uint32_t)(uintptr_t)(SRC + 32), (uint32_t)(uintptr_t)DST, 16, 0},
+      {(uint32_t)(uintptr_t)SRC, (uint32_t)(uintptr_t)(DST + 16), 16, 0},
+      {(uint32_t)(uintptr_t)(SRC + 16), (uint32_t)(uintptr_t)(DST + 32), 16, 0},
+  };
+  hal_dma_chain_start(&chain, desc, 3, chain_done, NULL);
+
+  TEST_ASSERT_EQUAL_UINT32(3u, host_dma_run());
+  TEST_ASSERT_EQUAL_UINT32(1u, s_chain_calls);
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_OK, (uint32_t)s_chain_status);
+  TEST_ASSERT_FALSE(hal_dma_chain_busy(&chain));
+  TEST_ASSERT_TRUE(memcmp(SRC + 32, DST, 16) == 0);
+  TEST_ASSERT_TRUE(memcmp(SRC, DST + 16, 32) == 0);
+}
+
+void test_host_dma_chain_reports_transfer_error(void) {
+  host_mmio_reset();
+  s_chain_calls = 0;
+  hal_dma_config_t cfg = m2m_cfg(0);
+  hal_dma_chain_t chain;
+  hal_dma_chain_init(&chain, &cfg);
+
+  const hal_dma_desc_t desc[] = {
+      {(uint32_t)(uintptr_t)SRC, (uint32_t)(uintptr_t)DST, 8, 0},
+      {(uint32_t)(uintptr_t)SRC, (uint32_t)(uintptr_t)(DST + 8), 8, 0},
+  };
+  hal_dma_chain_start(&chain, desc, 2, chain_done, NULL);
+  host_dma_fail_next(2, 0);
+  host_dma_run();
+
+  TEST_ASSERT_EQUAL_UINT32(1u, s_chain_calls);
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_ERR_IO, (uint32_t)s_chain_status);
+  TEST_ASSERT_FALSE(hal_dma_chain_busy(&chain));
+  TEST_ASSERT_EQUAL_UINT32(1u, host_dma_stats().transfers);
+}
+
+NAVTEST_CASE_DECL(test_host_dma_m2m_copies_and_completes);
+NAVTEST_CASE_DECL(test_host_dma_p2m_reads_fixed_register);
+NAVTEST_CASE_DECL(test_host_dma_irq_only_when_nvic_enabled);
+NAVTEST_CASE_DECL(test_host_dma_restart_rearms_prepared_stream);
+NAVTEST_CASE_DECL(test_host_dma_circular_reloads_ndtr);
+NAVTEST_CASE_DECL(test_host_dma_byte_memory_side_unaligned);
+NAVTEST_CASE_DECL(test_host_dma_chain_runs_every_descriptor);
+NAVTEST_CASE_DECL(test_host_dma_chain_reports_transfer_error);
+
+static const navtest_case_t dma_driver_cases[] = {
+    NAVTEST_CASE(test_host_dma_m2m_copies_and_completes),
+    NAVTEST_CASE(test_host_dma_p2m_reads_fixed_register),
+    NAVTEST_CASE(test_host_dma_irq_only_when_nvic_enabled),
+    NAVTEST_CASE(test_host_dma_restart_rearms_prepared_stream),
+    NAVTEST_CASE(test_host_dma_circular_reloads_ndtr),
+    NAVTEST_CASE(test_host_dma_byte_memory_side_unaligned),
+    NAVTEST_CASE(test_host_dma_chain_runs_every_descriptor),
+    NAVTEST_CASE(test_host_dma_chain_reports_transfer_error),
+};
+
+const navtest_suite_t test_dma_driver_suite = {
+    .name = "DMA DRIVER (host)",
+    .cases = dma_driver_cases,
+    .count = sizeof(dma_driver_cases) / sizeof(dma_driver_cases[0]),
+    .between = NULL,
+};
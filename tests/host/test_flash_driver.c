@@ -112,6 +112,23 @@ void test_host_flash_needs_compaction_false_when_room(void) {
   TEST_ASSERT_FALSE(hal_flash_needs_compaction());
 }
 
+void test_host_flash_program_erase_restore_art(void) {
+  host_mmio_reset();
+  FLASH_ACR = FLASH_ACR_PRFTEN | FLASH_ACR_ARTEN;
+  uint8_t v[] = {0x5A, 0xA5};
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)HAL_OK,
+                           (uint32_t)hal_flash_save(0x42, v, sizeof(v)));
+  /* ART back on, reset pulse released, prefetch untouched. */
+  TEST_ASSERT_EQUAL_UINT32(FLASH_ACR_PRFTEN | FLASH_ACR_ARTEN, FLASH_ACR);
+  hal_flash_erase();
+  TEST_ASSERT_EQUAL_UINT32(FLASH_ACR_PRFTEN | FLASH_ACR_ARTEN, FLASH_ACR);
+
+  /* A disabled ART stays disabled. */
+  FLASH_ACR = FLASH_ACR_PRFTEN;
+  hal_flash_save(0x42, v, sizeof(v));
+  TEST_ASSERT_EQUAL_UINT32(FLASH_ACR_PRFTEN, FLASH_ACR);
+}
+
 NAVTEST_CASE_DECL(test_host_flash_save_read_roundtrip);
 NAVTEST_CASE_DECL(test_host_flash_distinct_keys);
 NAVTEST_CASE_DECL(test_host_flash_update_returns_latest);
@@ -120,6 +137,7 @@ NAVTEST_CASE_DECL(test_host_flash_read_missing_key_fails);
 NAVTEST_CASE_DECL(test_host_flash_save_rejects_bad_args);
 NAVTEST_CASE_DECL(test_host_flash_read_rejects_null);
 NAVTEST_CASE_DECL(test_host_flash_needs_compaction_false_when_room);
+NAVTEST_CASE_DECL(test_host_flash_program_erase_restore_art);
 
 static const navtest_case_t flash_driver_cases[] = {
     NAVTEST_CASE(test_host_flash_save_read_roundtrip),
@@ -130,6 +148,7 @@ static const navtest_case_t flash_driver_cases[] = {
     NAVTEST_CASE(test_host_flash_save_rejects_bad_args),
     NAVTEST_CASE(test_host_flash_read_rejects_null),
     NAVTEST_CASE(test_host_flash_needs_compaction_false_when_room),
+    NAVTEST_CASE(test_host_flash_program_erase_restore_art),
 };
 
 const navtest_suite_t test_flash_driver_suite = {
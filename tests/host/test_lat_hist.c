@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file tests/host/test_lat_hist.c
+ * @brief Host-runnable tests for the log-scale latency histogram.
+ */
+
+#include "test_lat_hist.h"
+#include "utils/lat_hist.h"
+
+void test_lat_hist_bucket_edges(void) {
+  TEST_ASSERT_EQUAL_UINT32(0u, lat_hist_bucket(0));
+  TEST_ASSERT_EQUAL_UINT32(1u, lat_hist_bucket(1));
+  TEST_ASSERT_EQUAL_UINT32(2u, lat_hist_bucket(2));
+  TEST_ASSERT_EQUAL_UINT32(2u, lat_hist_bucket(3));
+  TEST_ASSERT_EQUAL_UINT32(11u, lat_hist_bucket(1024));
+  TEST_ASSERT_EQUAL_UINT32(11u, lat_hist_bucket(2047));
+  TEST_ASSERT_EQUAL_UINT32(12u, lat_hist_bucket(2048));
+  TEST_ASSERT_EQUAL_UINT32(32u, lat_hist_bucket(0x80000000u));
+  TEST_ASSERT_EQUAL_UINT32(32u, lat_hist_bucket(0xFFFFFFFFu));
+
+  TEST_ASSERT_EQUAL_UINT32(0u, lat_hist_bucket_max(0));
+  TEST_ASSERT_EQUAL_UINT32(1u, lat_hist_bucket_max(1));
+  TEST_ASSERT_EQUAL_UINT32(2047u, lat_hist_bucket_max(11));
+  TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFFu, lat_hist_bucket_max(32));
+  /* Every bucket's upper edge maps back into that bucket. */
+  for (uint8_t b = 0; b < LAT_HIST_BUCKETS; b++)
+    TEST_ASSERT_EQUAL_UINT32(b, lat_hist_bucket(lat_hist_bucket_max(b)));
+}
+
+void test_lat_hist_add_tracks_count_min_max_sum(void) {
+  lat_hist_t h;
+  lat_hist_reset(&h);
+  lat_hist_add(&h, 500);
+  lat_hist_add(&h, 20);
+  lat_hist_add(&h, 0xFFFFFFFFu);
+
+  TEST_ASSERT_EQUAL_UINT32(3u, h.count);
+  TEST_ASSERT_EQUAL_UINT32(20u, h.min);
+  TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFFu, h.max);
+  /* The sum must not wrap at 32 bits. */
+  TEST_ASSERT_TRUE(h.sum == 520ull + 0xFFFFFFFFull);
+  TEST_ASSERT_EQUAL_UINT32(1u, h.bucket[lat_hist_bucket(20)]);
+  TEST_ASSERT_EQUAL_UINT32(1u, h.bucket[lat_hist_bucket(500)]);
+  TEST_ASSERT_EQUAL_UINT32(1u, h.bucket[32]);
+}
+
+void test_lat_hist_percentile_resolves_to_bucket_edge(void) {
+  lat_hist_t h;
+  lat_hist_reset(&h);
+  for (uint32_t v = 100; v < 200; v++) /* buckets 7 [64,128) and 8 */
+    lat_hist_add(&h, v);
+
+  TEST_ASSERT_EQUAL_UINT32(100u, lat_hist_percentile(&h, 0));
+  /* 28 samples (100..127) in bucket 7: p25 is its edge, 127. */
+  TEST_ASSERT_EQUAL_UINT32(127u, lat_hist_percentile(&h, 250));
+  /* p50 is in bucket 8, whose edge 255 is clamped to the maximum. */
+  TEST_ASSERT_EQUAL_UINT32(199u, lat_hist_percentile(&h, 500));
+  TEST_ASSERT_EQUAL_UINT32(199u, lat_hist_percentile(&h, 1000));
+  TEST_ASSERT_EQUAL_UINT32(199u, lat_hist_percentile(&h, 2000));
+}
+
+void test_lat_hist_percentile_isolates_outlier(void) {
+  /* 999 fast block writes and one GC pause: up to p99.9 the percentiles
+   * stay in the fast bucket (reported as its edge), only p100 sees the
+   * stall. */
+  lat_hist_t h;
+  lat_hist_reset(&h);
+  for (int i = 0; i < 999; i++)
+    lat_hist_add(&h, 3000);
+  lat_hist_add(&h, 20000000);
+
+  TEST_ASSERT_EQUAL_UINT32(4095u, lat_hist_percentile(&h, 500));
+  TEST_ASSERT_EQUAL_UINT32(4095u, lat_hist_percentile(&h, 990));
+  TEST_ASSERT_EQUAL_UINT32(4095u, lat_hist_percentile(&h, 999));
+  TEST_ASSERT_EQUAL_UINT32(20000000u, lat_hist_percentile(&h, 1000));
+  TEST_ASSERT_EQUAL_UINT32(1u, h.bucket[lat_hist_bucket(20000000)]);
+}
+
+void test_lat_hist_empty_and_merge(void) {
+  lat_hist_t a, b;
+  lat_hist_reset(&a);
+  lat_hist_reset(&b);
+  TEST_ASSERT_EQUAL_UINT32(0u, lat_hist_percentile(&a, 500));
+
+  lat_hist_add(&b, 7);
+  lat_hist_add(&b, 9000);
+  lat_hist_merge(&a, &b); /* into an empty histogram */
+  TEST_ASSERT_EQUAL_UINT32(2u, a.count);
+  TEST_ASSERT_EQUAL_UINT32(7u, a.min);
+  TEST_ASSERT_EQUAL_UINT32(9000u, a.max);
+
+  lat_hist_reset(&b);
+  lat_hist_add(&b, 3);
+  lat_hist_merge(&a, &b);
+  TEST_ASSERT_EQUAL_UINT32(3u, a.count);
+  TEST_ASSERT_EQUAL_UINT32(3u, a.min);
+  TEST_ASSERT_TRUE(a.sum == 9010ull);
+  TEST_ASSERT_EQUAL_UINT32(1u, a.bucket[lat_hist_bucket(3)]);
+}
+
+/* PROGMEM slot for each case name on AVR; no-op elsewhere. */
+NAVTEST_CASE_DECL(test_lat_hist_bucket_edges);
+NAVTEST_CASE_DECL(test_lat_hist_add_tracks_count_min_max_sum);
+NAVTEST_CASE_DECL(test_lat_hist_percentile_resolves_to_bucket_edge);
+NAVTEST_CASE_DECL(test_lat_hist_percentile_isolates_outlier);
+NAVTEST_CASE_DECL(test_lat_hist_empty_and_merge);
+
+
+static const navtest_case_t lat_hist_cases[] = {
+    NAVTEST_CASE(test_lat_hist_bucket_edges),
+    NAVTEST_CASE(test_lat_hist_add_tracks_count_min_max_sum),
+    NAVTEST_CASE(test_lat_hist_percentile_resolves_to_bucket_edge),
+    NAVTEST_CASE(test_lat_hist_percentile_isolates_outlier),
+    NAVTEST_CASE(test_lat_hist_empty_and_merge),
+};
+
+const navtest_suite_t test_lat_hist_suite = {
+    .name = "LATENCY HISTOGRAM (host)",
+    .cases = lat_hist_cases,
+    .count = sizeof(lat_hist_cases) / sizeof(lat_hist_cases[0]),
+    .between = NULL,
+};
@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TEST_HOST_LAT_HIST_H
+#define TEST_HOST_LAT_HIST_H
+
+#include "navtest/navtest.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+void test_lat_hist_bucket_edges(void);
+void test_lat_hist_add_tracks_count_min_max_sum(void);
+void test_lat_hist_percentile_resolves_to_bucket_edge(void);
+void test_lat_hist_percentile_isolates_outlier(void);
+void test_lat_hist_empty_and_merge(void);
+
+extern const navtest_suite_t test_lat_hist_suite;
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif
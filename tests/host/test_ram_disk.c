@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file test_ram_disk.c
+ * @brief Host (SIL) tests for the RAM disk (ram_disk.c) as FatFs drive 1,
+ *        next to the SPI-mode card model on drive 0.
+ */
+
+#include "host_mmio.h"
+#include "host_sd_spi.h"
+#include "utils/ram_disk.h"
+#include "utils/v_fs.h"
+#include "diskio.h"
+#include "ff.h"
+#include "navtest/navtest.h"
+#include <stdint.h>
+#include <string.h>
+
+#define RAM_SECTORS 256U /* 128 KiB */
+
+static uint32_t s_ram[RAM_SECTORS * 128U];
+
+void test_ram_disk_block_io(void) {
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_PARERR, ram_disk_attach(NULL, 8));
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK, ram_disk_attach(s_ram, 8));
+  TEST_ASSERT_EQUAL_UINT32(STA_NOINIT, disk_status(RAM_DISK_PDRV));
+  TEST_ASSERT_EQUAL_UINT32(0u, disk_initialize(RAM_DISK_PDRV));
+  ram_disk_reset_stats();
+
+  static uint8_t out[2 * 512], in[2 * 512];
+  for (uint32_t i = 0; i < sizeof(out); i++)
+    out[i] = (uint8_t)(i * 5U + 3U);
+  TEST_ASSERT_EQUAL_UINT32(RES_OK, disk_write(RAM_DISK_PDRV, out, 6, 2));
+  TEST_ASSERT_TRUE(memcmp((uint8_t *)s_ram + 6 * 512, out, sizeof(out)) == 0);
+  TEST_ASSERT_EQUAL_UINT32(RES_OK, disk_read(RAM_DISK_PDRV, in, 6, 2));
+  TEST_ASSERT_TRUE(memcmp(in, out, sizeof(in)) == 0);
+
+  /* Nothing past the end, not even partly. */
+  TEST_ASSERT_EQUAL_UINT32(RES_PARERR, disk_read(RAM_DISK_PDRV, in, 7, 2));
+  TEST_ASSERT_EQUAL_UINT32(RES_PARERR, disk_write(RAM_DISK_PDRV, out, 8, 1));
+
+  LBA_t count = 0;
+  TEST_ASSERT_EQUAL_UINT32(
+      RES_OK, disk_ioctl(RAM_DISK_PDRV, GET_SECTOR_COUNT, &count));
+  TEST_ASSERT_EQUAL_UINT32(8u, (uint32_t)count);
+
+  ram_disk_stats_t st;
+  ram_disk_get_stats(&st);
+  TEST_ASSERT_EQUAL_UINT32(1u, st.read_ops);
+  TEST_ASSERT_EQUAL_UINT32(1u, st.write_ops);
+  TEST_ASSERT_EQUAL_UINT32(2u, st.sectors_read);
+  TEST_ASSERT_EQUAL_UINT32(2u, st.sectors_written);
+}
+
+void test_ram_disk_volume_beside_card(void) {
+  static uint8_t work[FF_MAX_SS];
+  host_mmio_reset();
+  const host_sd_spi_config_t cfg = {.sectors = 8192, .busy_bytes = 1};
+  TEST_ASSERT_TRUE(host_sd_spi_attach(&cfg));
+  const MKFS_PARM opt = {.fmt = FM_FAT, .align = 1};
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_mkfs("0:", &opt, work, sizeof(work)));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_fs_init());
+
+  /* Blank RAM: formatted on mount. */
+  memset(s_ram, 0, sizeof(s_ram));
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK,
+                           ram_disk_attach(s_ram, RAM_SECTORS));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_fs_mount_ram());
+
+  /* The same name on both drives; the scratch one never touches the card. */
+  host_sd_spi_reset_stats();
+  v_fd_t fd = v_open("1:DATA.TXT", V_O_CREAT | V_O_WRONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(7u, (uint32_t)v_write(fd, "scratch", 7));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+  TEST_ASSERT_EQUAL_UINT32(0u, host_sd_spi_stats().commands);
+
+  fd = v_open("0:DATA.TXT", V_O_CREAT | V_O_WRONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(4u, (uint32_t)v_write(fd, "card", 4));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+
+  char got[16] = {0};
+  fd = v_open("1:DATA.TXT", V_O_RDONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(7u, (uint32_t)v_read(fd, got, sizeof(got)));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+  TEST_ASSERT_TRUE(memcmp(got, "scratch", 7) == 0);
+  fd = v_open("0:DATA.TXT", V_O_RDONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(4u, (uint32_t)v_read(fd, got, sizeof(got)));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+  TEST_ASSERT_TRUE(memcmp(got, "card", 4) == 0);
+
+  /* Mounting again keeps the files. */
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_fs_mount_ram());
+  FILINFO fno;
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_stat("1:DATA.TXT", &fno));
+  TEST_ASSERT_EQUAL_UINT32(7u, (uint32_t)fno.fsize);
+}
+
+void test_ram_disk_attach_remounts(void) {
+  memset(s_ram, 0, sizeof(s_ram));
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK,
+                           ram_disk_attach(s_ram, RAM_SECTORS));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_fs_mount_ram());
+  v_fd_t fd = v_open("1:KEEP.BIN", V_O_CREAT | V_O_WRONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+
+  /* Other memory: the mounted volume is dropped, not served from stale
+   * state, and the blank region is formatted on the next mount. */
+  static uint32_t other[RAM_SECTORS * 128U];
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK,
+                           ram_disk_attach(other, RAM_SECTORS));
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)-FR_NO_FILESYSTEM,
+                           (uint32_t)v_open("1:KEEP.BIN", V_O_RDONLY));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_fs_mount_ram());
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)-FR_NO_FILE,
+                           (uint32_t)v_open("1:KEEP.BIN", V_O_RDONLY));
+}
+
+void test_ram_disk_dcache_reused_entry(void) {
+  memset(s_ram, 0, sizeof(s_ram));
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK,
+                           ram_disk_attach(s_ram, RAM_SECTORS));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_fs_mount_ram());
+
+  v_fd_t fd = v_open("1:/Sensor_A_2026.csv", V_O_CREAT | V_O_WRONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(1u, (uint32_t)v_write(fd, "A", 1));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+  fd = v_open("1:/Sensor_A_2026.csv", V_O_RDONLY); /* Now cached */
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+
+  /* Deleted under another spelling; B takes over the free slot with the
+   * same short name, SENSOR~1.CSV. A must not open as B. */
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_unlink("1:sensor_a_2026.CSV"));
+  fd = v_open("1:/Sensor_B_2026.csv", V_O_CREAT | V_O_WRONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(1u, (uint32_t)v_write(fd, "B", 1));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)-FR_NO_FILE,
+                           (uint32_t)v_open("1:/Sensor_A_2026.csv",
+                                            V_O_RDONLY));
+
+  /* Spellings of one path share an entry: B opens through any of them. */
+  char got = 0;
+  fd = v_open("1:SENSOR_B_2026.CSV", V_O_RDONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+  fd = v_open("1://sensor_b_2026.csv", V_O_RDONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(1u, (uint32_t)v_read(fd, &got, 1));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)'B', (uint32_t)got);
+}
+
+NAVTEST_CASE_DECL(test_ram_disk_block_io);
+NAVTEST_CASE_DECL(test_ram_disk_volume_beside_card);
+NAVTEST_CASE_DECL(test_ram_disk_attach_remounts);
+NAVTEST_CASE_DECL(test_ram_disk_dcache_reused_entry);
+
+static const navtest_case_t ram_disk_cases[] = {
+    NAVTEST_CASE(test_ram_disk_block_io),
+    NAVTEST_CASE(test_ram_disk_volume_beside_card),
+    NAVTEST_CASE(test_ram_disk_attach_remounts),
+    NAVTEST_CASE(test_ram_disk_dcache_reused_entry),
+};
+
+const navtest_suite_t test_ram_disk_suite = {
+    .name = "RAM DISK (host)",
+    .cases = ram_disk_cases,
+    .count = sizeof(ram_disk_cases) / sizeof(ram_disk_cases[0]),
+    .between = NULL,
+};
@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file test_sd_bench.c
+ * @brief Host (SIL) run of the SD benchmark sweep (samples/cortex-m/
+ *        29_hal_sd_bench/sd_bench.c) against the SD card model in host_sd.c.
+ *
+ * Latencies are host time, so nothing here asserts on their values — only
+ * that every operation is accounted for in its histogram, that the data
+ * really reached the card, and that the JSON lines a host script consumes
+ * are complete. Like the SDIO driver suite the cases share one card.
+ */
+
+#include "host_mmio.h"
+#include "host_sd.h"
+#include "sd_bench.h"
+#include "common/hal_diskio.h"
+#include "common/hal_sdio.h"
+#include "family/rcc_reg.h"
+#include "ff.h"
+#include "navtest/navtest.h"
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#define CARD_SECTORS 16384U /* 8 MiB */
+#define SCRATCH_LBA 8192U
+#define SCRATCH_SECTORS 8192U
+
+static int s_inserted;
+static uint8_t s_buf[16384 + 4] __attribute__((aligned(4)));
+
+/* What the sweep reported, for the assertions. */
+static char s_out[64 * 1024];
+static size_t s_out_len;
+static uint32_t s_points, s_bad_points;
+
+static void capture(const char *s) {
+  size_t n = strlen(s);
+  if (s_out_len + n < sizeof(s_out)) {
+    memcpy(s_out + s_out_len, s, n);
+    s_out_len += n;
+    s_out[s_out_len] = '\0';
+  }
+}
+
+/* Every point must account for each completed operation exactly once. */
+static void check_point(const sd_bench_point_t *p) {
+  uint32_t in_buckets = 0;
+  for (uint8_t b = 0; b < LAT_HIST_BUCKETS; b++)
+    in_buckets += p->hist.bucket[b];
+  s_points++;
+  if (in_buckets != p->hist.count ||
+      p->bytes != (uint64_t)p->hist.count * p->size ||
+      (p->err == 0 && p->hist.count != p->count))
+    s_bad_points++;
+}
+
+static uint32_t host_clock(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+
+static sd_bench_config_t base_config(void) {
+  s_out_len = 0;
+  s_out[0] = '\0';
+  s_points = 0;
+  s_bad_points = 0;
+  return (sd_bench_config_t){.puts = capture,
+                             .on_point = check_point,
+                             .clock = host_clock,
+                             .clock_hz = 1000000000U,
+                             .bus_hz = hal_sdio_get_bus_clock(),
+                             .buf = s_buf,
+                             .buf_len = sizeof(s_buf),
+                             .lba = SCRATCH_LBA,
+                             .sectors = SCRATCH_SECTORS,
+                             .path = "0:BENCH.BIN"};
+}
+
+static uint32_t count_lines(const char *prefix) {
+  uint32_t n = 0;
+  size_t len = strlen(prefix);
+  for (const char *p = s_out; p != NULL && *p != '\0';) {
+    if (strncmp(p, prefix, len) == 0)
+      n++;
+    p = strstr(p, "\r\n");
+    if (p != NULL)
+      p += 2;
+  }
+  return n;
+}
+
+#define REQUIRE_CARD()                                                         \
+  do {                                                                         \
+    if (!s_inserted)                                                           \
+      return;                                                                  \
+  } while (0)
+
+void test_sd_bench_raw_layers_sweep(void) {
+  host_mmio_reset();
+  const host_sd_config_t card = {.sectors = CARD_SECTORS,
+                                 .au_size = 3,
+                                 .init_polls = 1,
+                                 .busy_polls = 2};
+  s_inserted = host_sd_attach(&card);
+  if (!s_inserted) {
+    navtest_write("  (register trapping unavailable: SD suite skipped)\n");
+    return;
+  }
+  RCC->PLLCFGR = 8U | (192U << 6) | (8U << 24);
+  RCC->CFGR = 0x2U << 2;
+  const hal_sdio_config_t sd = {.bus_width = 1};
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, hal_sdio_init(&sd));
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, hal_sdio_card_init());
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_STATUS_OK, hal_disk_initialize(0));
+
+  static const uint32_t sizes[] = {512, 4096};
+  static const uint16_t counts[] = {1, 8};
+  static const uint8_t aligns[] = {0, 1};
+  sd_bench_config_t cfg = base_config();
+  cfg.sizes = sizes;
+  cfg.n_sizes = 2;
+  cfg.counts = counts;
+  cfg.n_counts = 2;
+  cfg.aligns = aligns;
+  cfg.n_aligns = 2;
+  cfg.layers = SD_BENCH_SDIO | SD_BENCH_DISK;
+
+  host_sd_reset_stats();
+  TEST_ASSERT_EQUAL_UINT32(0u, sd_bench_run(&cfg));
+  /* 2 layers x 2 sizes x 2 counts x 2 alignments x write + read. */
+  TEST_ASSERT_EQUAL_UINT32(32u, s_points);
+  TEST_ASSERT_EQUAL_UINT32(0u, s_bad_points);
+
+  /* Each write run went to the card: (1 + 8) ops x (1 + 8) sectors x 2
+   * alignments x 2 layers. */
+  TEST_ASSERT_EQUAL_UINT32(2u * 2u * 9u * 9u, host_sd_stats().blocks_written);
+  /* The last run stamped op 7 of the 4 KiB, misaligned disk-layer run. */
+  const uint8_t *s = host_sd_image() + (size_t)(SCRATCH_LBA + 7 * 8) * 512U;
+  TEST_ASSERT_EQUAL_UINT32(7u, s[0]);
+  TEST_ASSERT_EQUAL_UINT32(0u, s[1]);
+}
+
+void test_sd_bench_fatfs_sweep(void) {
+  REQUIRE_CARD();
+  static FATFS fs;
+  static uint8_t work[FF_MAX_SS];
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_mkfs("0:", NULL, work, sizeof(work)));
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_mount(&fs, "0:", 1));
+
+  static const uint32_t sizes[] = {512, 16384};
+  static const uint16_t counts[] = {6};
+  static const uint8_t aligns[] = {0, 3};
+  sd_bench_config_t cfg = base_config();
+  cfg.sizes = sizes;
+  cfg.n_sizes = 2;
+  cfg.counts = counts;
+  cfg.n_counts = 1;
+  cfg.aligns = aligns;
+  cfg.n_aligns = 2;
+  cfg.layers = SD_BENCH_FATFS;
+
+  TEST_ASSERT_EQUAL_UINT32(0u, sd_bench_run(&cfg));
+  TEST_ASSERT_EQUAL_UINT32(8u, s_points);
+  TEST_ASSERT_EQUAL_UINT32(0u, s_bad_points);
+
+  /* The file left behind is the last, misaligned 16 KiB run. */
+  FILINFO fno;
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_stat("0:BENCH.BIN", &fno));
+  TEST_ASSERT_EQUAL_UINT32(3u + 6u * 16384u, (uint32_t)fno.fsize);
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_mount(NULL, "0:", 0));
+}
+
+void test_sd_bench_json_lines(void) {
+  REQUIRE_CARD();
+  static const uint32_t sizes[] = {1024};
+  static const uint16_t counts[] = {4};
+  static const uint8_t aligns[] = {0};
+  sd_bench_config_t cfg = base_config();
+  cfg.sizes = sizes;
+  cfg.n_sizes = 1;
+  cfg.counts = counts;
+  cfg.n_counts = 1;
+  cfg.aligns = aligns;
+  cfg.n_aligns = 1;
+  cfg.layers = SD_BENCH_SDIO;
+  TEST_ASSERT_EQUAL_UINT32(0u, sd_bench_run(&cfg));
+
+  TEST_ASSERT_TRUE(strncmp(s_out, "{\"type\":\"meta\",\"version\":1,", 27) == 0);
+  TEST_ASSERT_EQUAL_UINT32(2u, count_lines("{\"type\":\"point\","));
+  TEST_ASSERT_TRUE(strstr(s_out, "\"layer\":\"sdio\",\"op\":\"write\","
+                                 "\"size\":1024,\"count\":4,\"align\":0,"
+                                 "\"err\":0,\"n\":4,\"bytes\":4096,") != NULL);
+  TEST_ASSERT_TRUE(strstr(s_out, "\"hist\":{\"") != NULL);
+  const char *done = "{\"type\":\"done\",\"points\":2,\"failed\":0}\r\n";
+  TEST_ASSERT_TRUE(s_out_len >= strlen(done));
+  TEST_ASSERT_TRUE(strcmp(s_out + s_out_len - strlen(done), done) == 0);
+}
+
+void test_sd_bench_errors_are_reported_per_point(void) {
+  REQUIRE_CARD();
+  static const uint32_t sizes[] = {100, 4096};
+  static const uint16_t counts[] = {4, 4096};
+  static const uint8_t aligns[] = {0};
+  sd_bench_config_t cfg = base_config();
+  cfg.sizes = sizes;
+  cfg.n_sizes = 2;
+  cfg.counts = counts;
+  cfg.n_counts = 2;
+  cfg.aligns = aligns;
+  cfg.n_aligns = 1;
+  cfg.layers = SD_BENCH_SDIO;
+
+  /* 100-byte operations and 4096 x 8 sectors do not fit the scratch area:
+   * those runs fail up front. The 4 KiB x 4 write meets a command timeout
+   * on its first CMD25, so its read-back finds stale data. */
+  host_sd_fail_next(SD_CMD_WRITE_MULT_BLOCK, HOST_SD_FAULT_CMD_TIMEOUT);
+  TEST_ASSERT_EQUAL_UINT32(8u, sd_bench_run(&cfg));
+  TEST_ASSERT_EQUAL_UINT32(8u, s_points);
+  TEST_ASSERT_EQUAL_UINT32(0u, s_bad_points);
+  TEST_ASSERT_EQUAL_UINT32(8u, count_lines("{\"type\":\"point\","));
+  TEST_ASSERT_TRUE(strstr(s_out, "\"size\":100,\"count\":4,\"align\":0,"
+                                 "\"err\":-2,\"n\":0,") != NULL);
+  TEST_ASSERT_TRUE(strstr(s_out, "\"op\":\"write\",\"size\":4096,"
+                                 "\"count\":4,\"align\":0,\"err\":1,"
+                                 "\"n\":0,") != NULL);
+  TEST_ASSERT_TRUE(strstr(s_out, "\"op\":\"read\",\"size\":4096,"
+                                 "\"count\":4,\"align\":0,\"err\":-1,"
+                                 "\"n\":1,") != NULL);
+}
+
+void test_sd_bench_remove_card(void) {
+  REQUIRE_CARD();
+  host_sd_detach();
+  s_inserted = 0;
+}
+
+NAVTEST_CASE_DECL(test_sd_bench_raw_layers_sweep);
+NAVTEST_CASE_DECL(test_sd_bench_fatfs_sweep);
+NAVTEST_CASE_DECL(test_sd_bench_json_lines);
+NAVTEST_CASE_DECL(test_sd_bench_errors_are_reported_per_point);
+NAVTEST_CASE_DECL(test_sd_bench_remove_card);
+
+static const navtest_case_t sd_bench_cases[] = {
+    NAVTEST_CASE(test_sd_bench_raw_layers_sweep),
+    NAVTEST_CASE(test_sd_bench_fatfs_sweep),
+    NAVTEST_CASE(test_sd_bench_json_lines),
+    NAVTEST_CASE(test_sd_bench_errors_are_reported_per_point),
+    NAVTEST_CASE(test_sd_bench_remove_card),
+};
+
+const navtest_suite_t test_sd_bench_suite = {
+    .name = "SD BENCHMARK (host)",
+    .cases = sd_bench_cases,
+    .count = sizeof(sd_bench_cases) / sizeof(sd_bench_cases[0]),
+    .between = NULL,
+};
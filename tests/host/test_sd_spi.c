@@ -0,0 +1,297 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file test_sd_spi.c
+ * @brief Host (SIL) tests for the SD-over-SPI block device (sd_spi.c) and
+ *        FatFs on top, against the SPI-mode card model in host_sd_spi.c.
+ *
+ * sd_spi.c is built with SD_SPI_CRC=1, so the card runs with CRC checking
+ * on. Each case inserts its own card and re-runs hal_disk_initialize.
+ */
+
+#include "host_mmio.h"
+#include "host_sd_spi.h"
+#include "board.h"
+#include "common/hal_diskio.h"
+#include "utils/sd_spi.h"
+#include "ff.h"
+#include "navtest/navtest.h"
+#include <stdint.h>
+#include <string.h>
+
+#define SDHC_SECTORS 8192U /* 4 MiB */
+
+static void fill(uint8_t *p, uint32_t n, uint8_t seed) {
+  for (uint32_t i = 0; i < n; i++)
+    p[i] = (uint8_t)(seed + i * 7U);
+}
+
+static const uint8_t *card_sector(uint32_t sector) {
+  return host_sd_spi_image() + (size_t)sector * 512U;
+}
+
+/** Fresh card of the given kind, initialised through hal_disk. */
+static void insert(uint32_t sectors, uint8_t sdsc, uint8_t v1) {
+  host_mmio_reset();
+  const host_sd_spi_config_t cfg = {.sectors = sectors,
+                                    .sdsc = sdsc,
+                                    .v1 = v1,
+                                    .au_size = 7, /* 1 MiB */
+                                    .init_polls = 3,
+                                    .busy_bytes = 4};
+  TEST_ASSERT_TRUE(host_sd_spi_attach(&cfg));
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_STATUS_OK, hal_disk_initialize(0));
+  host_sd_spi_reset_stats();
+}
+
+void test_host_sd_spi_init_sdhc(void) {
+  insert(SDHC_SECTORS, 0, 0);
+
+  sd_spi_info_t info;
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK, sd_spi_get_info(&info));
+  TEST_ASSERT_EQUAL_UINT32(SD_SPI_CARD_SDHC, info.type);
+  TEST_ASSERT_EQUAL_UINT32(SDHC_SECTORS, info.sectors);
+  TEST_ASSERT_EQUAL_UINT32(1u, info.crc);
+  TEST_ASSERT_EQUAL_UINT32(1u, host_sd_spi_stats().crc_on);
+
+  hal_disk_lba_t count = 0;
+  TEST_ASSERT_EQUAL_UINT32(
+      HAL_DISK_RES_OK,
+      hal_disk_ioctl(0, HAL_DISK_IO_GET_SECTOR_COUNT, &count));
+  TEST_ASSERT_EQUAL_UINT32(SDHC_SECTORS, (uint32_t)count);
+  uint32_t au = 0;
+  TEST_ASSERT_EQUAL_UINT32(
+      HAL_DISK_RES_OK, hal_disk_ioctl(0, HAL_DISK_IO_GET_BLOCK_SIZE, &au));
+  TEST_ASSERT_EQUAL_UINT32(2048u, au); /* AU_SIZE 7: 1 MiB */
+}
+
+void test_host_sd_spi_sdxc_au_sizes(void) {
+  /* AU_SIZE 0xA..0xF: 8, 12, 16, 24, 32 and 64 MB, not a shift of 16 KB. */
+  static const uint32_t want[6] = {16384, 24576, 32768, 49152, 65536, 131072};
+  for (uint8_t code = 0xA; code <= 0xF; code++) {
+    host_mmio_reset();
+    const host_sd_spi_config_t cfg = {.sectors = SDHC_SECTORS,
+                                      .au_size = code};
+    TEST_ASSERT_TRUE(host_sd_spi_attach(&cfg));
+    TEST_ASSERT_EQUAL_UINT32(HAL_DISK_STATUS_OK, hal_disk_initialize(0));
+    sd_spi_info_t info;
+    TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK, sd_spi_get_info(&info));
+    TEST_ASSERT_EQUAL_UINT32(want[code - 0xA], info.erase_unit);
+  }
+  /* FatFs is told at most 32768 sectors, what f_mkfs takes: 16 MiB. */
+  uint32_t au = 0;
+  TEST_ASSERT_EQUAL_UINT32(
+      HAL_DISK_RES_OK, hal_disk_ioctl(0, HAL_DISK_IO_GET_BLOCK_SIZE, &au));
+  TEST_ASSERT_EQUAL_UINT32(32768u, au);
+}
+
+void test_host_sd_spi_clock_switches_after_init(void) {
+  host_mmio_reset();
+  const host_sd_spi_config_t cfg = {.sectors = SDHC_SECTORS};
+  TEST_ASSERT_TRUE(host_sd_spi_attach(&cfg));
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_STATUS_OK, hal_disk_initialize(0));
+  static uint8_t buf[512];
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK, hal_disk_read(0, buf, 0, 1));
+
+  host_sd_spi_stats_t st = host_sd_spi_stats();
+  TEST_ASSERT_EQUAL_UINT32(HAL_SPI_BAUDRATE_DIV256, st.cmd0_baudrate);
+  TEST_ASSERT_EQUAL_UINT32(BOARD_SD_SPI_FAST_BAUDRATE, st.data_baudrate);
+}
+
+void test_host_sd_spi_single_block_roundtrip(void) {
+  insert(SDHC_SECTORS, 0, 0);
+  static uint8_t out[512], in[512];
+  fill(out, sizeof(out), 0x11);
+
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK, hal_disk_write(0, out, 5, 1));
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK, hal_disk_ioctl(0, HAL_DISK_IO_SYNC, NULL));
+  TEST_ASSERT_TRUE(memcmp(out, card_sector(5), sizeof(out)) == 0);
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK, hal_disk_read(0, in, 5, 1));
+  TEST_ASSERT_TRUE(memcmp(out, in, sizeof(out)) == 0);
+  /* The write's programming time was waited out, not skipped. */
+  TEST_ASSERT_EQUAL_UINT32(4u, host_sd_spi_stats().busy_bytes);
+}
+
+void test_host_sd_spi_multi_block_is_one_command(void) {
+  insert(SDHC_SECTORS, 0, 0);
+  static uint8_t out[8 * 512], in[8 * 512];
+  fill(out, sizeof(out), 0x22);
+
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK, hal_disk_write(0, out, 100, 8));
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK, hal_disk_read(0, in, 100, 8));
+  TEST_ASSERT_TRUE(memcmp(out, in, sizeof(out)) == 0);
+  TEST_ASSERT_TRUE(memcmp(out, card_sector(100), sizeof(out)) == 0);
+
+  host_sd_spi_stats_t st = host_sd_spi_stats();
+  TEST_ASSERT_EQUAL_UINT32(1u, st.write_cmds);
+  TEST_ASSERT_EQUAL_UINT32(1u, st.read_cmds);
+  TEST_ASSERT_EQUAL_UINT32(8u, st.blocks_written);
+  TEST_ASSERT_EQUAL_UINT32(8u, st.blocks_read);
+  TEST_ASSERT_EQUAL_UINT32(8u, st.pre_erase);
+}
+
+void test_host_sd_spi_standard_capacity_byte_addressing(void) {
+  static uint8_t out[2 * 512], in[2 * 512];
+  fill(out, sizeof(out), 0x33);
+
+  /* SD 2.0 standard capacity, then SD 1.x (no CMD8). */
+  for (uint8_t v1 = 0; v1 < 2; v1++) {
+    insert(4096, 1, v1);
+    sd_spi_info_t info;
+    TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK, sd_spi_get_info(&info));
+    TEST_ASSERT_EQUAL_UINT32(v1 ? SD_SPI_CARD_SDV1 : SD_SPI_CARD_SDV2,
+                             info.type);
+    TEST_ASSERT_EQUAL_UINT32(4096u, info.sectors);
+
+    TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK, hal_disk_write(0, out, 7, 2));
+    TEST_ASSERT_TRUE(memcmp(out, card_sector(7), sizeof(out)) == 0);
+    TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK, hal_disk_read(0, in, 7, 2));
+    TEST_ASSERT_TRUE(memcmp(out, in, sizeof(in)) == 0);
+  }
+}
+
+void test_host_sd_spi_data_crc_error_is_reported(void) {
+  insert(SDHC_SECTORS, 0, 0);
+  static uint8_t out[512], in[512];
+  fill(out, sizeof(out), 0x44);
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK, hal_disk_write(0, out, 9, 1));
+
+  host_sd_spi_fail_next(17, HOST_SD_SPI_FAULT_DATA_CRC);
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_ERROR, hal_disk_read(0, in, 9, 1));
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK, hal_disk_read(0, in, 9, 1));
+  TEST_ASSERT_TRUE(memcmp(out, in, sizeof(in)) == 0);
+
+  /* The card rejects a block whose CRC16 does not match. */
+  host_sd_spi_reset_stats();
+  host_sd_spi_fail_next(24, HOST_SD_SPI_FAULT_DATA_CRC);
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_ERROR, hal_disk_write(0, in, 10, 1));
+  TEST_ASSERT_EQUAL_UINT32(0u, host_sd_spi_stats().blocks_written);
+}
+
+void test_host_sd_spi_command_errors_are_reported(void) {
+  insert(SDHC_SECTORS, 0, 0);
+  static uint8_t buf[2 * 512];
+
+  host_sd_spi_fail_next(18, HOST_SD_SPI_FAULT_NO_RESPONSE);
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_ERROR, hal_disk_read(0, buf, 0, 2));
+  host_sd_spi_fail_next(25, HOST_SD_SPI_FAULT_CMD_CRC);
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_ERROR, hal_disk_write(0, buf, 0, 2));
+
+  /* Past the end: a bad start address, and a stream that runs off it. */
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_ERROR,
+                           hal_disk_read(0, buf, SDHC_SECTORS, 1));
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_ERROR,
+                           hal_disk_read(0, buf, SDHC_SECTORS - 1, 2));
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK, hal_disk_read(0, buf, 0, 2));
+
+#if HAL_DISK_LBA64
+  /* Beyond the 32-bit bus address: refused before any command goes out. */
+  host_sd_spi_reset_stats();
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_PARERR,
+                           hal_disk_read(0, buf, 0x100000000ULL, 1));
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_PARERR,
+                           hal_disk_write(0, buf, 0xFFFFFFFFULL, 2));
+  TEST_ASSERT_EQUAL_UINT32(0u, host_sd_spi_stats().commands);
+#endif
+}
+
+void test_host_sd_spi_no_card(void) {
+  host_mmio_reset();
+  host_sd_spi_detach();
+  static uint8_t buf[512];
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_STATUS_NOINIT, hal_disk_initialize(0));
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_NOTRDY, hal_disk_read(0, buf, 0, 1));
+  sd_spi_info_t info;
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_NOTRDY, sd_spi_get_info(&info));
+}
+
+void test_host_sd_spi_trim_erases_range(void) {
+  insert(SDHC_SECTORS, 0, 0);
+  static uint8_t out[4 * 512];
+  static const uint8_t zero[4 * 512];
+  fill(out, sizeof(out), 0x66);
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK, hal_disk_write(0, out, 200, 4));
+
+  hal_disk_lba_t range[2] = {200, 203};
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK,
+                           hal_disk_ioctl(0, HAL_DISK_IO_TRIM, range));
+  TEST_ASSERT_TRUE(memcmp(zero, card_sector(200), sizeof(zero)) == 0);
+  TEST_ASSERT_EQUAL_UINT32(1u, host_sd_spi_stats().erases);
+}
+
+void test_host_sd_spi_fatfs_file_roundtrip(void) {
+  insert(SDHC_SECTORS, 0, 0);
+  static FATFS fs;
+  static FIL fp;
+  static uint8_t work[FF_MAX_SS];
+  static uint8_t out[3000], in[3000];
+  UINT n;
+
+  fill(out, sizeof(out), 0x77);
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_mkfs("0:", NULL, work, sizeof(work)));
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_mount(&fs, "0:", 1));
+
+  TEST_ASSERT_EQUAL_UINT32(FR_OK,
+                           f_open(&fp, "0:LOG.BIN", FA_CREATE_ALWAYS | FA_WRITE));
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_write(&fp, out, sizeof(out), &n));
+  TEST_ASSERT_EQUAL_UINT32(sizeof(out), n);
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_close(&fp));
+
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_open(&fp, "0:LOG.BIN", FA_READ));
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_read(&fp, in, sizeof(in), &n));
+  TEST_ASSERT_EQUAL_UINT32(sizeof(in), n);
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_close(&fp));
+  TEST_ASSERT_TRUE(memcmp(out, in, sizeof(out)) == 0);
+
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_mount(NULL, "0:", 0));
+  TEST_ASSERT_EQUAL_UINT32(0x55u, card_sector(0)[510]);
+  TEST_ASSERT_EQUAL_UINT32(0xAAu, card_sector(0)[511]);
+}
+
+NAVTEST_CASE_DECL(test_host_sd_spi_init_sdhc);
+NAVTEST_CASE_DECL(test_host_sd_spi_sdxc_au_sizes);
+NAVTEST_CASE_DECL(test_host_sd_spi_clock_switches_after_init);
+NAVTEST_CASE_DECL(test_host_sd_spi_single_block_roundtrip);
+NAVTEST_CASE_DECL(test_host_sd_spi_multi_block_is_one_command);
+NAVTEST_CASE_DECL(test_host_sd_spi_standard_capacity_byte_addressing);
+NAVTEST_CASE_DECL(test_host_sd_spi_data_crc_error_is_reported);
+NAVTEST_CASE_DECL(test_host_sd_spi_command_errors_are_reported);
+NAVTEST_CASE_DECL(test_host_sd_spi_no_card);
+NAVTEST_CASE_DECL(test_host_sd_spi_trim_erases_range);
+NAVTEST_CASE_DECL(test_host_sd_spi_fatfs_file_roundtrip);
+
+static const navtest_case_t sd_spi_cases[] = {
+    NAVTEST_CASE(test_host_sd_spi_init_sdhc),
+    NAVTEST_CASE(test_host_sd_spi_sdxc_au_sizes),
+    NAVTEST_CASE(test_host_sd_spi_clock_switches_after_init),
+    NAVTEST_CASE(test_host_sd_spi_single_block_roundtrip),
+    NAVTEST_CASE(test_host_sd_spi_multi_block_is_one_command),
+    NAVTEST_CASE(test_host_sd_spi_standard_capacity_byte_addressing),
+    NAVTEST_CASE(test_host_sd_spi_data_crc_error_is_reported),
+    NAVTEST_CASE(test_host_sd_spi_command_errors_are_reported),
+    NAVTEST_CASE(test_host_sd_spi_no_card),
+    NAVTEST_CASE(test_host_sd_spi_trim_erases_range),
+    NAVTEST_CASE(test_host_sd_spi_fatfs_file_roundtrip),
+};
+
+const navtest_suite_t test_sd_spi_suite = {
+    .name = "SD OVER SPI (host)",
+    .cases = sd_spi_cases,
+    .count = sizeof(sd_spi_cases) / sizeof(sd_spi_cases[0]),
+    .between = NULL,
+};
@@ -0,0 +1,471 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file test_sdio_dma.c
+ * @brief Deep host (SIL) tests for the DMA backend of sdio.c — the request
+ *        queue, its interrupt handlers, abort and the legacy async calls —
+ *        and the write-behind of the SDIO diskio.c, against host_sd.c.
+ *
+ * The tests play the NVIC and SysTick (::service): the DMA engine of
+ * host_mmio.c moves the FIFO words and calls the stream handlers,
+ * SDIO_IRQHandler is called while an unmasked SDIO flag is up, and the
+ * driver's timebase hook runs once per step. Transfer buffers live in the
+ * simulated SRAM, which the 32-bit stream addresses can reach. As in
+ * test_sdio_driver.c the cases share one card and run in order.
+ *
+ * Built twice: tests_host_sdio_dma_cache turns the D-cache on (host_cache.h),
+ * where reads into buffers off a cache line must be refused by the queue and
+ * bounced by diskio.c, and no invalidate may cut through a line.
+ */
+
+#include "host_mmio.h"
+#include "host_sd.h"
+#include "navhal_port_config.h"
+#include "navhal_port_sdio.h"
+#include "navhal_port_timer.h"
+#include "common/hal_cache.h"
+#include "common/hal_diskio.h"
+#include "family/dma_reg.h"
+#include "family/interrupt_reg.h"
+#include "family/rcc_reg.h"
+#include "navtest/navtest.h"
+#include <stdint.h>
+#include <string.h>
+#if NAVHAL_HAS_CACHE
+#include "host_cache.h"
+#endif
+
+#define CARD_SECTORS 8192U
+
+/* Simulated SRAM, 4 KB apart. */
+#define BUF(n) ((uint8_t *)(HOST_SRAM_BASE + (n) * 0x1000U))
+
+extern void SDIO_IRQHandler(void);
+
+static int s_inserted;
+
+/* Completions in the order the callbacks ran. */
+static hal_sdio_request_t *s_done[4];
+static hal_sdio_error_t s_done_status[4];
+static uint32_t s_ndone;
+static hal_sdio_error_t s_legacy_status;
+static uint32_t s_legacy_calls;
+
+static void on_done(hal_sdio_error_t status, void *ctx) {
+  if (s_ndone < 4) {
+    s_done[s_ndone] = ctx;
+    s_done_status[s_ndone] = status;
+  }
+  s_ndone++;
+}
+
+static void on_legacy_done(hal_sdio_error_t status) {
+  s_legacy_status = status;
+  s_legacy_calls++;
+}
+
+static hal_sdio_request_t request(uint32_t sector, uint8_t *buf,
+                                  uint32_t count, uint8_t write) {
+  return (hal_sdio_request_t){.sector = sector,
+                              .buffer = buf,
+                              .count = count,
+                              .write = write,
+                              .callback = on_done};
+}
+
+static void fill(uint8_t *p, uint32_t n, uint8_t seed) {
+  for (uint32_t i = 0; i < n; i++)
+    p[i] = (uint8_t)(seed + i * 7U);
+}
+
+static const uint8_t *card_sector(uint32_t sector) {
+  return host_sd_image() + (size_t)sector * 512U;
+}
+
+/**
+ * Play the NVIC once: run the DMA streams (whose handlers the engine calls)
+ * and take the SDIO interrupt if it is pending.
+ * @return 1 if the SDIO interrupt was taken.
+ */
+static uint32_t take_irqs(void) {
+  host_dma_run();
+  if (host_irq_enabled(SDIO_IRQn) && (SDIO->STA & SDIO->MASK)) {
+    SDIO_IRQHandler();
+    return 1;
+  }
+  return 0;
+}
+
+/** One SysTick, then the NVIC. @return 1 if the SDIO interrupt was taken. */
+static uint32_t tick(void) {
+  hal_timebase_driver_tick();
+  return take_irqs();
+}
+
+static void tick_hook(void) { (void)tick(); }
+
+/** Play the NVIC until the queue drains. @return SDIO interrupts taken. */
+static uint32_t service(void) {
+  uint32_t irqs = 0;
+  for (uint32_t i = 0; i < 10000U && hal_sdio_queue_busy(); i++)
+    irqs += tick();
+  return irqs;
+}
+
+#define REQUIRE_CARD()                                                         \
+  do {                                                                         \
+    if (!s_inserted)                                                           \
+      return;                                                                  \
+    s_ndone = 0;                                                               \
+  } while (0)
+
+void test_host_sdio_dma_card_init(void) {
+  host_mmio_reset();
+  const host_sd_config_t card = {.sectors = CARD_SECTORS,
+                                 .au_size = 3,
+                                 .init_polls = 2,
+                                 .busy_polls = 3};
+  s_inserted = host_sd_attach(&card);
+  if (!s_inserted) {
+    navtest_write("  (register trapping unavailable: SD suite skipped)\n");
+    return;
+  }
+
+  /* 48 MHz SDIOCLK from the PLL (HSI / 8 * 192 / 8). */
+  RCC->PLLCFGR = 8U | (192U << 6) | (8U << 24);
+  RCC->CFGR = 0x2U << 2;
+
+  const hal_sdio_config_t cfg = {.bus_width = 1};
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, hal_sdio_init(&cfg));
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, hal_sdio_card_init());
+  TEST_ASSERT_EQUAL_UINT32(CARD_SECTORS, hal_sdio_get_sector_count());
+#if NAVHAL_HAS_CACHE
+  hal_cache_dcache_enable();
+  host_cache_reset_stats();
+#endif
+  TEST_ASSERT_TRUE(host_irq_enabled(SDIO_IRQn));
+  TEST_ASSERT_TRUE(host_irq_enabled(DMA2_Stream3_IRQn));
+  TEST_ASSERT_TRUE(host_irq_enabled(DMA2_Stream6_IRQn));
+  TEST_ASSERT_FALSE(hal_sdio_queue_busy());
+}
+
+void test_host_sdio_dma_queue_runs_in_order(void) {
+  REQUIRE_CARD();
+  fill(BUF(0), 4 * 512, 0x21);
+  hal_sdio_request_t w = request(100, BUF(0), 4, 1);
+  hal_sdio_request_t r = request(100, BUF(1), 4, 0);
+  hal_sdio_request_t u = request(101, BUF(2), 1, 0);
+  w.ctx = &w;
+  r.ctx = &r;
+  u.ctx = &u;
+  host_sd_reset_stats();
+  uint32_t transfers = host_dma_stats().transfers;
+
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_PENDING, hal_sdio_submit(&w));
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_PENDING, hal_sdio_submit(&r));
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_PENDING, hal_sdio_submit(&u));
+  TEST_ASSERT_TRUE(hal_sdio_queue_busy());
+  /* Nothing moves until the interrupts are taken. */
+  TEST_ASSERT_EQUAL_UINT32(0u, host_sd_stats().write_cmds);
+
+  TEST_ASSERT_TRUE(service() > 0);
+  TEST_ASSERT_FALSE(hal_sdio_queue_busy());
+  TEST_ASSERT_EQUAL_UINT32(3u, s_ndone);
+  TEST_ASSERT_TRUE(s_done[0] == &w && s_done[1] == &r && s_done[2] == &u);
+  for (uint32_t i = 0; i < 3; i++)
+    TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, s_done_status[i]);
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, w.status);
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, r.status);
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, u.status);
+
+  TEST_ASSERT_TRUE(memcmp(BUF(0), card_sector(100), 4 * 512) == 0);
+  TEST_ASSERT_TRUE(memcmp(BUF(0), BUF(1), 4 * 512) == 0);
+  TEST_ASSERT_TRUE(memcmp(BUF(2), card_sector(101), 512) == 0);
+#if NAVHAL_HAS_CACHE
+  /* The lines under the last read were dropped once its data was in. */
+  TEST_ASSERT_TRUE(host_cache_stats().last_invalidate == (uintptr_t)BUF(2));
+#endif
+
+  /* One CMD25 and one DMA stream run per request. */
+  host_sd_stats_t st = host_sd_stats();
+  TEST_ASSERT_EQUAL_UINT32(1u, st.write_cmds);
+  TEST_ASSERT_EQUAL_UINT32(4u, st.blocks_written);
+  TEST_ASSERT_EQUAL_UINT32(2u, st.read_cmds);
+  TEST_ASSERT_EQUAL_UINT32(5u, st.blocks_read);
+  TEST_ASSERT_EQUAL_UINT32(3u, host_dma_stats().transfers - transfers);
+}
+
+void test_host_sdio_dma_unaligned_read(void) {
+  REQUIRE_CARD();
+  uint8_t *unaligned = BUF(2) + 1;
+  hal_sdio_request_t u = request(101, unaligned, 1, 0);
+#if NAVHAL_HAS_CACHE
+  /* It shares its first and last cache line: refused with the D-cache on. */
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_ERROR, hal_sdio_submit(&u));
+  TEST_ASSERT_FALSE(hal_sdio_queue_busy());
+#else
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_PENDING, hal_sdio_submit(&u));
+  service();
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, u.status);
+  TEST_ASSERT_TRUE(memcmp(unaligned, card_sector(101), 512) == 0);
+#endif
+}
+
+void test_host_sdio_dma_rejects_bad_request(void) {
+  REQUIRE_CARD();
+  hal_sdio_request_t none = request(0, BUF(0), 0, 0);
+  hal_sdio_request_t nobuf = request(0, 0, 1, 0);
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_ERROR, hal_sdio_submit(&none));
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_ERROR, hal_sdio_submit(&nobuf));
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_ERROR, hal_sdio_submit(0));
+  TEST_ASSERT_FALSE(hal_sdio_queue_busy());
+}
+
+void test_host_sdio_dma_data_crc_fails_request(void) {
+  REQUIRE_CARD();
+  hal_sdio_request_t r = request(100, BUF(1), 1, 0);
+  memset(BUF(1), 0, 512);
+  host_sd_fail_next(SD_CMD_READ_SINGLE_BLOCK, HOST_SD_FAULT_DATA_CRC);
+
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_PENDING, hal_sdio_submit(&r));
+  service();
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_CRC_FAIL, r.status);
+  TEST_ASSERT_EQUAL_UINT32(1u, s_ndone);
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_CRC_FAIL, s_done_status[0]);
+  /* The queue does not retry, but has stepped the clock down for the
+   * caller's retry: 48 MHz / 2. */
+  TEST_ASSERT_EQUAL_UINT32(24000000u, hal_sdio_get_bus_clock());
+
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_PENDING, hal_sdio_submit(&r));
+  service();
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, r.status);
+  TEST_ASSERT_TRUE(memcmp(BUF(1), card_sector(100), 512) == 0);
+}
+
+void test_host_sdio_dma_busy_polls_paced(void) {
+  REQUIRE_CARD();
+  fill(BUF(0), 2 * 512, 0x43);
+  hal_sdio_request_t w = request(400, BUF(0), 2, 1);
+  hal_sdio_request_t r = request(400, BUF(1), 2, 0);
+  host_sd_reset_stats();
+
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_PENDING, hal_sdio_submit(&w));
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_PENDING, hal_sdio_submit(&r));
+  /* Interrupts alone: the write goes out and the read stops at the card's
+   * busy status. No CMD13 follows until the next tick. */
+  for (uint32_t i = 0; i < 1000U; i++)
+    take_irqs();
+  TEST_ASSERT_EQUAL_UINT32(1u, s_ndone);
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, w.status);
+  uint32_t commands = host_sd_stats().commands;
+  for (uint32_t i = 0; i < 1000U; i++)
+    take_irqs();
+  TEST_ASSERT_EQUAL_UINT32(commands, host_sd_stats().commands);
+  TEST_ASSERT_EQUAL_UINT32(0u, host_sd_stats().read_cmds);
+
+  /* The card is done by now: one tick, one CMD13, and the read starts. */
+  tick();
+  TEST_ASSERT_EQUAL_UINT32(1u, host_sd_stats().read_cmds);
+  service();
+  TEST_ASSERT_EQUAL_UINT32(2u, s_ndone);
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, r.status);
+  TEST_ASSERT_TRUE(memcmp(BUF(1), card_sector(400), 2 * 512) == 0);
+}
+
+void test_host_sdio_dma_busy_times_out(void) {
+  REQUIRE_CARD();
+  fill(BUF(0), 512, 0x57);
+  hal_sdio_request_t w = request(410, BUF(0), 1, 1);
+  hal_sdio_request_t r = request(410, BUF(1), 1, 0);
+  hal_sdio_request_t r2 = request(410, BUF(2), 1, 0);
+  host_sd_reset_stats();
+
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_PENDING, hal_sdio_submit(&w));
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_PENDING, hal_sdio_submit(&r));
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_PENDING, hal_sdio_submit(&r2));
+  for (uint32_t i = 0; i < 1000U; i++)
+    take_irqs();
+  TEST_ASSERT_EQUAL_UINT32(1u, s_ndone);
+
+  /* A second on, the status read still gets nowhere (no response here):
+   * the read waiting on the card fails and the next one starts afresh. */
+  host_sd_fail_next(13, HOST_SD_FAULT_CMD_TIMEOUT);
+  hal_delay_ms(1000);
+  tick();
+  TEST_ASSERT_EQUAL_UINT32(2u, s_ndone);
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_TIMEOUT, r.status);
+  TEST_ASSERT_TRUE(hal_sdio_queue_busy());
+
+  service();
+  TEST_ASSERT_EQUAL_UINT32(3u, s_ndone);
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, r2.status);
+  TEST_ASSERT_EQUAL_UINT32(1u, host_sd_stats().read_cmds);
+  TEST_ASSERT_TRUE(memcmp(BUF(2), card_sector(410), 512) == 0);
+}
+
+void test_host_sdio_dma_abort_fails_queue(void) {
+  REQUIRE_CARD();
+  fill(BUF(0), 512, 0x43);
+  hal_sdio_request_t r = request(100, BUF(1), 4, 0);
+  hal_sdio_request_t w = request(200, BUF(0), 1, 1);
+  r.ctx = &r;
+  w.ctx = &w;
+
+  /* The read is on the bus, its stream armed; the write waits behind it. */
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_PENDING, hal_sdio_submit(&r));
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_PENDING, hal_sdio_submit(&w));
+  TEST_ASSERT_BITS_HIGH(DMA_SxCR_EN, DMA2->STREAM[3].CR);
+
+  host_sd_reset_stats();
+  hal_sdio_abort();
+  TEST_ASSERT_FALSE(hal_sdio_queue_busy());
+  TEST_ASSERT_BITS_LOW(DMA_SxCR_EN, DMA2->STREAM[3].CR);
+  TEST_ASSERT_EQUAL_UINT32(2u, s_ndone);
+  TEST_ASSERT_TRUE(s_done[0] == &r && s_done[1] == &w);
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_ERROR, s_done_status[0]);
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_ERROR, s_done_status[1]);
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_ERROR, w.status);
+  /* The open CMD18 was stopped, and the write never reached the card. */
+  TEST_ASSERT_EQUAL_UINT32(1u, host_sd_stats().commands);
+  TEST_ASSERT_FALSE(memcmp(BUF(0), card_sector(200), 512) == 0);
+
+  /* The card is back in tran: the next request goes through. */
+  s_ndone = 0;
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_PENDING, hal_sdio_submit(&w));
+  service();
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, w.status);
+  TEST_ASSERT_TRUE(memcmp(BUF(0), card_sector(200), 512) == 0);
+}
+
+void test_host_sdio_dma_wait_sync_times_out(void) {
+  REQUIRE_CARD();
+  s_legacy_calls = 0;
+  hal_sdio_set_callback(on_legacy_done);
+
+  /* Nobody takes the interrupts: the wait gives up and aborts. */
+  hal_sdio_error_t res = hal_sdio_read_blocks_async(100, BUF(1), 2);
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_PENDING, res);
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_BUSY, hal_sdio_read_block_async(0, BUF(2)));
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_TIMEOUT, hal_sdio_wait_sync(res));
+  TEST_ASSERT_FALSE(hal_sdio_queue_busy());
+  TEST_ASSERT_EQUAL_UINT32(1u, s_legacy_calls);
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_ERROR, s_legacy_status);
+
+  /* With the interrupts served, the same call completes. */
+  memset(BUF(1), 0, 512);
+  res = hal_sdio_read_block_async(100, BUF(1));
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_PENDING, res);
+  service();
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, hal_sdio_wait_sync(res));
+  TEST_ASSERT_EQUAL_UINT32(2u, s_legacy_calls);
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, s_legacy_status);
+  TEST_ASSERT_TRUE(memcmp(BUF(1), card_sector(100), 512) == 0);
+  hal_sdio_set_callback(0);
+}
+
+void test_host_sdio_dma_write_behind(void) {
+  REQUIRE_CARD();
+  fill(BUF(0), 3 * 512, 0x65);
+  const hal_disk_async_write_t w = {.buff = BUF(0), .sector = 300, .count = 3};
+  host_sd_reset_stats();
+
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_STATUS_OK, hal_disk_initialize(0));
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK,
+                           hal_disk_ioctl(0, HAL_DISK_IO_WRITE_ASYNC,
+                                          (void *)&w));
+  /* Returned with the write queued, not done. */
+  TEST_ASSERT_TRUE(hal_sdio_queue_busy());
+  TEST_ASSERT_EQUAL_UINT32(0u, host_sd_stats().blocks_written);
+
+  service();
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK,
+                           hal_disk_ioctl(0, HAL_DISK_IO_SYNC, 0));
+  TEST_ASSERT_TRUE(memcmp(BUF(0), card_sector(300), 3 * 512) == 0);
+  TEST_ASSERT_EQUAL_UINT32(1u, host_sd_stats().write_cmds);
+  TEST_ASSERT_EQUAL_UINT32(3u, host_sd_stats().blocks_written);
+}
+
+void test_host_sdio_dma_disk_read_unaligned(void) {
+  REQUIRE_CARD();
+  uint8_t *unaligned = BUF(3) + 4;
+  memset(unaligned, 0, 6 * 512);
+  host_sd_reset_stats();
+
+  /* hal_disk_read blocks in hal_sdio_wait_sync: take the interrupts there. */
+  host_timebase_set_hook(tick_hook);
+  hal_disk_result_t res = hal_disk_read(0, unaligned, 100, 6);
+  host_timebase_set_hook(0);
+
+  TEST_ASSERT_EQUAL_UINT32(HAL_DISK_RES_OK, res);
+  TEST_ASSERT_TRUE(memcmp(unaligned, card_sector(100), 6 * 512) == 0);
+#if NAVHAL_HAS_CACHE
+  /* Through the 4-sector bounce buffer: two commands instead of one. */
+  TEST_ASSERT_EQUAL_UINT32(2u, host_sd_stats().read_cmds);
+#else
+  TEST_ASSERT_EQUAL_UINT32(1u, host_sd_stats().read_cmds);
+#endif
+}
+
+#if NAVHAL_HAS_CACHE
+void test_host_sdio_dma_no_split_invalidates(void) {
+  REQUIRE_CARD();
+  /* Every read in the suite left the lines beside its buffer alone. */
+  host_cache_stats_t st = host_cache_stats();
+  TEST_ASSERT_TRUE(st.invalidates > 0);
+  TEST_ASSERT_EQUAL_UINT32(0u, st.split_invalidates);
+}
+#endif
+
+NAVTEST_CASE_DECL(test_host_sdio_dma_card_init);
+NAVTEST_CASE_DECL(test_host_sdio_dma_queue_runs_in_order);
+NAVTEST_CASE_DECL(test_host_sdio_dma_unaligned_read);
+NAVTEST_CASE_DECL(test_host_sdio_dma_rejects_bad_request);
+NAVTEST_CASE_DECL(test_host_sdio_dma_data_crc_fails_request);
+NAVTEST_CASE_DECL(test_host_sdio_dma_busy_polls_paced);
+NAVTEST_CASE_DECL(test_host_sdio_dma_busy_times_out);
+NAVTEST_CASE_DECL(test_host_sdio_dma_abort_fails_queue);
+NAVTEST_CASE_DECL(test_host_sdio_dma_wait_sync_times_out);
+NAVTEST_CASE_DECL(test_host_sdio_dma_write_behind);
+NAVTEST_CASE_DECL(test_host_sdio_dma_disk_read_unaligned);
+#if NAVHAL_HAS_CACHE
+NAVTEST_CASE_DECL(test_host_sdio_dma_no_split_invalidates);
+#endif
+
+static const navtest_case_t sdio_dma_cases[] = {
+    NAVTEST_CASE(test_host_sdio_dma_card_init),
+    NAVTEST_CASE(test_host_sdio_dma_queue_runs_in_order),
+    NAVTEST_CASE(test_host_sdio_dma_unaligned_read),
+    NAVTEST_CASE(test_host_sdio_dma_rejects_bad_request),
+    NAVTEST_CASE(test_host_sdio_dma_data_crc_fails_request),
+    NAVTEST_CASE(test_host_sdio_dma_busy_polls_paced),
+    NAVTEST_CASE(test_host_sdio_dma_busy_times_out),
+    NAVTEST_CASE(test_host_sdio_dma_abort_fails_queue),
+    NAVTEST_CASE(test_host_sdio_dma_wait_sync_times_out),
+    NAVTEST_CASE(test_host_sdio_dma_write_behind),
+    NAVTEST_CASE(test_host_sdio_dma_disk_read_unaligned),
+#if NAVHAL_HAS_CACHE
+    NAVTEST_CASE(test_host_sdio_dma_no_split_invalidates),
+#endif
+};
+
+const navtest_suite_t test_sdio_dma_suite = {
+    .name = "SDIO DMA QUEUE (host)",
+    .cases = sdio_dma_cases,
+    .count = sizeof(sdio_dma_cases) / sizeof(sdio_dma_cases[0]),
+    .between = NULL,
+};
@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file test_sdio_driver.c
+ * @brief Deep host (SIL) tests for the polled sdio.c, the SDIO diskio.c and
+ *        FatFs on top, against the SD card model in host_sd.c.
+ *
+ * sdio.c initialises the card once per process, so the cases share one
+ * card and run in order: the first inserts it and runs the handshake, the
+ * last removes it and checks what was left in the image file. Hosts that
+ * cannot trap register accesses skip the suite.
+ */
+
+#include "host_mmio.h"
+#include "host_sd.h"
+#include "navhal_port_config.h"
+#include "common/hal_diskio.h"
+#include "common/hal_sdio.h"
+#include "family/rcc_reg.h"
+#include "ff.h"
+#include "navtest/navtest.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define CARD_SECTORS 8192U
+
+static char s_image[] = "/tmp/navhal_sd_XXXXXX";
+static int s_inserted;
+
+static void fill(uint8_t *p, uint32_t n, uint8_t seed) {
+  for (uint32_t i = 0; i < n; i++)
+    p[i] = (uint8_t)(seed + i * 7U);
+}
+
+static const uint8_t *card_sector(uint32_t sector) {
+  return host_sd_image() + (size_t)sector * 512U;
+}
+
+#define REQUIRE_CARD()                                                         \
+  do {                                                                         \
+    if (!s_inserted)                                                           \
+      return;                                                                  \
+  } while (0)
+
+void test_host_sdio_card_init_reads_geometry(void) {
+  host_mmio_reset();
+  int fd = mkstemp(s_image);
+  TEST_ASSERT_TRUE(fd >= 0);
+  close(fd);
+
+  const host_sd_config_t card = {.image = s_image,
+                                 .sectors = CARD_SECTORS,
+                                 .au_size = 3, /* 64 KB */
+                                 .init_polls = 2,
+                                 .busy_polls = 3};
+  s_inserted = host_sd_attach(&card);
+  if (!s_inserted) {
+    navtest_write("  (register trapping unavailable: SD suite skipped)\n");
+    unlink(s_image);
+    return;
+  }
+
+  /* 48 MHz SDIOCLK from the PLL (HSI / 8 * 192 / 8). */
+  RCC->PLLCFGR = 8U | (192U << 6) | (8U << 24);
+  RCC->CFGR = 0x2U << 2;
+
+  const hal_sdio_config_t cfg = {.bus_width = 1};
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, hal_sdio_init(&cfg));
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, hal_sdio_card_init());
+
+  TEST_ASSERT_EQUAL_UINT32(CARD_SECTORS, hal_sdio_get_sector_count());
+  TEST_ASSERT_EQUAL_UINT32(128u, hal_sdio_get_erase_unit());
+  TEST_ASSERT_EQUAL_UINT32(SDIO_CLKCR_WIDBUS_4B,
+                           SDIO->CLKCR & SDIO_CLKCR_WIDBUS_Msk);
+  /* High Speed accepted: 48 MHz is under 50 MHz, so the divider is bypassed. */
+  TEST_ASSERT_EQUAL_UINT32(48000000u, hal_sdio_get_bus_clock());
+}
+
+void test_host_sdio_single_block_roundtrip(void) {
+  REQUIRE_CARD();
+  static uint8_t out[512], in[512];
+  fill(out, sizeof(out), 0x11);
+  host_sd_reset_stats();
+
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, hal_sdio_write_block(5, out));
+  TEST_ASSERT_TRUE(memcmp(out, card_sector(5), 512) == 0);
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, hal_sdio_read_block(5, in));
+  TEST_ASSERT_TRUE(memcmp(out, in, 512) == 0);
+
+  host_sd_stats_t st = host_sd_stats();
+  TEST_ASSERT_EQUAL_UINT32(1u, st.write_cmds);
+  TEST_ASSERT_EQUAL_UINT32(1u, st.read_cmds);
+  /* The write's DAT0 busy was waited out before the read went out. */
+  TEST_ASSERT_EQUAL_UINT32(3u, st.busy_polls);
+}
+
+void test_host_sdio_multi_block_is_one_command(void) {
+  REQUIRE_CARD();
+  static uint8_t out[4 * 512], in[4 * 512];
+  fill(out, sizeof(out), 0x22);
+  host_sd_reset_stats();
+
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, hal_sdio_write_blocks(100, out, 4));
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, hal_sdio_read_blocks(100, in, 4));
+  TEST_ASSERT_TRUE(memcmp(out, in, sizeof(out)) == 0);
+  TEST_ASSERT_TRUE(memcmp(out, card_sector(100), sizeof(out)) == 0);
+
+  host_sd_stats_t st = host_sd_stats();
+  TEST_ASSERT_EQUAL_UINT32(1u, st.write_cmds);
+  TEST_ASSERT_EQUAL_UINT32(4u, st.blocks_written);
+  TEST_ASSERT_EQUAL_UINT32(1u, st.read_cmds);
+  TEST_ASSERT_EQUAL_UINT32(4u, st.blocks_read);
+}
+
+void test_host_sdio_unaligned_buffer(void) {
+  REQUIRE_CARD();
+  static uint8_t raw[512 + 4];
+  uint8_t *buf = raw + 1;
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, hal_sdio_read_block(5, buf));
+  TEST_ASSERT_TRUE(memcmp(buf, card_sector(5), 512) == 0);
+}
+
+void test_host_sdio_data_crc_retries_slower(void) {
+  REQUIRE_CARD();
+  static uint8_t in[512];
+  host_sd_reset_stats();
+  host_sd_fail_next(SD_CMD_READ_SINGLE_BLOCK, HOST_SD_FAULT_DATA_CRC);
+
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, hal_sdio_read_block(5, in));
+  TEST_ASSERT_TRUE(memcmp(in, card_sector(5), 512) == 0);
+  TEST_ASSERT_EQUAL_UINT32(2u, host_sd_stats().read_cmds);
+  /* The retry ran with the ceiling halved to 25 MHz: 48 MHz / 2. */
+  TEST_ASSERT_EQUAL_UINT32(24000000u, hal_sdio_get_bus_clock());
+}
+
+void test_host_sdio_command_timeout_is_reported(void) {
+  REQUIRE_CARD();
+  static uint8_t out[512];
+  fill(out, sizeof(out), 0x33);
+  host_sd_fail_next(SD_CMD_WRITE_SINGLE_BLOCK, HOST_SD_FAULT_CMD_TIMEOUT);
+
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_ERROR, hal_sdio_write_block(6, out));
+  TEST_ASSERT_FALSE(memcmp(out, card_sector(6), 512) == 0);
+  /* Nothing stuck: the next attempt goes through. */
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, hal_sdio_write_block(6, out));
+  TEST_ASSERT_TRUE(memcmp(out, card_sector(6), 512) == 0);
+}
+
+void test_host_sdio_read_past_end_times_out(void) {
+  REQUIRE_CARD();
+  static uint8_t in[512];
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_TIMEOUT,
+                           hal_sdio_read_block(CARD_SECTORS, in));
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, hal_sdio_read_block(0, in));
+}
+
+void test_host_sdio_erase_zeroes_range(void) {
+  REQUIRE_CARD();
+  static uint8_t out[4 * 512];
+  static const uint8_t zero[4 * 512];
+  fill(out, sizeof(out), 0x44);
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, hal_sdio_write_blocks(200, out, 4));
+  host_sd_reset_stats();
+
+  TEST_ASSERT_EQUAL_UINT32(HAL_SDIO_OK, hal_sdio_erase(200, 203));
+  TEST_ASSERT_TRUE(memcmp(zero, card_sector(200), sizeof(zero)) == 0);
+  TEST_ASSERT_EQUAL_UINT32(1u, host_sd_stats().erases);
+  TEST_ASSERT_EQUAL_UINT32(3u, host_sd_stats().busy_polls); /* CMD13 polls */
+}
+
+void test_host_sdio_fatfs_file_roundtrip(void) {
+  REQUIRE_CARD();
+  static FATFS fs;
+  static FIL fp;
+  static uint8_t work[FF_MAX_SS];
+  static uint8_t out[3000], in[3000];
+  UINT n;
+
+  fill(out, sizeof(out), 0x55);
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_mkfs("0:", NULL, work, sizeof(work)));
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_mount(&fs, "0:", 1));
+
+  TEST_ASSERT_EQUAL_UINT32(FR_OK,
+                           f_open(&fp, "0:LOG.BIN", FA_CREATE_ALWAYS | FA_WRITE));
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_write(&fp, out, sizeof(out), &n));
+  TEST_ASSERT_EQUAL_UINT32(sizeof(out), n);
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_close(&fp));
+
+  host_sd_reset_stats();
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_open(&fp, "0:LOG.BIN", FA_READ));
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_read(&fp, in, sizeof(in), &n));
+  TEST_ASSERT_EQUAL_UINT32(sizeof(in), n);
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_close(&fp));
+  TEST_ASSERT_TRUE(memcmp(out, in, sizeof(out)) == 0);
+  /* Every sector FatFs read came from the card. */
+  TEST_ASSERT_TRUE(host_sd_stats().blocks_read > 0);
+
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_mount(NULL, "0:", 0));
+}
+
+void test_host_sdio_image_file_keeps_volume(void) {
+  REQUIRE_CARD();
+  host_sd_detach();
+  s_inserted = 0;
+
+  uint8_t boot[512];
+  FILE *f = fopen(s_image, "rb");
+  TEST_ASSERT_TRUE(f != NULL);
+  TEST_ASSERT_EQUAL_UINT32(1u, (uint32_t)fread(boot, sizeof(boot), 1, f));
+  fclose(f);
+  unlink(s_image);
+  /* The boot sector f_mkfs wrote ends in the 0x55AA signature. */
+  TEST_ASSERT_EQUAL_UINT32(0x55u, boot[510]);
+  TEST_ASSERT_EQUAL_UINT32(0xAAu, boot[511]);
+}
+
+NAVTEST_CASE_DECL(test_host_sdio_card_init_reads_geometry);
+NAVTEST_CASE_DECL(test_host_sdio_single_block_roundtrip);
+NAVTEST_CASE_DECL(test_host_sdio_multi_block_is_one_command);
+NAVTEST_CASE_DECL(test_host_sdio_unaligned_buffer);
+NAVTEST_CASE_DECL(test_host_sdio_data_crc_retries_slower);
+NAVTEST_CASE_DECL(test_host_sdio_command_timeout_is_reported);
+NAVTEST_CASE_DECL(test_host_sdio_read_past_end_times_out);
+NAVTEST_CASE_DECL(test_host_sdio_erase_zeroes_range);
+NAVTEST_CASE_DECL(test_host_sdio_fatfs_file_roundtrip);
+NAVTEST_CASE_DECL(test_host_sdio_image_file_keeps_volume);
+
+static const navtest_case_t sdio_driver_cases[] = {
+    NAVTEST_CASE(test_host_sdio_card_init_reads_geometry),
+    NAVTEST_CASE(test_host_sdio_single_block_roundtrip),
+    NAVTEST_CASE(test_host_sdio_multi_block_is_one_command),
+    NAVTEST_CASE(test_host_sdio_unaligned_buffer),
+    NAVTEST_CASE(test_host_sdio_data_crc_retries_slower),
+    NAVTEST_CASE(test_host_sdio_command_timeout_is_reported),
+    NAVTEST_CASE(test_host_sdio_read_past_end_times_out),
+    NAVTEST_CASE(test_host_sdio_erase_zeroes_range),
+    NAVTEST_CASE(test_host_sdio_fatfs_file_roundtrip),
+    NAVTEST_CASE(test_host_sdio_image_file_keeps_volume),
+};
+
+const navtest_suite_t test_sdio_driver_suite = {
+    .name = "SDIO DRIVER (host)",
+    .cases = sdio_driver_cases,
+    .count = sizeof(sdio_driver_cases) / sizeof(sdio_driver_cases[0]),
+    .between = NULL,
+};
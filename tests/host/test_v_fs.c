@@ -0,0 +1,622 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file test_v_fs.c
+ * @brief Host (SIL) tests for the POSIX-like v_fs layer over FatFs, on the
+ *        SPI-mode card model (host_sd_spi.c).
+ *
+ * Built with V_FS_FASTSEEK=1, V_FS_WRITE_BUFFER=1, V_FS_DCACHE=1,
+ * V_FS_MAX_OPEN_FILES=6 and long file names: once with exFAT and 64-bit
+ * offsets and sectors, and once with FF_FS_TINY and neither
+ * (tests_host_sd_spi_tiny). Most cases format a
+ * fresh card with 512-byte clusters, so a file's FAT chain spans many FAT
+ * sectors and the cost of walking it shows up in the card's read count.
+ */
+
+#include "host_mmio.h"
+#include "host_sd_spi.h"
+#include "common/hal_diskio.h"
+#include "utils/v_fs.h"
+#include "ff.h"
+#include "navtest/navtest.h"
+#include <stdint.h>
+#include <string.h>
+
+#define CARD_SECTORS 8192U /* 4 MiB */
+#define BIG_SECTORS 2048U  /* 1 MiB file: 2048 clusters, 8 FAT16 sectors */
+
+static uint8_t s_buf[4096];
+
+/** Fresh card, formatted with @p cluster byte clusters and mounted. */
+static void format_with(uint32_t cluster) {
+  static uint8_t work[FF_MAX_SS];
+  host_mmio_reset();
+  const host_sd_spi_config_t cfg = {.sectors = CARD_SECTORS, .busy_bytes = 1};
+  TEST_ASSERT_TRUE(host_sd_spi_attach(&cfg));
+  const MKFS_PARM opt = {.fmt = FM_FAT, .align = 1, .au_size = cluster};
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_mkfs("0:", &opt, work, sizeof(work)));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_fs_init());
+}
+
+/** Fresh card, formatted with one-sector clusters and mounted by v_fs. */
+static void format(void) { format_with(512); }
+
+/* Sector k of a test file starts with k and is filled from k onwards. */
+static void fill_sector(uint8_t *p, uint32_t k) {
+  for (uint32_t i = 0; i < 512U; i++)
+    p[i] = (uint8_t)(k * 31U + i);
+  memcpy(p, &k, sizeof(k));
+}
+
+static void write_file(const char *path, uint32_t sectors) {
+  v_fd_t fd = v_open(path, V_O_CREAT | V_O_WRONLY | V_O_TRUNC);
+  TEST_ASSERT_TRUE(fd >= 0);
+  for (uint32_t k = 0; k < sectors; k += 8) {
+    for (uint32_t j = 0; j < 8; j++)
+      fill_sector(s_buf + j * 512U, k + j);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(s_buf),
+                             (uint32_t)v_write(fd, s_buf, sizeof(s_buf)));
+  }
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+}
+
+/* Seek into sector @p k at byte 8 and check what is read there. */
+static void check_at(v_fd_t fd, uint32_t k) {
+  uint8_t got[4], want[512];
+  fill_sector(want, k);
+  TEST_ASSERT_EQUAL_UINT32(k * 512U + 8U,
+                           (uint32_t)v_lseek(fd, (long)(k * 512U + 8U),
+                                             V_SEEK_SET));
+  TEST_ASSERT_EQUAL_UINT32(4u, (uint32_t)v_read(fd, got, sizeof(got)));
+  TEST_ASSERT_TRUE(memcmp(got, want + 8, sizeof(got)) == 0);
+}
+
+void test_v_fs_read_only_seek_skips_fat_walk(void) {
+  format();
+  write_file("0:BIG.BIN", BIG_SECTORS);
+
+  /* Writable, no map: reaching the far end follows the chain through the
+   * FAT, one FAT sector per 256 clusters. */
+  v_fd_t fd = v_open("0:BIG.BIN", V_O_RDWR);
+  TEST_ASSERT_TRUE(fd >= 0);
+  host_sd_spi_reset_stats();
+  check_at(fd, BIG_SECTORS - 2);
+  uint32_t walked = host_sd_spi_stats().blocks_read;
+  TEST_ASSERT_TRUE(walked >= 8u);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+
+  /* Read-only: the map is built at open, then any seek is one data read. */
+  fd = v_open("0:BIG.BIN", V_O_RDONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  host_sd_spi_reset_stats();
+  check_at(fd, BIG_SECTORS - 2);
+  TEST_ASSERT_EQUAL_UINT32(1u, host_sd_spi_stats().blocks_read);
+  check_at(fd, 3);
+  check_at(fd, 1500);
+  check_at(fd, 700);
+  TEST_ASSERT_EQUAL_UINT32(4u, host_sd_spi_stats().blocks_read);
+
+  /* Sequential reads across cluster boundaries come from the map too. */
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_lseek(fd, 0, V_SEEK_SET));
+  host_sd_spi_reset_stats();
+  TEST_ASSERT_EQUAL_UINT32(sizeof(s_buf),
+                           (uint32_t)v_read(fd, s_buf, sizeof(s_buf)));
+  TEST_ASSERT_EQUAL_UINT32(8u, host_sd_spi_stats().blocks_read);
+  uint8_t want[512];
+  fill_sector(want, 7);
+  TEST_ASSERT_TRUE(memcmp(s_buf + 7 * 512, want, 512) == 0);
+
+  /* Read-only seeks still clip at the end of the file. */
+  TEST_ASSERT_EQUAL_UINT32(BIG_SECTORS * 512U,
+                           (uint32_t)v_lseek(fd, 10, V_SEEK_END));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+}
+
+void test_v_fs_fragmented_file_falls_back(void) {
+  format();
+  /* Two files written a cluster at a time in turn: every cluster of each
+   * is its own fragment, far more than V_FS_CLMT_ITEMS can map. */
+  v_fd_t a = v_open("0:A.BIN", V_O_CREAT | V_O_WRONLY);
+  v_fd_t b = v_open("0:B.BIN", V_O_CREAT | V_O_WRONLY);
+  TEST_ASSERT_TRUE(a >= 0 && b >= 0);
+  for (uint32_t k = 0; k < 64; k++) {
+    fill_sector(s_buf, k);
+    TEST_ASSERT_EQUAL_UINT32(512u, (uint32_t)v_write(a, s_buf, 512));
+    TEST_ASSERT_EQUAL_UINT32(512u, (uint32_t)v_write(b, s_buf, 512));
+  }
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(a));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(b));
+
+  a = v_open("0:A.BIN", V_O_RDONLY);
+  TEST_ASSERT_TRUE(a >= 0);
+  check_at(a, 63);
+  check_at(a, 5);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(a));
+}
+
+void test_v_fs_writable_fastseek_grows_past_map(void) {
+  format();
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_preallocate("0:LOG.BIN", 65536));
+
+  v_fd_t fd = v_open("0:LOG.BIN", V_O_RDWR | V_O_FASTSEEK);
+  TEST_ASSERT_TRUE(fd >= 0);
+
+  /* In place, inside the preallocated clusters. */
+  fill_sector(s_buf, 77);
+  TEST_ASSERT_EQUAL_UINT32(40000u,
+                           (uint32_t)v_lseek(fd, 40000, V_SEEK_SET));
+  TEST_ASSERT_EQUAL_UINT32(512u, (uint32_t)v_write(fd, s_buf, 512));
+  TEST_ASSERT_EQUAL_UINT32(65536u, (uint32_t)v_lseek(fd, 0, V_SEEK_END));
+
+  /* Past the end: the map is dropped and the file grows. */
+  TEST_ASSERT_EQUAL_UINT32(1024u, (uint32_t)v_write(fd, s_buf, 1024));
+  TEST_ASSERT_EQUAL_UINT32(70000u,
+                           (uint32_t)v_lseek(fd, 70000, V_SEEK_SET));
+  TEST_ASSERT_EQUAL_UINT32(4u, (uint32_t)v_write(fd, s_buf, 4));
+  TEST_ASSERT_EQUAL_UINT32(70004u, (uint32_t)v_lseek(fd, 0, V_SEEK_END));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+
+  uint8_t got[512];
+  fd = v_open("0:LOG.BIN", V_O_RDONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(40000u, (uint32_t)v_lseek(fd, 40000, V_SEEK_SET));
+  TEST_ASSERT_EQUAL_UINT32(512u, (uint32_t)v_read(fd, got, 512));
+  TEST_ASSERT_TRUE(memcmp(got, s_buf, 512) == 0);
+  TEST_ASSERT_EQUAL_UINT32(65536u, (uint32_t)v_lseek(fd, 65536, V_SEEK_SET));
+  TEST_ASSERT_EQUAL_UINT32(512u, (uint32_t)v_read(fd, got, 512));
+  TEST_ASSERT_TRUE(memcmp(got, s_buf, 512) == 0);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+}
+
+static uint32_t file_size(const char *path) {
+  FILINFO fno;
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_stat(path, &fno));
+  return (uint32_t)fno.fsize;
+}
+
+void test_v_fs_preallocate_writes_no_data(void) {
+  format();
+  host_sd_spi_reset_stats();
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_preallocate("0:PRE.BIN", 262144));
+  /* 512 clusters reserved by FAT and directory updates alone. */
+  TEST_ASSERT_TRUE(host_sd_spi_stats().blocks_written < 16u);
+  TEST_ASSERT_EQUAL_UINT32(262144u, file_size("0:PRE.BIN"));
+
+  /* Second boot: already there, nothing written. */
+  host_sd_spi_reset_stats();
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_preallocate("0:PRE.BIN", 4096));
+  TEST_ASSERT_EQUAL_UINT32(0u, host_sd_spi_stats().blocks_written);
+  TEST_ASSERT_EQUAL_UINT32(262144u, file_size("0:PRE.BIN"));
+}
+
+void test_v_fs_stream_writes_bypass_fat(void) {
+  format();
+  FATFS *fs0;
+  DWORD free_before;
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_getfree("0:", &free_before, &fs0));
+  v_fd_t fd = v_open_stream("0:REC.BIN", 262144);
+  TEST_ASSERT_TRUE(fd >= 0);
+
+  static uint8_t data[8295];
+  for (uint32_t i = 0; i < sizeof(data); i++)
+    data[i] = (uint8_t)(i * 13U + 1U);
+
+  host_sd_spi_reset_stats();
+  TEST_ASSERT_EQUAL_UINT32(100u, (uint32_t)v_write(fd, data, 100));
+  TEST_ASSERT_EQUAL_UINT32(0u, host_sd_spi_stats().write_cmds); /* buffered */
+  /* Completes sector 0, then 15 whole sectors as one multi-block write;
+   * the last 100 bytes stay buffered. */
+  TEST_ASSERT_EQUAL_UINT32(8192u, (uint32_t)v_write(fd, data + 100, 8192));
+  TEST_ASSERT_EQUAL_UINT32(2u, host_sd_spi_stats().write_cmds);
+  TEST_ASSERT_EQUAL_UINT32(16u, host_sd_spi_stats().blocks_written);
+  TEST_ASSERT_EQUAL_UINT32(3u, (uint32_t)v_write(fd, data + 8292, 3));
+  TEST_ASSERT_EQUAL_UINT32(8295u, (uint32_t)v_lseek(fd, 0, V_SEEK_CUR));
+  TEST_ASSERT_TRUE(v_lseek(fd, 0, V_SEEK_SET) < 0);
+  TEST_ASSERT_TRUE(v_read(fd, s_buf, 16) < 0);
+
+  /* Sync writes the partial sector only: no FAT or directory traffic. */
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_sync(fd));
+  TEST_ASSERT_EQUAL_UINT32(3u, host_sd_spi_stats().write_cmds);
+  TEST_ASSERT_EQUAL_UINT32(262144u, file_size("0:REC.BIN"));
+
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+  TEST_ASSERT_EQUAL_UINT32(8295u, file_size("0:REC.BIN"));
+
+  static uint8_t back[sizeof(data)];
+  fd = v_open("0:REC.BIN", V_O_RDONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(sizeof(back),
+                           (uint32_t)v_read(fd, back, sizeof(back) + 10));
+  TEST_ASSERT_TRUE(memcmp(back, data, sizeof(data)) == 0);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+
+  /* The unused reservation went back to the volume: the file keeps the
+   * 17 clusters its 8295 bytes need. */
+  FATFS *fs;
+  DWORD free_after;
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_getfree("0:", &free_after, &fs));
+  TEST_ASSERT_EQUAL_UINT32(free_before - 17u, free_after);
+}
+
+void test_v_fs_stream_stops_at_reservation(void) {
+  format();
+  v_fd_t fd = v_open_stream("0:SMALL.BIN", 1024);
+  TEST_ASSERT_TRUE(fd >= 0);
+  /* Only one stream at a time by default. */
+  TEST_ASSERT_TRUE(v_open_stream("0:TWO.BIN", 1024) < 0);
+
+  fill_sector(s_buf, 9);
+  fill_sector(s_buf + 512, 10);
+  fill_sector(s_buf + 1024, 11);
+  TEST_ASSERT_EQUAL_UINT32(1024u, (uint32_t)v_write(fd, s_buf, 1500));
+  TEST_ASSERT_TRUE(v_write(fd, s_buf, 1) < 0);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+  TEST_ASSERT_EQUAL_UINT32(1024u, file_size("0:SMALL.BIN"));
+
+  /* No contiguous run that large: refused, and no file left behind. */
+  TEST_ASSERT_TRUE(v_open_stream("0:HUGE.BIN", 8u * 1024u * 1024u) < 0);
+  FILINFO fno;
+  TEST_ASSERT_EQUAL_UINT32(FR_NO_FILE, f_stat("0:HUGE.BIN", &fno));
+}
+
+/* Record r of a log: 24 bytes, none of them a multiple of a sector. */
+static void fill_record(uint8_t *p, uint32_t r) {
+  for (uint32_t i = 0; i < 24U; i++)
+    p[i] = (uint8_t)(r * 7U + i * 3U);
+}
+
+/* 512 records of 24 bytes, 12 KiB in all. */
+static void log_records(v_fd_t fd) {
+  uint8_t rec[24];
+  for (uint32_t r = 0; r < 512U; r++) {
+    fill_record(rec, r);
+    TEST_ASSERT_EQUAL_UINT32(24u, (uint32_t)v_write(fd, rec, sizeof(rec)));
+  }
+}
+
+void test_v_fs_buffered_records_coalesce(void) {
+  format_with(4096); /* One write buffer half per cluster */
+
+  /* Unbuffered: FatFs writes every sector on its own once it is full and
+   * the next byte arrives; the last one is still in its sector buffer.
+   * With FF_FS_TINY that buffer is the volume window, which the FAT sector
+   * takes over at each cluster allocation: three extra writes. */
+  v_fd_t fd = v_open("0:RAW.LOG", V_O_CREAT | V_O_WRONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_sync(fd)); /* Directory entry */
+  host_sd_spi_reset_stats();
+  log_records(fd);
+  TEST_ASSERT_EQUAL_UINT32(FF_FS_TINY ? 26u : 23u,
+                           host_sd_spi_stats().write_cmds);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+
+  /* Buffered: one multi-block write per 4 KiB window. The one read is the
+   * FAT sector for the cluster allocations; no data is read back. */
+  fd = v_open("0:BUF.LOG", V_O_CREAT | V_O_WRONLY | V_O_BUFFERED);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_sync(fd));
+  host_sd_spi_reset_stats();
+  log_records(fd);
+  TEST_ASSERT_EQUAL_UINT32(3u, host_sd_spi_stats().write_cmds);
+  TEST_ASSERT_EQUAL_UINT32(24u, host_sd_spi_stats().blocks_written);
+  TEST_ASSERT_EQUAL_UINT32(1u, host_sd_spi_stats().blocks_read);
+
+  /* A short tail stays in RAM; the position still counts it. */
+  TEST_ASSERT_EQUAL_UINT32(10u, (uint32_t)v_write(fd, s_buf, 10));
+  TEST_ASSERT_EQUAL_UINT32(12298u, (uint32_t)v_lseek(fd, 0, V_SEEK_CUR));
+  TEST_ASSERT_EQUAL_UINT32(3u, host_sd_spi_stats().write_cmds);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+  TEST_ASSERT_EQUAL_UINT32(12298u, file_size("0:BUF.LOG"));
+
+  uint8_t got[24], want[24];
+  fd = v_open("0:BUF.LOG", V_O_RDONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  for (uint32_t r = 0; r < 512U; r++) {
+    fill_record(want, r);
+    TEST_ASSERT_EQUAL_UINT32(24u, (uint32_t)v_read(fd, got, sizeof(got)));
+    TEST_ASSERT_TRUE(memcmp(got, want, sizeof(want)) == 0);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+}
+
+void test_v_fs_buffered_flushes_on_sync_seek_and_read(void) {
+  format_with(4096);
+  static uint8_t data[6000];
+  for (uint32_t i = 0; i < sizeof(data); i++)
+    data[i] = (uint8_t)(i * 11U + 5U);
+
+  v_fd_t fd = v_open("0:APP.LOG", V_O_CREAT | V_O_WRONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(1000u, (uint32_t)v_write(fd, data, 1000));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+
+  /* Appending from 1000: the first window runs to 4096 only. */
+  fd = v_open("0:APP.LOG", V_O_RDWR | V_O_APPEND | V_O_BUFFERED);
+  TEST_ASSERT_TRUE(fd >= 0);
+  for (uint32_t off = 1000; off < sizeof(data); off += 50)
+    TEST_ASSERT_EQUAL_UINT32(50u, (uint32_t)v_write(fd, data + off, 50));
+  TEST_ASSERT_EQUAL_UINT32(1000u, file_size("0:APP.LOG"));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_sync(fd));
+  TEST_ASSERT_EQUAL_UINT32(6000u, file_size("0:APP.LOG"));
+
+  /* The only write buffer is taken: this one is opened unbuffered. */
+  v_fd_t other = v_open("0:OTHER.LOG", V_O_CREAT | V_O_WRONLY | V_O_BUFFERED);
+  TEST_ASSERT_TRUE(other >= 0);
+  host_sd_spi_reset_stats();
+  TEST_ASSERT_EQUAL_UINT32(512u, (uint32_t)v_write(other, s_buf, 512));
+  TEST_ASSERT_TRUE(host_sd_spi_stats().write_cmds >= 1u);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(other));
+
+  /* Buffered bytes are written out before a seek or a read. */
+  uint8_t got[16];
+  TEST_ASSERT_EQUAL_UINT32(500u, (uint32_t)v_lseek(fd, 500, V_SEEK_SET));
+  TEST_ASSERT_EQUAL_UINT32(10u, (uint32_t)v_write(fd, "0123456789", 10));
+  memcpy(data + 500, "0123456789", 10);
+  TEST_ASSERT_EQUAL_UINT32(16u, (uint32_t)v_read(fd, got, sizeof(got)));
+  TEST_ASSERT_TRUE(memcmp(got, data + 510, sizeof(got)) == 0);
+  TEST_ASSERT_EQUAL_UINT32(5990u, (uint32_t)v_lseek(fd, 5990, V_SEEK_SET));
+  TEST_ASSERT_EQUAL_UINT32(20u, (uint32_t)v_write(fd, data, 20));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+  TEST_ASSERT_EQUAL_UINT32(6010u, file_size("0:APP.LOG"));
+
+  static uint8_t back[6010];
+  fd = v_open("0:APP.LOG", V_O_RDONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(6010u, (uint32_t)v_read(fd, back, sizeof(back)));
+  TEST_ASSERT_TRUE(memcmp(back, data, 5990) == 0);
+  TEST_ASSERT_TRUE(memcmp(back + 5990, data, 20) == 0);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+}
+
+void test_v_fs_descriptor_pool(void) {
+  format();
+  v_fd_t fds[V_FS_MAX_OPEN_FILES];
+  char path[] = "0:F0.BIN";
+  for (uint32_t i = 0; i < V_FS_MAX_OPEN_FILES; i++) {
+    path[3] = (char)('0' + i);
+    fds[i] = v_open(path, V_O_CREAT | V_O_RDWR);
+    TEST_ASSERT_EQUAL_UINT32(i, (uint32_t)fds[i]);
+    fill_sector(s_buf, i);
+    TEST_ASSERT_EQUAL_UINT32(100u, (uint32_t)v_write(fds[i], s_buf, 100));
+  }
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)-1, (uint32_t)v_open("0:X.BIN", V_O_CREAT));
+
+  /* A freed descriptor is the next one handed out; stale ones fail. */
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fds[2]));
+  TEST_ASSERT_TRUE(v_write(fds[2], s_buf, 1) < 0);
+  TEST_ASSERT_TRUE(v_close(fds[2]) < 0);
+  TEST_ASSERT_TRUE(v_read(V_FS_MAX_OPEN_FILES, s_buf, 1) < 0);
+  TEST_ASSERT_TRUE(v_read(-1, s_buf, 1) < 0);
+  TEST_ASSERT_EQUAL_UINT32(2u, (uint32_t)v_open("0:F2.BIN", V_O_RDONLY));
+
+  /* Every file kept its own data, written in turn. */
+  uint8_t want[512], got[100];
+  for (uint32_t i = 0; i < V_FS_MAX_OPEN_FILES; i++) {
+    fill_sector(want, i);
+    TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_lseek(fds[i], 0, V_SEEK_SET));
+    TEST_ASSERT_EQUAL_UINT32(100u, (uint32_t)v_read(fds[i], got, 100));
+    TEST_ASSERT_TRUE(memcmp(got, want, 100) == 0);
+    TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fds[i]));
+  }
+}
+
+void test_v_fs_long_file_names(void) {
+  format();
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_mkdir("0:flight logs"));
+  v_fd_t fd = v_open("0:flight logs/imu-0042_2026-10-18T12-00-00.csv",
+                     V_O_CREAT | V_O_WRONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(5u, (uint32_t)v_write(fd, "t,ax\n", 5));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+  /* CP437 0x82 is e-acute; 0x90, E-acute, is its upper case. */
+  fd = v_open("0:flight logs/caf\x82 menu.txt", V_O_CREAT | V_O_WRONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+
+  /* Long names match case-insensitively, non-ASCII letters included. */
+  uint8_t got[5];
+  fd = v_open("0:FLIGHT LOGS/IMU-0042_2026-10-18t12-00-00.CSV", V_O_RDONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(5u, (uint32_t)v_read(fd, got, sizeof(got)));
+  TEST_ASSERT_TRUE(memcmp(got, "t,ax\n", 5) == 0);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+  TEST_ASSERT_EQUAL_UINT32(0u, file_size("0:Flight Logs/CAF\x90 MENU.TXT"));
+
+  /* The directory holds the long names as given. */
+  DIR dir;
+  FILINFO fno;
+  uint32_t seen = 0;
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_opendir(&dir, "0:flight logs"));
+  while (f_readdir(&dir, &fno) == FR_OK && fno.fname[0] != '\0')
+    seen |= (strcmp(fno.fname, "imu-0042_2026-10-18T12-00-00.csv") == 0 ? 1U
+             : strcmp(fno.fname, "caf\x82 menu.txt") == 0              ? 2U
+                                                                       : 4U);
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_closedir(&dir));
+  TEST_ASSERT_EQUAL_UINT32(3u, seen);
+}
+
+/* Path of log file @p i in a directory with many long names. */
+static const char *log_path(uint32_t i) {
+  static char path[48];
+  memcpy(path, "0:logs/sensor-00-2026-10-18.csv", 32);
+  path[14] = (char)('0' + i / 10U);
+  path[15] = (char)('0' + i % 10U);
+  return path;
+}
+
+void test_v_fs_dcache_skips_directory_walk(void) {
+  format();
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_mkdir("0:logs"));
+  /* Three directory entries per name: the 48th file's entry sits in the
+   * directory's ninth cluster. */
+  for (uint32_t i = 0; i < 48U; i++) {
+    v_fd_t fd = v_open(log_path(i), V_O_CREAT | V_O_WRONLY);
+    TEST_ASSERT_TRUE(fd >= 0);
+    TEST_ASSERT_EQUAL_UINT32(100u, (uint32_t)v_write(fd, s_buf, 100));
+    TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+  }
+
+  /* A remount forgets every entry: the first open walks the directory. */
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_fs_init());
+  host_sd_spi_reset_stats();
+  v_fd_t fd = v_open(log_path(47), V_O_RDWR | V_O_APPEND);
+  TEST_ASSERT_TRUE(fd >= 0);
+  uint32_t walked = host_sd_spi_stats().blocks_read;
+  TEST_ASSERT_TRUE(walked >= 9u);
+  TEST_ASSERT_EQUAL_UINT32(50u, (uint32_t)v_write(fd, s_buf, 50));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+
+  /* Again: only the entry's own sector is read, and (without FF_FS_TINY)
+   * the partial last data sector appending starts in. The size is written
+   * back through the cached entry. */
+  TEST_ASSERT_EQUAL_UINT32(100u, file_size(log_path(3))); /* Moves window */
+  host_sd_spi_reset_stats();
+  fd = v_open(log_path(47), V_O_WRONLY | V_O_APPEND);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_UINT32(FF_FS_TINY ? 1u : 2u,
+                           host_sd_spi_stats().blocks_read);
+  TEST_ASSERT_EQUAL_UINT32(150u, (uint32_t)v_lseek(fd, 0, V_SEEK_CUR));
+  TEST_ASSERT_EQUAL_UINT32(50u, (uint32_t)v_write(fd, s_buf, 50));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+  TEST_ASSERT_EQUAL_UINT32(200u, file_size(log_path(47)));
+
+  /* Deleted through v_fs, or behind its back: never opened from the cache. */
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_unlink(log_path(47)));
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)-FR_NO_FILE,
+                           (uint32_t)v_open(log_path(47), V_O_RDONLY));
+  v_fd_t cached = v_open(log_path(3), V_O_RDONLY);
+  TEST_ASSERT_TRUE(cached >= 0);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(cached));
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_unlink(log_path(3)));
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)-FR_NO_FILE,
+                           (uint32_t)v_open(log_path(3), V_O_RDONLY));
+}
+
+#define FAT32_SECTORS 8388608U /* 4 GiB, mostly never touched */
+
+void test_v_fs_preallocate_past_2gib(void) {
+  static uint8_t work[FF_MAX_SS];
+  host_mmio_reset();
+  const host_sd_spi_config_t cfg = {.sectors = FAT32_SECTORS,
+                                    .busy_bytes = 1};
+  TEST_ASSERT_TRUE(host_sd_spi_attach(&cfg));
+  const MKFS_PARM opt = {.fmt = FM_FAT32, .au_size = 32768};
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_mkfs("0:", &opt, work, sizeof(work)));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_fs_init());
+
+  /* Sizes are unsigned: 3 GiB fits on every build, not just large-file
+   * ones, and reaches the FAT as it was given. */
+  TEST_ASSERT_TRUE((v_size_t)-1 > 0);
+  TEST_ASSERT_EQUAL_UINT32(0u,
+                           (uint32_t)v_preallocate("0:BIG.BIN", 0xC0000000U));
+  TEST_ASSERT_EQUAL_UINT32(0xC0000000U, file_size("0:BIG.BIN"));
+#if V_FS_LARGE_FILES && !FF_FS_EXFAT
+  TEST_ASSERT_EQUAL_UINT32(
+      (uint32_t)-FR_INVALID_PARAMETER,
+      (uint32_t)v_preallocate("0:HUGE.BIN", (v_size_t)1 << 32));
+#endif
+}
+
+#if FF_FS_EXFAT
+#define EXFAT_SECTORS 16777216U /* 8 GiB, mostly never touched */
+#define GIB ((v_off_t)1 << 30)
+
+void test_v_fs_exfat_file_past_4gib(void) {
+  static uint8_t work[FF_MAX_SS];
+  host_mmio_reset();
+  const host_sd_spi_config_t cfg = {.sectors = EXFAT_SECTORS,
+                                    .busy_bytes = 1};
+  TEST_ASSERT_TRUE(host_sd_spi_attach(&cfg));
+  const MKFS_PARM opt = {.fmt = FM_EXFAT, .au_size = 32768};
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_mkfs("0:", &opt, work, sizeof(work)));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_fs_init());
+  FATFS *fs;
+  DWORD free_clusters;
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_getfree("0:", &free_clusters, &fs));
+  TEST_ASSERT_EQUAL_UINT32(FS_EXFAT, fs->fs_type);
+
+  /* 5 GiB reserved in one run: only the bitmap and the entry are written. */
+  const v_off_t size = 5 * GIB;
+  host_sd_spi_reset_stats();
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_preallocate("0:flight.bin", size));
+  TEST_ASSERT_TRUE(host_sd_spi_stats().blocks_written < 64u);
+
+  v_fd_t fd = v_open("0:flight.bin", V_O_RDWR);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_TRUE(v_lseek(fd, 0, V_SEEK_END) == size);
+  const v_off_t at = 4 * GIB + 4096 + 100;
+  TEST_ASSERT_TRUE(v_lseek(fd, at, V_SEEK_SET) == at);
+  fill_sector(s_buf, 77);
+  TEST_ASSERT_EQUAL_UINT32(512u, (uint32_t)v_write(fd, s_buf, 512));
+  TEST_ASSERT_TRUE(v_lseek(fd, 0, V_SEEK_CUR) == at + 512);
+  TEST_ASSERT_TRUE(v_lseek(fd, -(at + 513), V_SEEK_CUR) < 0);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+
+  /* Read back through a fresh mount. */
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_fs_init());
+  fd = v_open("0:flight.bin", V_O_RDONLY);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_TRUE(v_lseek(fd, at - 100, V_SEEK_SET) == at - 100);
+  uint8_t got[612];
+  TEST_ASSERT_EQUAL_UINT32(sizeof(got), (uint32_t)v_read(fd, got, sizeof(got)));
+  TEST_ASSERT_TRUE(memcmp(got + 100, s_buf, 512) == 0);
+  TEST_ASSERT_TRUE(v_lseek(fd, 0, V_SEEK_CUR) == at + 512);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_close(fd));
+}
+#endif
+
+NAVTEST_CASE_DECL(test_v_fs_read_only_seek_skips_fat_walk);
+NAVTEST_CASE_DECL(test_v_fs_fragmented_file_falls_back);
+NAVTEST_CASE_DECL(test_v_fs_writable_fastseek_grows_past_map);
+NAVTEST_CASE_DECL(test_v_fs_preallocate_writes_no_data);
+NAVTEST_CASE_DECL(test_v_fs_stream_writes_bypass_fat);
+NAVTEST_CASE_DECL(test_v_fs_stream_stops_at_reservation);
+NAVTEST_CASE_DECL(test_v_fs_buffered_records_coalesce);
+NAVTEST_CASE_DECL(test_v_fs_buffered_flushes_on_sync_seek_and_read);
+NAVTEST_CASE_DECL(test_v_fs_descriptor_pool);
+NAVTEST_CASE_DECL(test_v_fs_long_file_names);
+NAVTEST_CASE_DECL(test_v_fs_dcache_skips_directory_walk);
+NAVTEST_CASE_DECL(test_v_fs_preallocate_past_2gib);
+#if FF_FS_EXFAT
+NAVTEST_CASE_DECL(test_v_fs_exfat_file_past_4gib);
+#endif
+
+static const navtest_case_t v_fs_cases[] = {
+    NAVTEST_CASE(test_v_fs_read_only_seek_skips_fat_walk),
+    NAVTEST_CASE(test_v_fs_fragmented_file_falls_back),
+    NAVTEST_CASE(test_v_fs_writable_fastseek_grows_past_map),
+    NAVTEST_CASE(test_v_fs_preallocate_writes_no_data),
+    NAVTEST_CASE(test_v_fs_stream_writes_bypass_fat),
+    NAVTEST_CASE(test_v_fs_stream_stops_at_reservation),
+    NAVTEST_CASE(test_v_fs_buffered_records_coalesce),
+    NAVTEST_CASE(test_v_fs_buffered_flushes_on_sync_seek_and_read),
+    NAVTEST_CASE(test_v_fs_descriptor_pool),
+    NAVTEST_CASE(test_v_fs_long_file_names),
+    NAVTEST_CASE(test_v_fs_dcache_skips_directory_walk),
+    NAVTEST_CASE(test_v_fs_preallocate_past_2gib),
+#if FF_FS_EXFAT
+    NAVTEST_CASE(test_v_fs_exfat_file_past_4gib),
+#endif
+};
+
+const navtest_suite_t test_v_fs_suite = {
+    .name = "V_FS (host)",
+    .cases = v_fs_cases,
+    .count = sizeof(v_fs_cases) / sizeof(v_fs_cases[0]),
+    .between = NULL,
+};
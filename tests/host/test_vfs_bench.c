@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file test_vfs_bench.c
+ * @brief Host (SIL) tests for the file-backed disk (host_disk_file.c) and
+ *        the v_fs workloads run on it (vfs_bench.c).
+ *
+ * Host time is not asserted on; the simulated time and the sector counts
+ * are exact, which is what makes the benchmark usable in CI.
+ */
+
+#define _POSIX_C_SOURCE 200809L /* mkstemp */
+#include "host_disk_file.h"
+#include "vfs_bench.h"
+#include "utils/v_fs.h"
+#include "diskio.h"
+#include "ff.h"
+#include "navtest/navtest.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define DISK_SECTORS 16384U /* 8 MiB */
+
+static const host_disk_file_config_t s_disk = {
+    .sectors = DISK_SECTORS, .cmd_us = 100, .read_us = 20, .write_us = 40};
+
+static uint8_t s_buf[4096];
+
+/* What the JSON line printer produced. */
+static char s_line[512];
+
+static void capture(const char *s) {
+  strncpy(s_line, s, sizeof(s_line) - 1);
+}
+
+/* Simulated time is exactly the configured costs of the commands counted. */
+static uint64_t expected_us(const host_disk_file_stats_t *io) {
+  return (uint64_t)s_disk.cmd_us *
+             (io->read_cmds + io->write_cmds + io->syncs) +
+         (uint64_t)s_disk.read_us * io->sectors_read +
+         (uint64_t)s_disk.write_us * io->sectors_written;
+}
+
+/* A fresh disk with an empty volume mounted through v_fs. */
+static void fresh_volume(void) {
+  static uint8_t work[FF_MAX_SS];
+  TEST_ASSERT_TRUE(host_disk_file_attach(&s_disk));
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_mkfs("0:", NULL, work, sizeof(work)));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)v_fs_init());
+  for (uint32_t i = 0; i < sizeof(s_buf); i++)
+    s_buf[i] = (uint8_t)(i * 7U + 0x5A);
+}
+
+void test_vfs_bench_disk_file(void) {
+  char path[] = "/tmp/navhal-vfs-bench-XXXXXX";
+  int tmp = mkstemp(path);
+  TEST_ASSERT_TRUE(tmp >= 0);
+  close(tmp);
+
+  host_disk_file_config_t cfg = s_disk;
+  cfg.image = path;
+  cfg.sectors = 64;
+  TEST_ASSERT_TRUE(host_disk_file_attach(&cfg));
+  TEST_ASSERT_EQUAL_UINT32(STA_NOINIT, disk_status(0));
+  TEST_ASSERT_EQUAL_UINT32(0u, disk_initialize(0));
+
+  static uint8_t out[2 * 512], in[2 * 512];
+  for (uint32_t i = 0; i < sizeof(out); i++)
+    out[i] = (uint8_t)(i * 3U + 1U);
+  TEST_ASSERT_EQUAL_UINT32(RES_OK, disk_write(0, out, 62, 2));
+  TEST_ASSERT_EQUAL_UINT32(RES_OK, disk_read(0, in, 62, 2));
+  TEST_ASSERT_TRUE(memcmp(in, out, sizeof(in)) == 0);
+  TEST_ASSERT_EQUAL_UINT32(RES_OK, disk_ioctl(0, CTRL_SYNC, NULL));
+
+  /* Nothing past the end, not even partly. */
+  TEST_ASSERT_EQUAL_UINT32(RES_PARERR, disk_read(0, in, 63, 2));
+  TEST_ASSERT_EQUAL_UINT32(RES_PARERR, disk_write(0, out, 64, 1));
+
+  host_disk_file_stats_t st = host_disk_file_stats();
+  TEST_ASSERT_EQUAL_UINT32(1u, st.read_cmds);
+  TEST_ASSERT_EQUAL_UINT32(1u, st.write_cmds);
+  TEST_ASSERT_EQUAL_UINT32(1u, st.syncs);
+  TEST_ASSERT_EQUAL_UINT32(2u, (uint32_t)st.sectors_read);
+  TEST_ASSERT_EQUAL_UINT32(2u, (uint32_t)st.sectors_written);
+  TEST_ASSERT_EQUAL_UINT32(100u + 2u * 40u + 100u + 2u * 20u + 100u,
+                           (uint32_t)st.busy_us);
+
+  /* The data is in the file, and still there after a reattach. */
+  host_disk_file_detach();
+  TEST_ASSERT_EQUAL_UINT32(STA_NOINIT | STA_NODISK, disk_status(0));
+  TEST_ASSERT_TRUE(host_disk_file_attach(&cfg));
+  TEST_ASSERT_EQUAL_UINT32(RES_NOTRDY, disk_read(0, in, 62, 2));
+  TEST_ASSERT_EQUAL_UINT32(0u, disk_initialize(0));
+  memset(in, 0, sizeof(in));
+  TEST_ASSERT_EQUAL_UINT32(RES_OK, disk_read(0, in, 62, 2));
+  TEST_ASSERT_TRUE(memcmp(in, out, sizeof(in)) == 0);
+  host_disk_file_detach();
+
+  FILE *f = fopen(path, "rb");
+  TEST_ASSERT_TRUE(f != NULL);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)fseek(f, 62L * 512L, SEEK_SET));
+  TEST_ASSERT_EQUAL_UINT32(sizeof(in), (uint32_t)fread(in, 1, sizeof(in), f));
+  fclose(f);
+  unlink(path);
+  TEST_ASSERT_TRUE(memcmp(in, out, sizeof(in)) == 0);
+}
+
+void test_vfs_bench_append(void) {
+  fresh_volume();
+
+  /* 64 KiB in 64-byte records. */
+  vfs_bench_result_t r = vfs_bench_append("LOG.BIN", s_buf, 64, 1024);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)r.err);
+  TEST_ASSERT_EQUAL_UINT32(1024u, r.ops);
+  TEST_ASSERT_EQUAL_UINT32(65536u, (uint32_t)r.bytes);
+  TEST_ASSERT_TRUE(r.io.sectors_written >= 128u);
+  /* Coalesced into whole windows: far fewer commands than records. */
+  TEST_ASSERT_TRUE(r.io.write_cmds < r.ops / 8u);
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)expected_us(&r.io),
+                           (uint32_t)r.io.busy_us);
+
+  FILINFO fno;
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_stat("LOG.BIN", &fno));
+  TEST_ASSERT_EQUAL_UINT32(65536u, (uint32_t)fno.fsize);
+
+  /* The same run on a fresh volume moves exactly the same sectors. */
+  host_disk_file_detach();
+  fresh_volume();
+  vfs_bench_result_t again = vfs_bench_append("LOG.BIN", s_buf, 64, 1024);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)again.err);
+  TEST_ASSERT_EQUAL_UINT32(r.io.read_cmds, again.io.read_cmds);
+  TEST_ASSERT_EQUAL_UINT32(r.io.write_cmds, again.io.write_cmds);
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)r.io.sectors_written,
+                           (uint32_t)again.io.sectors_written);
+  host_disk_file_detach();
+}
+
+/* A fresh volume holding a 128 KiB file, then @p reads random reads of it. */
+static vfs_bench_result_t seek_run(uint32_t reads, uint32_t seed) {
+  fresh_volume();
+  vfs_bench_result_t r = vfs_bench_append("DATA.BIN", s_buf, 512, 256);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)r.err);
+  return vfs_bench_seek("DATA.BIN", s_buf, 512, reads, seed);
+}
+
+void test_vfs_bench_seek(void) {
+  vfs_bench_result_t r = seek_run(200, 7);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)r.err);
+  TEST_ASSERT_EQUAL_UINT32(200u, r.ops);
+  TEST_ASSERT_EQUAL_UINT32(200u * 512u, (uint32_t)r.bytes);
+  TEST_ASSERT_EQUAL_UINT32(0u, r.io.write_cmds);
+  /* Sector-aligned records are read straight into the caller's buffer:
+   * one sector each, plus what opening the file costs. */
+  TEST_ASSERT_TRUE(r.io.sectors_read >= 200u);
+  TEST_ASSERT_TRUE(r.io.sectors_read <= 200u + 8u);
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)expected_us(&r.io),
+                           (uint32_t)r.io.busy_us);
+
+  /* Same seed, same offsets, same traffic. */
+  host_disk_file_detach();
+  vfs_bench_result_t again = seek_run(200, 7);
+  TEST_ASSERT_EQUAL_UINT32(r.io.read_cmds, again.io.read_cmds);
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)r.io.sectors_read,
+                           (uint32_t)again.io.sectors_read);
+
+  /* No whole record in the file: nothing to seek to. */
+  r = vfs_bench_append("SHORT.BIN", s_buf, 64, 1);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)r.err);
+  r = vfs_bench_seek("SHORT.BIN", s_buf, 512, 1, 7);
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)-FR_INVALID_PARAMETER, (uint32_t)r.err);
+  TEST_ASSERT_EQUAL_UINT32(0u, r.ops);
+  host_disk_file_detach();
+}
+
+void test_vfs_bench_churn(void) {
+  fresh_volume();
+
+  vfs_bench_result_t r = vfs_bench_churn("CHURN", s_buf, 2048, 16, 3);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)r.err);
+  TEST_ASSERT_EQUAL_UINT32(2u * 16u * 3u, r.ops);
+  TEST_ASSERT_EQUAL_UINT32(16u * 3u * 2048u, (uint32_t)r.bytes);
+  /* Freed clusters are trimmed (FF_USE_TRIM). */
+  TEST_ASSERT_TRUE(r.io.trims >= 16u * 3u);
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)expected_us(&r.io),
+                           (uint32_t)r.io.busy_us);
+
+  /* Everything created was deleted again. */
+  DIR dir;
+  FILINFO fno;
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_opendir(&dir, "CHURN"));
+  TEST_ASSERT_EQUAL_UINT32(FR_OK, f_readdir(&dir, &fno));
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)fno.fname[0]);
+  f_closedir(&dir);
+
+  /* A second run reuses the directory. */
+  r = vfs_bench_churn("CHURN", s_buf, 0, 4, 1);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)r.err);
+  TEST_ASSERT_EQUAL_UINT32(8u, r.ops);
+  host_disk_file_detach();
+}
+
+void test_vfs_bench_json(void) {
+  fresh_volume();
+  vfs_bench_result_t r = vfs_bench_append("J.BIN", s_buf, 512, 16);
+  TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)r.err);
+  vfs_bench_print(&r, capture);
+
+  static const char head[] = "{\"type\":\"point\",\"op\":\"append\",";
+  char want[96];
+  TEST_ASSERT_TRUE(strncmp(s_line, head, sizeof(head) - 1) == 0);
+  TEST_ASSERT_TRUE(strstr(s_line, "\"n\":16,") != NULL);
+  snprintf(want, sizeof(want), "\"write_cmds\":%u,", (unsigned)r.io.write_cmds);
+  TEST_ASSERT_TRUE(strstr(s_line, want) != NULL);
+  snprintf(want, sizeof(want), "\"sim_us\":%llu,",
+           (unsigned long long)r.io.busy_us);
+  TEST_ASSERT_TRUE(strstr(s_line, want) != NULL);
+  TEST_ASSERT_TRUE(strstr(s_line, "}\r\n") != NULL);
+  host_disk_file_detach();
+}
+
+NAVTEST_CASE_DECL(test_vfs_bench_disk_file);
+NAVTEST_CASE_DECL(test_vfs_bench_append);
+NAVTEST_CASE_DECL(test_vfs_bench_seek);
+NAVTEST_CASE_DECL(test_vfs_bench_churn);
+NAVTEST_CASE_DECL(test_vfs_bench_json);
+
+static const navtest_case_t vfs_bench_cases[] = {
+    NAVTEST_CASE(test_vfs_bench_disk_file),
+    NAVTEST_CASE(test_vfs_bench_append),
+    NAVTEST_CASE(test_vfs_bench_seek),
+    NAVTEST_CASE(test_vfs_bench_churn),
+    NAVTEST_CASE(test_vfs_bench_json),
+};
+
+const navtest_suite_t test_vfs_bench_suite = {
+    .name = "V_FS BENCHMARK (host)",
+    .cases = vfs_bench_cases,
+    .count = sizeof(vfs_bench_cases) / sizeof(vfs_bench_cases[0]),
+    .between = NULL,
+};
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file vfs_bench.c
+ * @brief v_fs workloads timed on the file-backed host disk (see
+ *        vfs_bench.h).
+ */
+
+#include "vfs_bench.h"
+#include "utils/v_fs.h"
+#include "ff.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <time.h>
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void begin(vfs_bench_result_t *r, const char *op, uint32_t size,
+                  uint32_t count) {
+  *r = (vfs_bench_result_t){.op = op, .size = size, .count = count};
+  host_disk_file_reset_stats();
+  r->wall_ns = now_ns();
+}
+
+static void end(vfs_bench_result_t *r) {
+  r->wall_ns = now_ns() - r->wall_ns;
+  r->io = host_disk_file_stats();
+}
+
+vfs_bench_result_t vfs_bench_append(const char *path, const uint8_t *buf,
+                                    uint32_t size, uint32_t records) {
+  vfs_bench_result_t r;
+  begin(&r, "append", size, records);
+
+  v_fd_t fd = v_open(path, V_O_CREAT | V_O_WRONLY | V_O_TRUNC | V_O_BUFFERED);
+  if (fd < 0) {
+    r.err = fd;
+    end(&r);
+    return r;
+  }
+  while (r.ops < records) {
+    int n = v_write(fd, buf, size);
+    if (n != (int)size) {
+      r.err = n < 0 ? n : -(int)FR_DENIED; /* Short: the volume is full */
+      break;
+    }
+    r.ops++;
+    r.bytes += size;
+  }
+  int res = v_close(fd);
+  if (r.err == 0)
+    r.err = res;
+  end(&r);
+  return r;
+}
+
+vfs_bench_result_t vfs_bench_seek(const char *path, uint8_t *buf, uint32_t size,
+                                  uint32_t reads, uint32_t seed) {
+  vfs_bench_result_t r;
+  begin(&r, "seek", size, reads);
+
+  v_fd_t fd = v_open(path, V_O_RDONLY);
+  if (fd < 0) {
+    r.err = fd;
+    end(&r);
+    return r;
+  }
+  v_off_t records = v_lseek(fd, 0, V_SEEK_END) / (v_off_t)size;
+  if (records <= 0)
+    r.err = -(int)FR_INVALID_PARAMETER;
+
+  uint32_t x = seed ? seed : 1U;
+  while (r.err == 0 && r.ops < reads) {
+    x ^= x << 13; /* xorshift32 */
+    x ^= x >> 17;
+    x ^= x << 5;
+    v_off_t pos = (v_off_t)(x % (uint32_t)records) * (v_off_t)size;
+    v_off_t at = v_lseek(fd, pos, V_SEEK_SET);
+    if (at != pos) {
+      r.err = at < 0 ? (int)at : -(int)FR_INT_ERR;
+      break;
+    }
+    int n = v_read(fd, buf, size);
+    if (n != (int)size) {
+      r.err = n < 0 ? n : -(int)FR_INT_ERR;
+      break;
+    }
+    r.ops++;
+    r.bytes += size;
+  }
+  int res = v_close(fd);
+  if (r.err == 0)
+    r.err = res;
+  end(&r);
+  return r;
+}
+
+vfs_bench_result_t vfs_bench_churn(const char *dir, const uint8_t *buf,
+                                   uint32_t size, uint32_t files,
+                                   uint32_t rounds) {
+  vfs_bench_result_t r;
+  char path[64];
+  begin(&r, "churn", size, 2U * files * rounds);
+
+  int res = v_mkdir(dir);
+  if (res != 0 && res != -(int)FR_EXIST) {
+    r.err = res;
+    end(&r);
+    return r;
+  }
+  for (uint32_t round = 0; round < rounds && r.err == 0; round++) {
+    for (uint32_t i = 0; i < files && r.err == 0; i++) {
+      snprintf(path, sizeof(path), "%s/F%05" PRIu32 ".BIN", dir, i);
+      v_fd_t fd = v_open(path, V_O_CREAT | V_O_WRONLY | V_O_TRUNC);
+      if (fd < 0) {
+        r.err = fd;
+        break;
+      }
+      int n = size ? v_write(fd, buf, size) : 0;
+      res = v_close(fd);
+      if (n != (int)size)
+        r.err = n < 0 ? n : -(int)FR_DENIED;
+      else if (res != 0)
+        r.err = res;
+      else {
+        r.ops++;
+        r.bytes += size;
+      }
+    }
+    for (uint32_t i = 0; i < files && r.err == 0; i++) {
+      snprintf(path, sizeof(path), "%s/F%05" PRIu32 ".BIN", dir, i);
+      res = v_unlink(path);
+      if (res != 0)
+        r.err = res;
+      else
+        r.ops++;
+    }
+  }
+  end(&r);
+  return r;
+}
+
+void vfs_bench_print(const vfs_bench_result_t *r, void (*put)(const char *)) {
+  const host_disk_file_stats_t *io = &r->io;
+  char line[512];
+  snprintf(line, sizeof(line),
+           "{\"type\":\"point\",\"op\":\"%s\",\"size\":%" PRIu32
+           ",\"count\":%" PRIu32 ",\"err\":%d,\"n\":%" PRIu32
+           ",\"bytes\":%" PRIu64 ",\"wall_ns\":%" PRIu64
+           ",\"ops_s\":%" PRIu64 ",\"sim_us\":%" PRIu64
+           ",\"sim_ops_s\":%" PRIu64 ",\"read_cmds\":%" PRIu32
+           ",\"write_cmds\":%" PRIu32 ",\"sectors_read\":%" PRIu64
+           ",\"sectors_written\":%" PRIu64 ",\"syncs\":%" PRIu32
+           ",\"trims\":%" PRIu32 "}\r\n",
+           r->op, r->size, r->count, r->err, r->ops, r->bytes, r->wall_ns,
+           r->wall_ns ? (uint64_t)r->ops * 1000000000U / r->wall_ns : 0,
+           io->busy_us,
+           io->busy_us ? (uint64_t)r->ops * 1000000U / io->busy_us : 0,
+           io->read_cmds, io->write_cmds, io->sectors_read,
+           io->sectors_written, io->syncs, io->trims);
+  put(line);
+}
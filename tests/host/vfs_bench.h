@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2025 NAVRobotec Pvt Ltd
+ * Author: Ragnar Vallhala
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file vfs_bench.h
+ * @brief v_fs workloads timed on the file-backed host disk.
+ *
+ * @details
+ * Each workload runs through v_fs on the mounted drive 0 of
+ * host_disk_file.h and reports how many operations it completed, in how
+ * much host time and how much simulated disk time, and the sector traffic
+ * it caused. The counts depend only on the FatFs and v_fs build options
+ * and the disk's geometry, never on the host, so a CI job can compare
+ * them across ffconf.h or v_fs changes; the rates are for people.
+ *
+ * - append: one file written in records of a given size, then closed.
+ * - seek:   records read at pseudo-random record-aligned offsets of an
+ *           existing file (a fixed generator, so every run reads the
+ *           same offsets).
+ * - churn:  rounds of creating, writing and closing a set of files in a
+ *           directory, then deleting them all.
+ */
+#ifndef VFS_BENCH_H
+#define VFS_BENCH_H
+
+#include "host_disk_file.h"
+#include <stdint.h>
+
+/** @brief One workload's outcome. */
+typedef struct {
+  const char *op;            /**< "append", "seek" or "churn" */
+  uint32_t size;             /**< Record or file size, bytes */
+  uint32_t count;            /**< Operations asked for */
+  uint32_t ops;              /**< Operations completed */
+  uint64_t bytes;            /**< Payload bytes they moved */
+  int err;                   /**< 0, or the v_fs error that stopped the run */
+  uint64_t wall_ns;          /**< Host time */
+  host_disk_file_stats_t io; /**< Disk traffic, and simulated time */
+} vfs_bench_result_t;
+
+/**
+ * @brief Write @p records records of @p size bytes to a new @p path, with
+ *        ::V_O_BUFFERED, and close it. One operation per ::v_write; the
+ *        close is part of the run.
+ * @param buf At least @p size bytes of data.
+ */
+vfs_bench_result_t vfs_bench_append(const char *path, const uint8_t *buf,
+                                    uint32_t size, uint32_t records);
+
+/**
+ * @brief Read @p reads records of @p size bytes from @p path, each after a
+ *        ::v_lseek to a record boundary picked from @p seed. One operation
+ *        per seek and read.
+ * @param buf At least @p size bytes.
+ */
+vfs_bench_result_t vfs_bench_seek(const char *path, uint8_t *buf, uint32_t size,
+                                  uint32_t reads, uint32_t seed);
+
+/**
+ * @brief @p rounds times: create @p files files of @p size bytes in @p dir,
+ *        then delete them. One operation per file created (open, write,
+ *        close) and one per file deleted.
+ * @param buf At least @p size bytes of data.
+ */
+vfs_bench_result_t vfs_bench_churn(const char *dir, const uint8_t *buf,
+                                   uint32_t size, uint32_t files,
+                                   uint32_t rounds);
+
+/** @brief Emit @p r as one JSON line through @p put. */
+void vfs_bench_print(const vfs_bench_result_t *r, void (*put)(const char *));
+
+#endif /* VFS_BENCH_H */
@@ -36,6 +36,7 @@
 #include "cap/cycle_counter/test_dwt.h"
 #include "cap/fpu/test_fpu_accel.h"
 #include "cap/sdio/test_sdio.h"
+#include "cap/cache/test_cache.h"
 
 /* White-box, register-poke suites are per-processor. Only the Cortex-M4 set
  * exists today; a cortex-m7 build skips this tier (its registers differ — e.g.
@@ -109,6 +110,9 @@ static const navtest_suite_t *const all_suites[] = {
 #if NAVHAL_HAS_SDIO
     &test_sdio_suite,
 #endif
+#if NAVHAL_HAS_CACHE
+    &test_cache_suite,
+#endif
 };
 
 static void print_startup_message(void) {
@@ -227,6 +227,9 @@ void test_conformance_cap_macros_are_defined(void) {
 #endif
 #if !defined(NAVHAL_HAS_SDIO)
 #  error "NAVHAL_HAS_SDIO is not defined"
+#endif
+#if !defined(NAVHAL_HAS_CACHE)
+#  error "NAVHAL_HAS_CACHE is not defined"
 #endif
   /* Numeric domain: must be exactly 0 or 1. */
   TEST_ASSERT_TRUE(NAVHAL_HAS_DMA            == 0 || NAVHAL_HAS_DMA            == 1);
@@ -234,6 +237,7 @@ void test_conformance_cap_macros_are_defined(void) {
   TEST_ASSERT_TRUE(NAVHAL_HAS_CRC_HW         == 0 || NAVHAL_HAS_CRC_HW         == 1);
   TEST_ASSERT_TRUE(NAVHAL_HAS_CYCLE_COUNTER  == 0 || NAVHAL_HAS_CYCLE_COUNTER  == 1);
   TEST_ASSERT_TRUE(NAVHAL_HAS_SDIO           == 0 || NAVHAL_HAS_SDIO           == 1);
+  TEST_ASSERT_TRUE(NAVHAL_HAS_CACHE          == 0 || NAVHAL_HAS_CACHE          == 1);
 }
 /* PROGMEM slot for each case name on AVR; no-op elsewhere. */
 NAVTEST_CASE_DECL(test_conformance_status_ok_is_zero);